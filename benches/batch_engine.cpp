@@ -0,0 +1,48 @@
+#include "../src/simulation/batch_engine.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "../src/state.hpp"
+#include "../tests/players.hpp"
+#include "bench.hpp"
+
+constexpr size_t GAME_COUNT = 40'000;
+constexpr size_t BATCH_SIZE = 4'096;
+constexpr uint8_t SEAT_COUNT = 4;
+
+/// Plays the games in batches small enough to stay in cache.
+template <typename Engine>
+void run_batches() {
+    for (size_t first = 0; first < GAME_COUNT; first += BATCH_SIZE) {
+        Engine batch(
+            std::min(BATCH_SIZE, GAME_COUNT - first),
+            SEAT_COUNT,
+            static_cast<unsigned int>(first)
+        );
+        batch.run();
+    }
+}
+
+int main() {
+    const auto state_rate = bench("State", GAME_COUNT, "games", [] {
+        for (unsigned int seed = 0; seed < GAME_COUNT; seed += 1) {
+            State state(create_ai_players(SEAT_COUNT), seed);
+            while (state.update() != AppState::GameOver) {
+            }
+        }
+    });
+
+    const auto batch_rate = bench("BatchEngine", GAME_COUNT, "games", [] {
+        run_batches<BatchEngine>();
+    });
+    const auto fast_rate = bench("FastBatchEngine", GAME_COUNT, "games", [] {
+        run_batches<FastBatchEngine>();
+    });
+
+    std::printf("BatchEngine speedup:     %.1fx\n", batch_rate / state_rate);
+    std::printf("FastBatchEngine speedup: %.1fx\n", fast_rate / state_rate);
+    return 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+
+/// Runs the body once and prints how many items per second it processed.
+template <typename F>
+double bench(
+    std::string_view name,
+    size_t item_count,
+    std::string_view unit,
+    F&& body
+) {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    const auto rate = item_count / elapsed.count();
+    std::printf(
+        "%-40.*s %14.0f %.*s/s\n",
+        static_cast<int>(name.size()),
+        name.data(),
+        rate,
+        static_cast<int>(unit.size()),
+        unit.data()
+    );
+    return rate;
+}
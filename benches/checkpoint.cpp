@@ -0,0 +1,95 @@
+#include "../src/checkpoint.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "../src/state.hpp"
+#include "../tests/players.hpp"
+#include "bench.hpp"
+
+constexpr size_t TABLE_COUNT = 256;
+constexpr uint8_t SEAT_COUNT = 4;
+
+namespace {
+std::vector<std::unique_ptr<State>> create_tables() {
+    std::vector<std::unique_ptr<State>> tables;
+    for (size_t table = 0; table < TABLE_COUNT; table += 1) {
+        tables.push_back(std::make_unique<State>(
+            create_ai_players(SEAT_COUNT),
+            static_cast<unsigned int>(table)
+        ));
+    }
+    return tables;
+}
+
+/// Plays every table to its end a turn at a time, like a host, and returns
+/// the number of turns. After each round of turns, every unfinished table is
+/// checkpointed into the log, if any, which is then flushed once.
+size_t play_tables(CheckpointLog* log) {
+    auto tables = create_tables();
+    std::vector<bool> is_over(TABLE_COUNT);
+    Checkpoint checkpoint;
+    size_t turn_count = 0;
+    size_t left = TABLE_COUNT;
+    while (left > 0) {
+        for (uint32_t table = 0; table < TABLE_COUNT; table += 1) {
+            if (is_over[table]) {
+                continue;
+            }
+            turn_count += 1;
+            is_over[table] = tables[table]->update() == AppState::GameOver;
+            left -= is_over[table] ? 1 : 0;
+            if (log == nullptr) {
+                continue;
+            }
+            if (is_over[table]) {
+                log->finish(table);
+            } else {
+                tables[table]->checkpoint(checkpoint);
+                checkpoint.table = table;
+                log->append(checkpoint);
+            }
+        }
+        if (log != nullptr) {
+            log->flush();
+        }
+    }
+    return turn_count;
+}
+} // namespace
+
+int main() {
+    const auto path =
+        std::filesystem::temp_directory_path() / "uno_bench.checkpoint";
+    std::filesystem::remove(path);
+
+    size_t turn_count = 0;
+    const auto plain_rate = bench("Games", TABLE_COUNT, "games", [&] {
+        turn_count = play_tables(nullptr);
+    });
+    CheckpointLog log(path);
+    const auto checkpointed_rate =
+        bench("Games with checkpoints", TABLE_COUNT, "games", [&] {
+            play_tables(&log);
+        });
+    // Nearly one checkpoint per turn.
+    const auto overhead = 1e6 / checkpointed_rate - 1e6 / plain_rate;
+    const auto turns_per_game = static_cast<double>(turn_count) / TABLE_COUNT;
+    std::printf(
+        "%.2f us per checkpoint, %.1f us per game of %.0f turns\n",
+        overhead / turns_per_game,
+        overhead,
+        turns_per_game
+    );
+
+    Checkpoint checkpoint;
+    create_tables().front()->checkpoint(checkpoint);
+    bench("Resumes", 10'000, "games", [&] {
+        for (size_t i = 0; i < 10'000; i += 1) {
+            const State state(create_ai_players(SEAT_COUNT), checkpoint);
+        }
+    });
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,110 @@
+#include "../src/player/endgame_solver.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "../src/simulation/batch_engine.hpp"
+#include "../src/state.hpp"
+#include "bench.hpp"
+
+constexpr size_t GAME_COUNT = 1'000;
+
+namespace {
+/// Collects the positions the solver applies to.
+class EndgameCollector: public BatchListener {
+  public:
+    explicit EndgameCollector(const EndgameSolver& solver) : solver_(solver) {}
+
+    void on_play(size_t, const Observation& observation, Action) override {
+        if (solver_.applies(observation)) {
+            positions.push_back(observation);
+        }
+    }
+
+    std::vector<Observation> positions;
+
+  private:
+    const EndgameSolver& solver_;
+};
+
+/// Returns the copies of each face that are not in the hand or on top.
+std::array<uint8_t, FACE_COUNT> unseen_faces(const Observation& observation) {
+    auto unseen = FACE_COPIES;
+    for (Face face = 0; face < FACE_COUNT; face += 1) {
+        unseen[face] -= std::min(unseen[face], observation.hand[face]);
+    }
+    unseen[observation.top_face] -= unseen[observation.top_face] > 0 ? 1 : 0;
+    return unseen;
+}
+
+/// Returns the share of two-player games won by a player with the endgame
+/// limits against one without a solver.
+double win_rate(EndgameLimits limits) {
+    const auto& evaluator = LinearEvaluator::get();
+    size_t wins = 0;
+    for (unsigned int seed = 0; seed < GAME_COUNT; seed += 1) {
+        // Alternate seats to cancel out the first-turn advantage.
+        const uint8_t seat = seed % 2;
+        std::vector<std::unique_ptr<Player>> players;
+        players.push_back(std::make_unique<LinearAiPlayer>(
+            evaluator,
+            EndgameLimits {.card_threshold = 0}
+        ));
+        players.insert(
+            players.begin() + seat,
+            std::make_unique<LinearAiPlayer>(evaluator, limits)
+        );
+        State state(std::move(players), seed);
+        while (state.update() != AppState::GameOver) {
+        }
+        wins += state.current_seat() == seat ? 1 : 0;
+    }
+    return static_cast<double>(wins) / GAME_COUNT;
+}
+} // namespace
+
+int main() {
+    for (uint8_t seat_count : {2, 4}) {
+        EndgameSolver solver;
+        EndgameCollector collector(solver);
+        BatchEngine batch(GAME_COUNT, seat_count, 0);
+        batch.set_listener(&collector);
+        batch.run();
+        const auto& positions = collector.positions;
+
+        size_t node_count = 0;
+        size_t exact_count = 0;
+        size_t unsolved_count = 0;
+        char name[64];
+        std::snprintf(
+            name,
+            sizeof(name),
+            "EndgameSolver, %d players",
+            seat_count
+        );
+        bench(name, positions.size(), "positions", [&] {
+            for (const auto& position : positions) {
+                if (!solver.solve(position, unseen_faces(position))) {
+                    unsolved_count += 1;
+                }
+                node_count += solver.node_count();
+                exact_count += solver.is_exact() ? 1 : 0;
+            }
+        });
+        std::printf(
+            "%zu positions, %.0f nodes per position, %.1f%% exact, %zu over "
+            "budget\n",
+            positions.size(),
+            static_cast<double>(node_count) / positions.size(),
+            100.0 * exact_count / positions.size(),
+            unsolved_count
+        );
+    }
+
+    std::printf(
+        "The solver wins %.1f%% of 2-player games against the evaluator "
+        "alone\n",
+        100.0 * win_rate({})
+    );
+}
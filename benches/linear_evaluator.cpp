@@ -0,0 +1,72 @@
+#include "../src/player/linear_evaluator.hpp"
+
+#include <bit>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "../src/simulation/batch_engine.hpp"
+#include "../src/state.hpp"
+#include "bench.hpp"
+
+constexpr size_t GAME_COUNT = 2'000;
+
+namespace {
+class ObservationCollector: public BatchListener {
+  public:
+    void on_play(size_t, const Observation& observation, Action) override {
+        observations.push_back(observation);
+    }
+
+    std::vector<Observation> observations;
+};
+
+/// Counts the moves the evaluator scores for the observation.
+size_t move_count(const Observation& observation) {
+    const auto wilds = observation.legal_faces >> WILD_FACE;
+    return std::popcount(observation.legal_faces) + std::popcount(wilds) * 3;
+}
+} // namespace
+
+int main() {
+    ObservationCollector collector;
+    BatchEngine batch(GAME_COUNT, 4, 0);
+    batch.set_listener(&collector);
+    batch.run();
+    const auto& observations = collector.observations;
+
+    size_t moves = 0;
+    for (const auto& observation : observations) {
+        moves += move_count(observation);
+    }
+
+    const auto evaluator = LinearEvaluator::load("assets/weights/linear.txt");
+    unsigned int checksum = 0;
+    const auto rate = bench("LinearEvaluator::choose", moves, "moves", [&] {
+        for (const auto& observation : observations) {
+            checksum += evaluator.choose(observation).face;
+        }
+    });
+    std::printf(
+        "%.1f ns per move, %.1f moves per decision (checksum %u)\n",
+        1e9 / rate,
+        static_cast<double>(moves) / observations.size(),
+        checksum
+    );
+
+    // Seat the evaluator against the first-playable-card heuristic.
+    size_t wins = 0;
+    for (unsigned int seed = 0; seed < GAME_COUNT; seed += 1) {
+        std::vector<std::unique_ptr<Player>> players;
+        players.push_back(std::make_unique<LinearAiPlayer>(evaluator));
+        players.push_back(std::make_unique<AiPlayer>());
+        State state(std::move(players), seed);
+        while (state.update() != AppState::GameOver) {
+        }
+        wins += state.current_seat() == 0 ? 1 : 0;
+    }
+    std::printf(
+        "LinearAiPlayer wins %.1f%% of 2-player games against AiPlayer\n",
+        100.0 * wins / GAME_COUNT
+    );
+}
@@ -0,0 +1,82 @@
+#include "../src/metrics.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../src/state.hpp"
+#include "../tests/players.hpp"
+#include "bench.hpp"
+
+constexpr size_t GAME_COUNT = 2'000;
+constexpr size_t RECORD_COUNT = 10'000'000;
+
+namespace {
+/// Plays games of AI players, and returns the turns played.
+size_t play_games(unsigned int first_seed) {
+    size_t turn_count = 0;
+    for (unsigned int seed = first_seed; seed < first_seed + GAME_COUNT;
+         seed += 1) {
+        State state(create_ai_players(), seed);
+        turn_count += 1;
+        while (state.update() != AppState::GameOver) {
+            turn_count += 1;
+        }
+    }
+    return turn_count;
+}
+
+/// Plays the same games with metrics off and on, a few times over, and
+/// returns the best rate of turns of each.
+std::pair<double, double> bench_games() {
+    // Measured in turns, which only a first run can count.
+    const auto turn_count = play_games(0);
+    double rate_off = 0.0;
+    double rate_on = 0.0;
+    for (size_t round = 0; round < 3; round += 1) {
+        are_metrics_enabled = false;
+        rate_off = std::max(
+            rate_off,
+            bench("Turns without metrics", turn_count, "turns", [] {
+                play_games(0);
+            })
+        );
+        are_metrics_enabled = true;
+        rate_on = std::max(
+            rate_on,
+            bench("Turns with metrics", turn_count, "turns", [] {
+                play_games(0);
+            })
+        );
+    }
+    return {rate_off, rate_on};
+}
+} // namespace
+
+int main() {
+    auto& counter = Metrics::get().counter("bench_total", "Benchmark.");
+    bench("Counter::add", RECORD_COUNT, "adds", [&] {
+        for (size_t i = 0; i < RECORD_COUNT; i += 1) {
+            counter.add();
+        }
+    });
+    auto& histogram = Metrics::get().histogram("bench_seconds", "Benchmark.");
+    bench("Histogram::record", RECORD_COUNT, "records", [&] {
+        for (size_t i = 0; i < RECORD_COUNT; i += 1) {
+            histogram.record(i);
+        }
+    });
+    bench("ScopedTimer", RECORD_COUNT, "timings", [&] {
+        for (size_t i = 0; i < RECORD_COUNT; i += 1) {
+            const ScopedTimer timer(histogram);
+        }
+    });
+
+    const auto [rate_off, rate_on] = bench_games();
+    std::printf(
+        "%+.1f%% time per turn with metrics\n",
+        100 * (rate_off / rate_on - 1)
+    );
+}
@@ -0,0 +1,103 @@
+#include "../src/player/plugin.hpp"
+
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "../src/simulation/batch_engine.hpp"
+#include "bench.hpp"
+
+constexpr size_t GAME_COUNT = 2'000;
+constexpr size_t ROUND_COUNT = 50;
+
+namespace {
+class ObservationCollector: public BatchListener {
+  public:
+    void on_play(size_t, const Observation& observation, Action) override {
+        observations.push_back(observation);
+    }
+
+    std::vector<Observation> observations;
+};
+
+/// Plays the legal face with the lowest index.
+Action choose_lowest(const Observation& observation) {
+    return {
+        static_cast<Face>(std::countr_zero(observation.legal_faces)),
+        Color::Red
+    };
+}
+
+UnoAction choose_lowest_c(void*, const UnoObservation* observation) {
+    return {
+        static_cast<uint8_t>(std::countr_zero(observation->legal_faces)),
+        0
+    };
+}
+
+constexpr UnoStrategy LOWEST = {
+    UNO_PLUGIN_ABI_VERSION,
+    "lowest",
+    nullptr,
+    nullptr,
+    choose_lowest_c,
+};
+
+/// Times the decisions of a plugin over every observation.
+double bench_plugin(
+    const char* name,
+    const Plugin& plugin,
+    const std::vector<Observation>& observations
+) {
+    void* context = plugin.create();
+    unsigned int checksum = 0;
+    const auto rate =
+        bench(name, observations.size() * ROUND_COUNT, "calls", [&] {
+            for (size_t round = 0; round < ROUND_COUNT; round += 1) {
+                for (const auto& observation : observations) {
+                    checksum += plugin.choose(context, observation).face;
+                }
+            }
+        });
+    plugin.destroy(context);
+    std::printf("%.1f ns per call (checksum %u)\n", 1e9 / rate, checksum);
+    return rate;
+}
+} // namespace
+
+/// Usage: bench_plugin [plugin library]
+int main(int argc, char* argv[]) {
+    ObservationCollector collector;
+    BatchEngine batch(GAME_COUNT, 4, 0);
+    batch.set_listener(&collector);
+    batch.run();
+    const auto& observations = collector.observations;
+
+    unsigned int checksum = 0;
+    const auto rate =
+        bench("direct call", observations.size() * ROUND_COUNT, "calls", [&] {
+            for (size_t round = 0; round < ROUND_COUNT; round += 1) {
+                for (const auto& observation : observations) {
+                    checksum += choose_lowest(observation).face;
+                }
+            }
+        });
+    std::printf("%.1f ns per call (checksum %u)\n", 1e9 / rate, checksum);
+
+    // The same strategy behind the C interface, as a plugin would be called
+    // once loaded.
+    bench_plugin("Plugin::choose, linked", Plugin(LOWEST), observations);
+
+    if (argc > 1) {
+        try {
+            const auto plugin = Plugin::load(argv[1]);
+            bench_plugin("Plugin::choose, loaded", *plugin, observations);
+        } catch (const std::exception& error) {
+            std::fprintf(stderr, "%s\n", error.what());
+            return EXIT_FAILURE;
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#include "../src/simulation/protocol.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string_view>
+#include <vector>
+
+#include "../src/simulation/batch_engine.hpp"
+#include "../src/simulation/bot_process.hpp"
+#include "bench.hpp"
+
+constexpr size_t GAME_COUNT = 2'000;
+constexpr size_t BATCH_SIZES[] = {1, 16, 256, 4'096};
+
+namespace {
+class ObservationCollector: public BatchListener {
+  public:
+    void on_play(size_t, const Observation& observation, Action) override {
+        observations.push_back(observation);
+    }
+
+    std::vector<Observation> observations;
+};
+
+/// Plays the legal face with the lowest index.
+Action choose_lowest(const Observation& observation) {
+    return {
+        static_cast<Face>(std::countr_zero(observation.legal_faces)),
+        Color::Red
+    };
+}
+} // namespace
+
+/// Times positions sent to a stub bot, which is this program started with
+/// `--stub`, in batches of several sizes.
+///
+/// Usage: bench_protocol
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string_view(argv[1]) == "--stub") {
+        serve_protocol("stub", choose_lowest);
+        return EXIT_SUCCESS;
+    }
+
+    ObservationCollector collector;
+    BatchEngine batch(GAME_COUNT, 4, 0);
+    batch.set_listener(&collector);
+    batch.run();
+    const auto& observations = collector.observations;
+    std::vector<Action> actions(observations.size());
+
+    // Without the pipe, as a bound on the throughput.
+    std::string message;
+    bench("encode and parse", observations.size(), "positions", [&] {
+        for (size_t i = 0; i < observations.size(); i += 1) {
+            message.clear();
+            write_position(message, observations[i]);
+            message.pop_back();
+            actions[i] = choose_lowest(parse_position(message));
+        }
+    });
+
+    try {
+        BotProcess bot({argv[0], "--stub"});
+        for (const auto batch_size : BATCH_SIZES) {
+            const auto name = "batches of " + std::to_string(batch_size);
+            bench(name, observations.size(), "positions", [&] {
+                for (size_t first = 0; first < observations.size();
+                     first += batch_size) {
+                    const auto count =
+                        std::min(batch_size, observations.size() - first);
+                    bot.choose(
+                        std::span(observations).subspan(first, count),
+                        std::span(actions).subspan(first, count)
+                    );
+                }
+            });
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,55 @@
+#include "../src/scene.hpp"
+
+#include <cstdio>
+#include <format>
+
+#include "bench.hpp"
+
+constexpr size_t FRAME_COUNT = 2'000;
+const sf::Vector2u FRAME_SIZE(1536, 864);
+
+/// Prints the CPU time per frame of the scene: collecting the cards with
+/// `State::render` alone, and a whole frame drawn into an offscreen texture.
+void bench_scene(const char* name, const SceneSpec& spec) {
+    const auto state = build_scene(spec);
+    const Animator animator;
+    SpriteBatch batch;
+
+    const auto render_rate = bench(
+        std::format("State::render {}", name),
+        FRAME_COUNT,
+        "frames",
+        [&] {
+            for (size_t i = 0; i < FRAME_COUNT; i += 1) {
+                batch.clear();
+                state->render(batch, animator, sf::Vector2f(FRAME_SIZE));
+            }
+        }
+    );
+
+    sf::RenderTexture texture(FRAME_SIZE);
+    const auto frame_rate = bench(
+        std::format("Offscreen frame {}", name),
+        FRAME_COUNT,
+        "frames",
+        [&] {
+            for (size_t i = 0; i < FRAME_COUNT; i += 1) {
+                texture.clear(SCENE_BACKGROUND);
+                state->draw(texture, batch, animator);
+                texture.display();
+            }
+        }
+    );
+    std::printf(
+        "%zu triangles: %.1f us to render, %.1f us per frame\n",
+        batch.triangle_count(),
+        1e6 / render_rate,
+        1e6 / frame_rate
+    );
+}
+
+int main() {
+    bench_scene("small", {.seed = 1});
+    bench_scene("medium", {.seed = 1, .hand_size = 20, .discard_count = 20});
+    bench_scene("large", {.seed = 1, .hand_size = 40, .discard_count = 39});
+}
@@ -0,0 +1,70 @@
+#include "../src/replay.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../tests/players.hpp"
+#include "bench.hpp"
+
+constexpr size_t SEEK_COUNT = 2'000;
+
+namespace {
+/// Records the longest of a few games of AI players, and returns its turns.
+uint32_t record_long_game(
+    const std::filesystem::path& path,
+    uint32_t keyframe_interval
+) {
+    unsigned int longest_seed = 0;
+    size_t longest = 0;
+    for (unsigned int seed = 0; seed < 200; seed += 1) {
+        State state(create_ai_players(), seed);
+        size_t turn_count = 1;
+        while (state.update() != AppState::GameOver) {
+            turn_count += 1;
+        }
+        if (turn_count > longest) {
+            longest = turn_count;
+            longest_seed = seed;
+        }
+    }
+
+    ReplayWriter writer(path, keyframe_interval);
+    State state(create_ai_players(), longest_seed, writer);
+    do {
+        writer.begin_turn(state);
+    } while (state.update() != AppState::GameOver);
+    writer.finish();
+    return static_cast<uint32_t>(longest);
+}
+
+/// Times seeks to random turns of the replay.
+void bench_seeks(const char* name, const std::filesystem::path& path) {
+    const Replay replay(path);
+    ReplayCursor cursor(replay);
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<uint32_t> turns(0, replay.turn_count());
+    const auto rate = bench(name, SEEK_COUNT, "seeks", [&] {
+        for (size_t i = 0; i < SEEK_COUNT; i += 1) {
+            cursor.seek(turns(rng));
+        }
+    });
+    std::printf("%.1f us per seek\n", 1e6 / rate);
+}
+} // namespace
+
+int main() {
+    const auto path =
+        std::filesystem::temp_directory_path() / "uno_bench.unoreplay";
+
+    // A single keyframe replays every turn from the deal, like re-simulating
+    // from the seed.
+    const auto turn_count = record_long_game(path, 1'000'000);
+    std::printf("game of %u turns\n", turn_count);
+    bench_seeks("Seeks from the deal", path);
+    record_long_game(path, ReplayWriter::DEFAULT_KEYFRAME_INTERVAL);
+    bench_seeks("Seeks from keyframes", path);
+    std::filesystem::remove(path);
+}
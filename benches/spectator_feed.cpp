@@ -0,0 +1,71 @@
+#include "../src/spectator_feed.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "../tests/players.hpp"
+#include "bench.hpp"
+
+constexpr size_t GAME_COUNT = 200;
+constexpr size_t SPECTATOR_COUNT = 500;
+
+namespace {
+struct Spectator {
+    SpectatorFeed::Subscription subscription;
+    SpectatorView view;
+};
+
+/// Plays the games and calls `after_turn` with the feed after every turn.
+template <typename F>
+size_t broadcast_games(F&& after_turn) {
+    size_t turn_count = 0;
+    for (unsigned int seed = 0; seed < GAME_COUNT; seed += 1) {
+        SpectatorFeed feed;
+        State state(create_ai_players(), seed, feed);
+        feed.publish(state);
+        after_turn(feed);
+        while (state.update() != AppState::GameOver) {
+            feed.publish(state);
+            after_turn(feed);
+            turn_count += 1;
+        }
+    }
+    return turn_count;
+}
+} // namespace
+
+int main() {
+    const auto turn_count = broadcast_games([](const SpectatorFeed&) {});
+    std::printf("%zu turns\n", turn_count);
+
+    // Every spectator receives and applies every turn, as a client would.
+    std::vector<SpectatorFeed::Message> messages;
+    size_t byte_count = 0;
+    const auto rate = bench(
+        "Turns to 500 spectators",
+        turn_count * SPECTATOR_COUNT,
+        "deliveries",
+        [&] {
+            std::vector<Spectator> spectators(SPECTATOR_COUNT);
+            broadcast_games([&](const SpectatorFeed& feed) {
+                for (auto& spectator : spectators) {
+                    messages.clear();
+                    feed.poll(spectator.subscription, messages);
+                    for (const auto& message : messages) {
+                        spectator.view.apply(
+                            std::as_bytes(std::span(*message))
+                        );
+                    }
+                }
+                byte_count += messages.empty() ? 0 : messages.back()->size();
+            });
+        }
+    );
+    std::printf(
+        "%.0f ns per delivery, %.1f bytes per turn\n",
+        1e9 / rate,
+        static_cast<double>(byte_count) / turn_count
+    );
+}
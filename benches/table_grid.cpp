@@ -0,0 +1,36 @@
+#include "../src/table_grid.hpp"
+
+#include <cstdio>
+
+#include "../src/sprite_batch.hpp"
+#include "bench.hpp"
+
+constexpr size_t TABLE_COUNT = 64;
+constexpr uint8_t SEAT_COUNT = 4;
+constexpr size_t FRAME_COUNT = 600;
+constexpr float FRAME_TIME = 1.0f / 60.0f;
+
+/// Measures the render thread's side of a frame of the wall: advancing every
+/// table and collecting their cards into one batch. The draw call itself
+/// needs a window and is not included.
+int main() {
+    TableGrid grid(TABLE_COUNT, SEAT_COUNT);
+    SpriteBatch batch;
+    const sf::Vector2f size(1920.0f, 1080.0f);
+
+    size_t triangle_count = 0;
+    bench("TableGrid update and batch", FRAME_COUNT, "frames", [&] {
+        for (size_t i = 0; i < FRAME_COUNT; i += 1) {
+            grid.update(FRAME_TIME, 1.0f);
+            batch.clear();
+            grid.render(batch, size);
+            triangle_count += batch.triangle_count();
+        }
+    });
+    std::printf(
+        "%zu tables, %.0f triangles per frame on average, %zu games started\n",
+        TABLE_COUNT,
+        static_cast<double>(triangle_count) / FRAME_COUNT,
+        grid.game_count()
+    );
+}
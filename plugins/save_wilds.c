@@ -0,0 +1,60 @@
+#include "../src/player/uno_plugin.h"
+
+/*
+ * A stateless strategy that plays a card of the color it holds most, and
+ * keeps its wild cards until nothing else fits.
+ */
+
+static uint8_t most_held_color(const UnoObservation* observation) {
+    uint8_t counts[UNO_COLOR_COUNT] = {0, 0, 0, 0};
+    for (uint8_t face = 0; face < UNO_WILD_FACE; face += 1) {
+        counts[face / UNO_RANKS_PER_COLOR] += observation->hand[face];
+    }
+    uint8_t color = 0;
+    for (uint8_t i = 1; i < UNO_COLOR_COUNT; i += 1) {
+        if (counts[i] > counts[color]) {
+            color = i;
+        }
+    }
+    return color;
+}
+
+static int is_legal(const UnoObservation* observation, uint8_t face) {
+    return (observation->legal_faces >> face & 1) != 0;
+}
+
+static UnoAction choose(void* context, const UnoObservation* observation) {
+    (void)context;
+    const uint8_t color = most_held_color(observation);
+    UnoAction action = {UNO_FACE_COUNT, color};
+    for (uint8_t face = 0; face < UNO_WILD_FACE; face += 1) {
+        if (!is_legal(observation, face)) {
+            continue;
+        }
+        if (face / UNO_RANKS_PER_COLOR == color) {
+            action.face = face;
+            return action;
+        }
+        if (action.face == UNO_FACE_COUNT) {
+            action.face = face;
+        }
+    }
+    if (action.face == UNO_FACE_COUNT) {
+        action.face = is_legal(observation, UNO_WILD_FACE)
+            ? UNO_WILD_FACE
+            : UNO_WILD_DRAW_FOUR_FACE;
+    }
+    return action;
+}
+
+static const UnoStrategy STRATEGY = {
+    UNO_PLUGIN_ABI_VERSION,
+    "save_wilds",
+    0,
+    0,
+    choose,
+};
+
+UNO_PLUGIN_EXPORT const UnoStrategy* uno_plugin_strategy(void) {
+    return &STRATEGY;
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "card/card.hpp"
+#include "sprite_batch.hpp"
+#include "spsc_queue.hpp"
+#include "table_layout.hpp"
+#include "table_snapshot.hpp"
+
+/// A card moving across the table.
+struct CardMotion {
+    enum class Kind : uint8_t {
+        Draw, // From the deck to a hand
+        Play, // From a hand to the discard pile
+    };
+
+    Kind kind;
+    uint8_t seat;
+    uint8_t atlas_index;
+    bool is_face_up;
+    float delay; // Seconds to wait after the previous motion
+};
+
+/// Moves the cards that the engine deals and plays across the table, one
+/// after another.
+///
+/// The gameplay thread pushes motions as the engine emits events and goes on
+/// at once. The render thread advances the motions on a fixed time step, so
+/// they take the same time at any frame rate, and interpolates between the
+/// last two steps when drawing. Until a card has arrived, it is hidden from
+/// the snapshot it already belongs to.
+class Animator {
+  public:
+    /// Simulated time between two steps, in seconds.
+    static constexpr float TIME_STEP = 1.0f / 120.0f;
+    static constexpr float DRAW_DURATION = 0.4f;
+    static constexpr float PLAY_DURATION = 0.4f;
+    /// Simulated time caught up on at most per frame, so that a stalled
+    /// window, e.g. while dragged, does not make the cards jump.
+    static constexpr float MAX_LAG = 0.25f;
+
+    /// Queues a motion. Dropped if the animator is cancelled or too far
+    /// behind. Gameplay thread only.
+    void push(const CardMotion& motion) {
+        if (pending_.fetch_add(1, std::memory_order_relaxed) & CANCELLED
+            || !motions_.try_push(motion)) {
+            finish(1);
+        }
+    }
+
+    /// Blocks until every queued motion has arrived, or the animator is
+    /// cancelled.
+    void wait_until_idle() const {
+        auto pending = pending_.load(std::memory_order_acquire);
+        while (pending != 0 && !(pending & CANCELLED)) {
+            pending_.wait(pending, std::memory_order_acquire);
+            pending = pending_.load(std::memory_order_acquire);
+        }
+    }
+
+    /// Releases the gameplay thread from waiting, now and until `reset`.
+    void cancel() {
+        pending_.fetch_or(CANCELLED, std::memory_order_release);
+        pending_.notify_all();
+    }
+
+    /// Drops every motion and starts over. Only while the gameplay thread
+    /// does not push motions.
+    void reset() {
+        while (motions_.try_pop()) {
+        }
+        tweens_.clear();
+        pending_ = 0;
+        time_ = 0.0;
+        end_time_ = 0.0;
+        lag_ = 0.0f;
+    }
+
+    /// Advances the motions by the time elapsed since the last frame, calling
+    /// `on_start` with every motion that sets off. Render thread only.
+    template <typename F>
+    void update(float seconds, F&& on_start) {
+        lag_ = std::min(lag_ + seconds, MAX_LAG);
+        while (lag_ >= TIME_STEP) {
+            lag_ -= TIME_STEP;
+            step(on_start);
+        }
+    }
+
+    /// Removes the cards that have not arrived yet from a snapshot. A card
+    /// about to be played is still in the hand. Render thread only.
+    void hide_moving_cards(TableSnapshot& snapshot) const {
+        // The snapshot may already hold the cards of motions queued since
+        // the last step, which set off at the next one.
+        take_queued_motions();
+        for (const auto& tween : tweens_) {
+            const auto& motion = tween.motion;
+            switch (motion.kind) {
+                case CardMotion::Kind::Draw:
+                    erase_last(snapshot.hands[motion.seat], motion.atlas_index);
+                    break;
+                case CardMotion::Kind::Play:
+                    erase_last(snapshot.discard_pile, motion.atlas_index);
+                    if (!tween.is_started) {
+                        snapshot.hands[motion.seat].push_back(
+                            {motion.atlas_index, false}
+                        );
+                    }
+                    break;
+            }
+        }
+    }
+
+    /// Renders the cards on their way. Render thread only.
+    void render(SpriteBatch& batch, const TableLayout& layout) const {
+        const auto alpha = lag_ / TIME_STEP;
+        for (const auto& tween : tweens_) {
+            if (!tween.is_started) {
+                continue;
+            }
+            const auto& motion = tween.motion;
+            const auto deck = layout.deck_position();
+            const auto pile = layout.center();
+            const auto seat = layout.seat_position(motion.seat);
+            const auto seat_rotation =
+                (layout.seat_angle(motion.seat) - sf::degrees(90.0f))
+                    .wrapSigned();
+            const auto is_draw = motion.kind == CardMotion::Kind::Draw;
+            const auto from = is_draw ? deck : seat;
+            const auto to = is_draw ? seat : pile;
+            const auto from_rotation = is_draw ? sf::Angle() : seat_rotation;
+            const auto to_rotation = is_draw ? seat_rotation : sf::Angle();
+
+            const auto t = ease(
+                tween.previous + (tween.current - tween.previous) * alpha
+            );
+            auto sprite = motion.is_face_up
+                ? Card::get_sprite(motion.atlas_index)
+                : Card::get_back_sprite();
+            sprite.setPosition(from + (to - from) * t);
+            sprite.setRotation(
+                from_rotation + (to_rotation - from_rotation) * t
+            );
+            batch.add(sprite);
+        }
+    }
+
+    /// Returns whether no motion is queued or under way. Render thread only.
+    bool is_idle() const noexcept {
+        return tweens_.empty() && has_arrived();
+    }
+
+    /// Returns whether every motion pushed so far has arrived.
+    bool has_arrived() const noexcept {
+        return (pending_.load(std::memory_order_acquire) & ~CANCELLED) == 0;
+    }
+
+  private:
+    /// Marks a cancelled animator in `pending_`.
+    static constexpr uint32_t CANCELLED = uint32_t {1} << 31;
+
+    struct Tween {
+        CardMotion motion;
+        double start; // Simulated time the card sets off
+        double end;
+        float previous; // Progress at the step before last, from 0 to 1
+        float current;  // Progress at the last step
+        bool is_started;
+    };
+
+    /// Schedules the queued motions after the ones under way.
+    void take_queued_motions() const {
+        while (const auto motion = motions_.try_pop()) {
+            const auto start = std::max(time_, end_time_) + motion->delay;
+            end_time_ = start
+                + (motion->kind == CardMotion::Kind::Draw ? DRAW_DURATION
+                                                          : PLAY_DURATION);
+            tweens_.push_back({*motion, start, end_time_, 0.0f, 0.0f, false});
+        }
+    }
+
+    template <typename F>
+    void step(F& on_start) {
+        time_ += TIME_STEP;
+        take_queued_motions();
+
+        for (auto& tween : tweens_) {
+            tween.previous = tween.current;
+            tween.current = static_cast<float>(std::clamp(
+                (time_ - tween.start) / (tween.end - tween.start),
+                0.0,
+                1.0
+            ));
+            if (!tween.is_started && time_ >= tween.start) {
+                tween.is_started = true;
+                on_start(tween.motion);
+            }
+        }
+
+        // Keep a card that has just arrived for one more step, so that it
+        // is drawn at its destination before the snapshot takes over.
+        const auto arrived = std::erase_if(tweens_, [](const Tween& tween) {
+            return tween.previous >= 1.0f;
+        });
+        if (arrived > 0) {
+            finish(static_cast<uint32_t>(arrived));
+        }
+    }
+
+    void finish(uint32_t count) {
+        pending_.fetch_sub(count, std::memory_order_release);
+        pending_.notify_all();
+    }
+
+    /// Eases in and out.
+    static float ease(float t) {
+        return t * t * (3.0f - 2.0f * t);
+    }
+
+    template <typename T>
+    static void erase_last(std::vector<T>& cards, uint8_t atlas_index) {
+        const auto it = std::find_if(
+            cards.rbegin(),
+            cards.rend(),
+            [&](const T& card) { return atlas_index_of(card) == atlas_index; }
+        );
+        if (it != cards.rend()) {
+            cards.erase(std::next(it).base());
+        }
+    }
+
+    static uint8_t atlas_index_of(uint8_t atlas_index) {
+        return atlas_index;
+    }
+
+    static uint8_t atlas_index_of(const CardView& card) {
+        return card.atlas_index;
+    }
+
+    // Popped by the render thread, also while drawing.
+    mutable SpscQueue<CardMotion, 256> motions_;
+    /// Motions pushed but not arrived, and whether the animator is cancelled.
+    mutable std::atomic<uint32_t> pending_ = 0;
+
+    // Only touched by the render thread, which schedules queued motions
+    // while drawing as well.
+    mutable std::vector<Tween> tweens_;
+    double time_ = 0.0;             // Simulated time
+    mutable double end_time_ = 0.0; // When the last queued motion arrives
+    float lag_ = 0.0f;      // Real time not simulated yet
+};
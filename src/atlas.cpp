@@ -0,0 +1,265 @@
+#include "atlas.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "memory_stats.hpp"
+
+namespace {
+constexpr const char* BACKGROUND_PATH = "assets/images/background.png";
+constexpr const char* CARDS_PATH = "assets/images/cards.png";
+constexpr const char* FONT_PATH = "assets/fonts/arial.ttf";
+
+/// Names of the regions in index files.
+constexpr std::array<std::string_view, ATLAS_REGION_COUNT> REGION_NAMES = {
+    "background",
+    "cards",
+    "white",
+};
+
+/// Side of the white block, wide enough to sample its center exactly.
+constexpr int WHITE_SIZE = 4;
+/// Empty pixels around every image, so that neighbours do not bleed in.
+constexpr int PADDING = 1;
+
+/// An image to copy into the atlas, and where it ends up.
+struct Placement {
+    const sf::Image* image;
+    sf::IntRect source;
+    sf::IntRect* destination;
+};
+
+/// Places the images left to right on shelves as high as their highest
+/// image, and returns the size of the atlas.
+sf::Vector2u place_on_shelves(std::vector<Placement>& placements) {
+    int width = 0;
+    for (const auto& placement : placements) {
+        width = std::max(width, placement.source.size.x);
+    }
+
+    sf::Vector2i pen;
+    int shelf_height = 0;
+    for (auto& placement : placements) {
+        const auto size = placement.source.size;
+        if (pen.x + size.x > width) {
+            pen = {0, pen.y + shelf_height + PADDING};
+            shelf_height = 0;
+        }
+        *placement.destination = sf::IntRect(pen, size);
+        pen.x += size.x + PADDING;
+        shelf_height = std::max(shelf_height, size.y);
+    }
+    return sf::Vector2u(sf::Vector2i(width, pen.y + shelf_height));
+}
+
+std::string format_rect(const sf::IntRect& rect) {
+    return std::to_string(rect.position.x) + " "
+        + std::to_string(rect.position.y) + " " + std::to_string(rect.size.x)
+        + " " + std::to_string(rect.size.y);
+}
+} // namespace
+
+const Atlas& Atlas::get() {
+    static const auto instance = [] {
+        const MemoryScope scope(Subsystem::Sprites);
+        return std::filesystem::exists(INDEX_PATH)
+            ? load(IMAGE_PATH, INDEX_PATH)
+            : pack();
+    }();
+    return instance;
+}
+
+Atlas Atlas::pack() {
+    sf::Image background;
+    sf::Image cards;
+    sf::Font font;
+    if (!background.loadFromFile(BACKGROUND_PATH)
+        || !cards.loadFromFile(CARDS_PATH)) {
+        throw std::runtime_error("failed to open the images of the atlas");
+    }
+    if (!font.openFromFile(FONT_PATH)) {
+        throw std::runtime_error(std::string("failed to open ") + FONT_PATH);
+    }
+    const sf::Image white({WHITE_SIZE, WHITE_SIZE}, sf::Color::White);
+
+    Index index;
+    std::vector<Placement> placements = {
+        {&background,
+         sf::IntRect({0, 0}, sf::Vector2i(background.getSize())),
+         &index.regions[static_cast<size_t>(AtlasRegion::Background)]},
+        {&cards,
+         sf::IntRect({0, 0}, sf::Vector2i(cards.getSize())),
+         &index.regions[static_cast<size_t>(AtlasRegion::Cards)]},
+        {&white,
+         sf::IntRect({0, 0}, {WHITE_SIZE, WHITE_SIZE}),
+         &index.regions[static_cast<size_t>(AtlasRegion::White)]},
+    };
+
+    // Rasterize every glyph of a size before reading its page back, since
+    // the page grows as glyphs are added.
+    std::array<sf::Image, FONT_SIZES.size()> pages;
+    index.glyphs.resize(FONT_SIZES.size() * GLYPH_COUNT);
+    for (size_t i = 0; i < FONT_SIZES.size(); i += 1) {
+        std::array<sf::IntRect, GLYPH_COUNT> sources;
+        for (size_t j = 0; j < GLYPH_COUNT; j += 1) {
+            const auto& glyph = font.getGlyph(
+                static_cast<char32_t>(FIRST_GLYPH + j),
+                FONT_SIZES[i],
+                false
+            );
+            sources[j] = glyph.textureRect;
+            index.glyphs[i * GLYPH_COUNT + j] = {
+                {},
+                glyph.bounds,
+                glyph.advance,
+            };
+        }
+        index.line_spacings[i] = font.getLineSpacing(FONT_SIZES[i]);
+        pages[i] = font.getTexture(FONT_SIZES[i]).copyToImage();
+        for (size_t j = 0; j < GLYPH_COUNT; j += 1) {
+            placements.push_back({
+                &pages[i],
+                sources[j],
+                &index.glyphs[i * GLYPH_COUNT + j].texture_rect,
+            });
+        }
+    }
+
+    sf::Image image(place_on_shelves(placements), sf::Color::Transparent);
+    for (const auto& placement : placements) {
+        if (placement.source.size.x > 0 && placement.source.size.y > 0) {
+            [[maybe_unused]] const auto is_copied = image.copy(
+                *placement.image,
+                sf::Vector2u(placement.destination->position),
+                placement.source
+            );
+            assert(is_copied);
+        }
+    }
+    return Atlas(image, std::move(index));
+}
+
+Atlas Atlas::load(
+    const std::filesystem::path& image_path,
+    const std::filesystem::path& index_path
+) {
+    sf::Image image;
+    if (!image.loadFromFile(image_path)) {
+        throw std::runtime_error("failed to open " + image_path.string());
+    }
+    std::ifstream file(index_path);
+    if (!file) {
+        throw std::runtime_error("failed to open " + index_path.string());
+    }
+
+    Index index;
+    index.glyphs.resize(FONT_SIZES.size() * GLYPH_COUNT);
+    std::string line;
+    for (size_t line_number = 1; std::getline(file, line); line_number += 1) {
+        std::istringstream stream(line);
+        std::string kind;
+        if (!(stream >> kind) || kind.starts_with('#')) {
+            continue;
+        }
+        const auto read_rect = [&](sf::IntRect& rect) {
+            stream >> rect.position.x >> rect.position.y >> rect.size.x
+                >> rect.size.y;
+        };
+
+        if (kind == "region") {
+            std::string name;
+            stream >> name;
+            const auto it = std::ranges::find(REGION_NAMES, name);
+            if (it != REGION_NAMES.end()) {
+                read_rect(index.regions[it - REGION_NAMES.begin()]);
+            } else {
+                stream.setstate(std::ios::failbit);
+            }
+        } else if (kind == "font") {
+            unsigned int size;
+            stream >> size;
+            if (stream && Atlas::has_font_size(size)) {
+                stream >> index.line_spacings[font_index(size)];
+            } else {
+                stream.setstate(std::ios::failbit);
+            }
+        } else if (kind == "glyph") {
+            unsigned int size;
+            uint32_t character;
+            stream >> size >> character;
+            if (stream && Atlas::has_font_size(size) && character >= FIRST_GLYPH
+                && character <= LAST_GLYPH) {
+                auto& glyph = index.glyphs
+                    [font_index(size) * GLYPH_COUNT + character - FIRST_GLYPH];
+                read_rect(glyph.texture_rect);
+                stream >> glyph.bounds.position.x >> glyph.bounds.position.y
+                    >> glyph.bounds.size.x >> glyph.bounds.size.y
+                    >> glyph.advance;
+            } else {
+                stream.setstate(std::ios::failbit);
+            }
+        } else {
+            stream.setstate(std::ios::failbit);
+        }
+
+        if (!stream) {
+            throw std::runtime_error(
+                index_path.string() + ":" + std::to_string(line_number)
+                + ": expected a region, a font or a glyph"
+            );
+        }
+    }
+    return Atlas(image, std::move(index));
+}
+
+void Atlas::save(
+    const std::filesystem::path& image_path,
+    const std::filesystem::path& index_path
+) const {
+    if (!texture_.copyToImage().saveToFile(image_path)) {
+        throw std::runtime_error("failed to write " + image_path.string());
+    }
+    std::ofstream file(index_path);
+    file << "# Index of " << image_path.filename().string()
+         << ", written by pack_atlas\n";
+    for (size_t i = 0; i < ATLAS_REGION_COUNT; i += 1) {
+        file << "region " << REGION_NAMES[i] << " "
+             << format_rect(regions_[i]) << "\n";
+    }
+    for (size_t i = 0; i < FONT_SIZES.size(); i += 1) {
+        file << "font " << FONT_SIZES[i] << " " << line_spacings_[i] << "\n";
+        for (size_t j = 0; j < GLYPH_COUNT; j += 1) {
+            const auto& glyph = glyphs_[i * GLYPH_COUNT + j];
+            file << "glyph " << FONT_SIZES[i] << " " << FIRST_GLYPH + j << " "
+                 << format_rect(glyph.texture_rect) << " "
+                 << glyph.bounds.position.x << " " << glyph.bounds.position.y
+                 << " " << glyph.bounds.size.x << " " << glyph.bounds.size.y
+                 << " " << glyph.advance << "\n";
+        }
+    }
+    if (!file) {
+        throw std::runtime_error("failed to write " + index_path.string());
+    }
+}
+
+const AtlasGlyph& Atlas::glyph(unsigned int size, char32_t character) const {
+    if (character < FIRST_GLYPH || character > LAST_GLYPH) {
+        character = U'?';
+    }
+    return glyphs_[font_index(size) * GLYPH_COUNT + character - FIRST_GLYPH];
+}
+
+float Atlas::line_spacing(unsigned int size) const {
+    return line_spacings_[font_index(size)];
+}
+
+size_t Atlas::font_index(unsigned int size) {
+    const auto it = std::ranges::find(FONT_SIZES, size);
+    assert(it != FONT_SIZES.end());
+    return static_cast<size_t>(it - FONT_SIZES.begin());
+}
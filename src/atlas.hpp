@@ -0,0 +1,116 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+/// An image packed into the atlas.
+enum class AtlasRegion : uint8_t {
+    Background,
+    Cards, // The grid of card faces and backs
+    White, // A few white pixels, to draw plain shapes from the atlas
+};
+
+constexpr size_t ATLAS_REGION_COUNT = 3;
+
+/// A glyph of the UI font, rasterized into the atlas.
+struct AtlasGlyph {
+    sf::IntRect texture_rect;
+    sf::FloatRect bounds; // Relative to the pen on the baseline
+    float advance;
+};
+
+/// Every image the game draws, packed into one texture: the background, the
+/// cards, a white block for plain shapes and the glyphs of the UI font at
+/// the sizes the UI uses. A whole frame is drawn from it without switching
+/// textures.
+///
+/// `pack_atlas` bakes the atlas into assets/images/atlas.png and an index
+/// next to it. Without them, the atlas is packed from the source assets on
+/// first use.
+class Atlas {
+  public:
+    /// Font sizes with their glyphs in the atlas.
+    static constexpr std::array<unsigned int, 3> FONT_SIZES = {32, 48, 72};
+    /// Printable ASCII, from the space to the tilde.
+    static constexpr char32_t FIRST_GLYPH = U' ';
+    static constexpr char32_t LAST_GLYPH = U'~';
+
+    /// Returns whether the atlas holds the glyphs of the font size.
+    static constexpr bool has_font_size(unsigned int size) noexcept {
+        return std::ranges::find(FONT_SIZES, size) != FONT_SIZES.end();
+    }
+
+    static constexpr const char* IMAGE_PATH = "assets/images/atlas.png";
+    static constexpr const char* INDEX_PATH = "assets/images/atlas.txt";
+
+    /// Returns the baked atlas, or packs one if it has not been baked.
+    /// Needs an OpenGL context, like any texture.
+    static const Atlas& get();
+
+    /// Packs the source assets into an atlas, loading the font once.
+    /// Throws `std::runtime_error` if an asset fails to load.
+    static Atlas pack();
+
+    /// Loads a baked atlas. Throws `std::runtime_error` on failure.
+    static Atlas load(
+        const std::filesystem::path& image_path,
+        const std::filesystem::path& index_path
+    );
+
+    /// Bakes the atlas into an image and its index. Throws
+    /// `std::runtime_error` on failure.
+    void save(
+        const std::filesystem::path& image_path,
+        const std::filesystem::path& index_path
+    ) const;
+
+    const sf::Texture& texture() const noexcept {
+        return texture_;
+    }
+
+    sf::IntRect region(AtlasRegion region) const noexcept {
+        return regions_[static_cast<size_t>(region)];
+    }
+
+    /// Returns a point of the texture inside the white block.
+    sf::Vector2f white_texel() const noexcept {
+        const auto white = region(AtlasRegion::White);
+        return sf::Vector2f(white.position) + sf::Vector2f(white.size) / 2.0f;
+    }
+
+    /// Returns the glyph of the character at one of the `FONT_SIZES`, or of
+    /// a question mark for a character outside the atlas.
+    const AtlasGlyph& glyph(unsigned int size, char32_t character) const;
+
+    /// Returns the distance between two lines of text at one of the
+    /// `FONT_SIZES`.
+    float line_spacing(unsigned int size) const;
+
+  private:
+    static constexpr size_t GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+
+    struct Index {
+        std::array<sf::IntRect, ATLAS_REGION_COUNT> regions;
+        std::array<float, FONT_SIZES.size()> line_spacings;
+        std::vector<AtlasGlyph> glyphs; // By font size, then character
+    };
+
+    Atlas(const sf::Image& image, Index index) :
+        texture_(image),
+        regions_(index.regions),
+        line_spacings_(index.line_spacings),
+        glyphs_(std::move(index.glyphs)) {}
+
+    static size_t font_index(unsigned int size);
+
+    sf::Texture texture_;
+    std::array<sf::IntRect, ATLAS_REGION_COUNT> regions_;
+    std::array<float, FONT_SIZES.size()> line_spacings_;
+    std::vector<AtlasGlyph> glyphs_;
+};
@@ -1,25 +1,46 @@
 #pragma once
 
 #include <SFML/Audio.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
 #include <format>
 #include <random>
+#include <thread>
 
+#include "memory_stats.hpp"
+#include "spsc_queue.hpp"
+
+/// A kind of sound, played from one of a few recordings at random.
+enum class SoundEffect : uint8_t {
+    Place, // A card put on the pile
+    Slide, // A card slid into a hand
+};
+
+/// Plays sounds on a thread of its own.
+///
+/// Posting a sound only queues it and never waits for the audio backend.
+/// The audio thread decodes the recordings once at startup, then plays the
+/// queued sounds as they come.
 class Audio {
   public:
     Audio(Audio&) = delete;
 
-    void play_random_place_sound() {
-        std::uniform_int_distribution<size_t> dist(0, 3);
-        const auto index = dist(rng_);
-        place_sounds_[index].play();
+    ~Audio() {
+        thread_.request_stop();
+        wake();
+        thread_.join();
     }
 
-    void play_random_slide_sound() {
-        std::uniform_int_distribution<size_t> dist(0, 7);
-        const auto index = dist(rng_);
-        slide_sounds_[index].play();
+    /// Queues a sound. Dropped if the audio thread is too far behind to play
+    /// it in time. Render thread only, as the single producer of the queue.
+    void play(SoundEffect effect) {
+        if (commands_.try_push(effect)) {
+            wake();
+        }
     }
 
+    /// Returns the instance, starting the audio thread on first use.
     static Audio& get() {
         static Audio instance;
         return instance;
@@ -27,7 +48,6 @@ class Audio {
 
   private:
     Audio() :
-        rng_(std::random_device {}()),
         place_sounds_ {
             sf::Sound(place_buffers_[0]),
             sf::Sound(place_buffers_[1]),
@@ -43,7 +63,35 @@ class Audio {
             sf::Sound(slide_buffers_[5]),
             sf::Sound(slide_buffers_[6]),
             sf::Sound(slide_buffers_[7])
-        } {
+        },
+        thread_([this](std::stop_token stop_token) { run(stop_token); }) {}
+
+    /// Signals the audio thread that a command was posted.
+    void wake() {
+        posted_.fetch_add(1, std::memory_order_release);
+        posted_.notify_one();
+    }
+
+    void run(std::stop_token stop_token) {
+        load();
+        while (true) {
+            const auto posted = posted_.load(std::memory_order_acquire);
+            // Checked after loading the count: the destructor requests the
+            // stop before it bumps the count, so either the stop is seen here
+            // or the bump comes later and ends the wait below.
+            if (stop_token.stop_requested()) {
+                break;
+            }
+            while (const auto effect = commands_.try_pop()) {
+                play_now(*effect);
+            }
+            // Sleep until the next command, unless one came in meanwhile.
+            posted_.wait(posted, std::memory_order_acquire);
+        }
+    }
+
+    void load() {
+        const MemoryScope scope(Subsystem::Audio);
         for (size_t i = 0; i < 4; ++i) {
             if (!place_buffers_[i].loadFromFile(
                     std::format("assets/audio/card-place-{}.ogg", i + 1)
@@ -62,11 +110,32 @@ class Audio {
         }
     }
 
-    std::mt19937 rng_;
+    void play_now(SoundEffect effect) {
+        switch (effect) {
+            case SoundEffect::Place: {
+                std::uniform_int_distribution<size_t> dist(0, 3);
+                place_sounds_[dist(rng_)].play();
+                break;
+            }
+            case SoundEffect::Slide: {
+                std::uniform_int_distribution<size_t> dist(0, 7);
+                slide_sounds_[dist(rng_)].play();
+                break;
+            }
+        }
+    }
+
+    // Only touched by the audio thread once it has started.
+    std::mt19937 rng_ {std::random_device {}()};
 
     sf::SoundBuffer place_buffers_[4];
     sf::Sound place_sounds_[4];
 
     sf::SoundBuffer slide_buffers_[8];
     sf::Sound slide_sounds_[8];
-};
\ No newline at end of file
+
+    SpscQueue<SoundEffect, 64> commands_;
+    /// Number of commands posted, which the audio thread waits on.
+    std::atomic<uint32_t> posted_ = 0;
+    std::jthread thread_; // Last, to start once everything else is built
+};
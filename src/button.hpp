@@ -3,32 +3,35 @@
 #include <SFML/Graphics.hpp>
 #include <memory>
 
+#include "sprite_batch.hpp"
+
 class Button {
   public:
     Button(std::unique_ptr<sf::Shape> shape) : shape_(std::move(shape)) {}
 
-    bool is_hovered(sf::RenderWindow& window) const {
-        return shape_->getGlobalBounds().contains(
-            window.mapPixelToCoords(sf::Mouse::getPosition(window))
-        );
+    /// Returns the area that takes clicks.
+    sf::FloatRect bounds() const {
+        return shape_->getGlobalBounds();
     }
 
-    bool is_left_clicked(sf::RenderWindow& window) const {
-        return is_hovered(window)
-            && sf::Mouse::isButtonPressed(sf::Mouse::Button::Left);
+    bool contains(sf::Vector2f point) const {
+        return bounds().contains(point);
     }
 
-    virtual void render(sf::RenderWindow& window) const {
-        constexpr float HIGHLIGHT_THICKNESS = 4.0f;
-
-        if (is_hovered(window)) {
-            shape_->setOutlineThickness(HIGHLIGHT_THICKNESS);
-            shape_->setOutlineColor(sf::Color::Yellow);
-        } else {
-            shape_->setOutlineThickness(HIGHLIGHT_THICKNESS);
-            shape_->setOutlineColor(sf::Color::Black);
-        }
-        window.draw(*shape_);
+    /// Renders the button over an outline, highlighted if the mouse is over
+    /// it.
+    virtual void render(SpriteBatch& batch, sf::Vector2f mouse_position)
+        const {
+        constexpr sf::Vector2f HIGHLIGHT_THICKNESS(4.0f, 4.0f);
+
+        auto outline = bounds();
+        outline.position -= HIGHLIGHT_THICKNESS;
+        outline.size += HIGHLIGHT_THICKNESS * 2.0f;
+        batch.add(
+            outline,
+            contains(mouse_position) ? sf::Color::Yellow : sf::Color::Black
+        );
+        batch.add(*shape_);
     }
 
     virtual void set_position(sf::Vector2f position) {
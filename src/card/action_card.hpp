@@ -1,6 +1,7 @@
 #pragma once
 
 #include "card.hpp"
+#include "composition.hpp"
 
 enum class ActionSymbol : uint8_t {
     DrawTwo,
@@ -28,12 +29,12 @@ class ActionCard: public Card {
     }
 
     uint8_t atlas_index() const noexcept override {
-        return static_cast<uint8_t>(color_) * 13 + 10
-            + static_cast<uint8_t>(symbol_);
+        return colored_face(
+            color_,
+            DRAW_TWO_RANK + static_cast<uint8_t>(symbol_)
+        );
     }
 
-    bool can_play_on(const Card& other) const noexcept override;
-
   private:
     Color color_;
     ActionSymbol symbol_;
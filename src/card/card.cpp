@@ -1,37 +1,90 @@
 #include "card.hpp"
 
+#include "../atlas.hpp"
+#include "../memory_stats.hpp"
+#include "composition.hpp"
+
 constexpr sf::Vector2i REGION_SIZE(50, 66);
 constexpr sf::Vector2i GRID_SIZE(8, 8);
 constexpr float CARD_SCALE = 2.0f;
 
-sf::Texture Card::atlas_texture_("assets/images/cards.png");
 std::vector<sf::Sprite> Card::sprites_;
 
+namespace {
+/// Precedes the memory of every card, to free it.
+struct alignas(std::max_align_t) AllocationHeader {
+    std::pmr::memory_resource* resource;
+    size_t size; // Including the header
+};
+
+/// Returns the rectangle of the card at the index in the atlas.
+sf::IntRect card_region(int atlas_index) {
+    return sf::IntRect(
+        Atlas::get().region(AtlasRegion::Cards).position
+            + sf::Vector2i(
+                REGION_SIZE.x * (atlas_index % GRID_SIZE.x),
+                REGION_SIZE.y * (atlas_index / GRID_SIZE.x)
+            ),
+        REGION_SIZE
+    );
+}
+} // namespace
+
+bool Card::can_play_on(const Card& other) const noexcept {
+    return (PLAYABLE_ATLAS_INDICES[other.atlas_index()] >> atlas_index() & 1)
+        != 0;
+}
+
+void* Card::operator new(size_t size, std::pmr::memory_resource* resource) {
+    const auto total_size = sizeof(AllocationHeader) + size;
+    auto* header = static_cast<AllocationHeader*>(
+        resource->allocate(total_size, alignof(AllocationHeader))
+    );
+    header->resource = resource;
+    header->size = total_size;
+    return header + 1;
+}
+
+void* Card::operator new(size_t size) {
+    return operator new(size, std::pmr::get_default_resource());
+}
+
+void Card::operator delete(void* card, size_t) noexcept {
+    if (card == nullptr) {
+        return;
+    }
+    auto* header = static_cast<AllocationHeader*>(card) - 1;
+    header->resource->deallocate(
+        header,
+        header->size,
+        alignof(AllocationHeader)
+    );
+}
+
+void Card::operator delete(void* card, std::pmr::memory_resource*) noexcept {
+    operator delete(card, size_t {0});
+}
+
 sf::Sprite Card::sprite() const {
+    return get_sprite(atlas_index());
+}
+
+sf::Sprite Card::get_sprite(uint8_t atlas_index) {
     if (sprites_.empty()) {
-        for (int atlas_index = 0; atlas_index <= 63; atlas_index += 1) {
-            const sf::IntRect region(
-                {REGION_SIZE.x * (atlas_index % GRID_SIZE.x),
-                 REGION_SIZE.y * (atlas_index / GRID_SIZE.x)},
-                REGION_SIZE
-            );
-            sf::Sprite sprite(atlas_texture_, region);
+        const MemoryScope scope(Subsystem::Sprites);
+        for (int index = 0; index <= 63; index += 1) {
+            sf::Sprite sprite(Atlas::get().texture(), card_region(index));
             sprite.setOrigin(sprite.getGlobalBounds().getCenter());
             sprite.setScale(sf::Vector2f(CARD_SCALE, CARD_SCALE));
             sprites_.push_back(std::move(sprite));
         }
     }
-    return sprites_[atlas_index()];
+    return sprites_[atlas_index];
 }
 
 sf::Sprite Card::get_back_sprite() {
     constexpr int ATLAS_INDEX = 55;
-    constexpr sf::IntRect REGION(
-        {REGION_SIZE.x * (ATLAS_INDEX % GRID_SIZE.x),
-         REGION_SIZE.y * (ATLAS_INDEX / GRID_SIZE.x)},
-        REGION_SIZE
-    );
-    sf::Sprite sprite(atlas_texture_, REGION);
+    sf::Sprite sprite(Atlas::get().texture(), card_region(ATLAS_INDEX));
     sprite.setOrigin(sprite.getGlobalBounds().getCenter());
     sprite.setScale(sf::Vector2f(CARD_SCALE, CARD_SCALE));
     return sprite;
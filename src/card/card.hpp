@@ -2,7 +2,9 @@
 
 #include <SFML/Graphics.hpp>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <memory_resource>
 #include <optional>
 #include <vector>
 
@@ -16,22 +18,37 @@ class Card {
     virtual ~Card() = default;
     /// Returns the value of the card.
     virtual uint8_t value() const noexcept = 0;
-    /// Returns the index of the card in the atlas texture.
+    /// Returns the index of the card in the grid of cards of the atlas.
     virtual uint8_t atlas_index() const noexcept = 0;
     /// Returns whether the card can be played on another card.
-    virtual bool can_play_on(const Card& other) const noexcept = 0;
+    bool can_play_on(const Card& other) const noexcept;
 
     /// Returns a sprite representing the card.
     sf::Sprite sprite() const;
 
+    /// Allocates a card from the memory resource, as in
+    /// `new (resource) NumberCard(color, 5)`. The resource is remembered,
+    /// so that deleting the card gives its memory back.
+    static void* operator new(size_t size, std::pmr::memory_resource* resource);
+    /// Allocates a card from the global heap.
+    static void* operator new(size_t size);
+    static void operator delete(void* card, size_t size) noexcept;
+    /// Frees a card whose constructor threw.
+    static void operator delete(
+        void* card,
+        std::pmr::memory_resource* resource
+    ) noexcept;
+
     auto operator<=>(const Card& rhs) const noexcept {
         return atlas_index() <=> rhs.atlas_index();
     }
 
+    /// Returns a sprite of the card at the index in the atlas texture.
+    static sf::Sprite get_sprite(uint8_t atlas_index);
+
     /// Returns a sprite representing the back of the card.
     static sf::Sprite get_back_sprite();
 
   private:
-    static sf::Texture atlas_texture_;
     static std::vector<sf::Sprite> sprites_;
 };
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "card.hpp"
+
+/// Identifies a card up to the color chosen for a wild card. The 52 colored
+/// faces are numbered like the atlas (13 per color: 0-9, Draw Two, Reverse,
+/// Skip), followed by Wild and Wild Draw Four.
+using Face = uint8_t;
+
+constexpr Face FACE_COUNT = 54;
+constexpr Face WILD_FACE = 52;
+constexpr Face WILD_DRAW_FOUR_FACE = 53;
+
+constexpr uint8_t COLOR_COUNT = 4;
+constexpr uint8_t RANKS_PER_COLOR = 13;
+constexpr uint8_t DRAW_TWO_RANK = 10;
+constexpr uint8_t REVERSE_RANK = 11;
+constexpr uint8_t SKIP_RANK = 12;
+/// The rank of wild cards, which never matches the rank of another card.
+constexpr uint8_t WILD_RANK = 13;
+constexpr uint8_t RANK_COUNT = WILD_RANK + 1;
+
+constexpr bool is_wild(Face face) noexcept {
+    return face >= WILD_FACE;
+}
+
+constexpr Color face_color(Face face) noexcept {
+    assert(!is_wild(face));
+    return static_cast<Color>(face / RANKS_PER_COLOR);
+}
+
+constexpr uint8_t face_rank(Face face) noexcept {
+    return is_wild(face) ? WILD_RANK : face % RANKS_PER_COLOR;
+}
+
+/// Returns the face of the color and rank, which is not wild.
+constexpr Face colored_face(Color color, uint8_t rank) noexcept {
+    assert(rank < WILD_RANK);
+    return static_cast<uint8_t>(color) * RANKS_PER_COLOR + rank;
+}
+
+// The atlas has a cell for every face, then, after two empty cells, a cell
+// for every wild face in every color. A face is its own atlas index.
+
+/// Number of cells of cards in the atlas, including the empty ones.
+constexpr uint8_t ATLAS_CARD_COUNT = 64;
+constexpr uint8_t FIRST_COLORED_WILD_INDEX = 56;
+
+/// Returns whether there is a card at the index in the atlas.
+constexpr bool is_card_atlas_index(uint8_t atlas_index) noexcept {
+    return atlas_index < FACE_COUNT
+        || (atlas_index >= FIRST_COLORED_WILD_INDEX
+            && atlas_index < ATLAS_CARD_COUNT);
+}
+
+/// Returns the atlas index of a wild face in the chosen color, if any.
+constexpr uint8_t wild_atlas_index(
+    Face face,
+    std::optional<Color> color
+) noexcept {
+    assert(is_wild(face));
+    if (!color.has_value()) {
+        return face;
+    }
+    return FIRST_COLORED_WILD_INDEX + (face - WILD_FACE) * COLOR_COUNT
+        + static_cast<uint8_t>(*color);
+}
+
+/// Returns the face of the card at the index in the atlas.
+constexpr Face atlas_face(uint8_t atlas_index) noexcept {
+    assert(is_card_atlas_index(atlas_index));
+    if (atlas_index < FACE_COUNT) {
+        return atlas_index;
+    }
+    return WILD_FACE + (atlas_index - FIRST_COLORED_WILD_INDEX) / COLOR_COUNT;
+}
+
+/// Returns the color of the card at the index in the atlas, which a wild
+/// card only has once played.
+constexpr std::optional<Color> atlas_color(uint8_t atlas_index) noexcept {
+    assert(is_card_atlas_index(atlas_index));
+    if (atlas_index < WILD_FACE) {
+        return face_color(atlas_index);
+    } else if (atlas_index < FACE_COUNT) {
+        return std::nullopt;
+    }
+    return static_cast<Color>(
+        (atlas_index - FIRST_COLORED_WILD_INDEX) % COLOR_COUNT
+    );
+}
+
+/// Copies of each face in a deck.
+constexpr std::array<uint8_t, FACE_COUNT> FACE_COPIES = [] {
+    std::array<uint8_t, FACE_COUNT> copies {};
+    for (Face face = 0; face < FACE_COUNT; face += 1) {
+        copies[face] = is_wild(face) ? 4 : face_rank(face) == 0 ? 1 : 2;
+    }
+    return copies;
+}();
+
+constexpr size_t DECK_SIZE = 108;
+
+/// The faces of a deck before it is shuffled. UNO includes 108 cards: 25 in
+/// each of four color suits (red, blue, green, yellow), each suit consisting
+/// of one zero, two each of 1 through 9, and two each of the action cards
+/// "Draw Two", "Reverse" and "Skip". The deck also contains four "Wild"
+/// cards and four "Wild Draw Four".
+///
+/// The order is that of every deck shuffled so far, which seeded games
+/// depend on.
+constexpr std::array<Face, DECK_SIZE> UNSHUFFLED_DECK = [] {
+    std::array<Face, DECK_SIZE> deck {};
+    size_t size = 0;
+    for (uint8_t color = 0; color < COLOR_COUNT; color += 1) {
+        const auto first = colored_face(static_cast<Color>(color), 0);
+        deck[size++] = first;
+        for (uint8_t rank = 1; rank <= SKIP_RANK; rank += 1) {
+            deck[size++] = first + rank;
+            deck[size++] = first + rank;
+        }
+    }
+    for (int i = 0; i < 4; i += 1) {
+        deck[size++] = WILD_FACE;
+        deck[size++] = WILD_DRAW_FOUR_FACE;
+    }
+    return deck;
+}();
+
+static_assert(
+    [] {
+        std::array<uint8_t, FACE_COUNT> copies {};
+        for (const auto face : UNSHUFFLED_DECK) {
+            if (face >= FACE_COUNT) {
+                return false;
+            }
+            copies[face] += 1;
+        }
+        return copies == FACE_COPIES;
+    }(),
+    "the deck holds every face as many times as FACE_COPIES"
+);
+static_assert(
+    [] {
+        std::array<size_t, COLOR_COUNT + 1> suits {};
+        for (const auto face : UNSHUFFLED_DECK) {
+            suits[is_wild(face) ? COLOR_COUNT : face / RANKS_PER_COLOR] += 1;
+        }
+        return suits == std::array<size_t, COLOR_COUNT + 1> {25, 25, 25, 25, 8};
+    }(),
+    "the deck has 25 cards of each color and 8 wild cards"
+);
+
+/// Returns whether the card at the atlas index can be played on top of the
+/// card at the other atlas index: a wild card always, another card if it
+/// matches the color or the rank.
+constexpr bool can_play_atlas_index_on(
+    uint8_t atlas_index,
+    uint8_t other_atlas_index
+) noexcept {
+    const auto face = atlas_face(atlas_index);
+    if (is_wild(face)) {
+        return true;
+    }
+    // A wild card on the pile without a color only takes another wild card.
+    const auto other_color = atlas_color(other_atlas_index);
+    return other_color == face_color(face)
+        || face_rank(face) == face_rank(atlas_face(other_atlas_index));
+}
+
+/// Bit sets of the atlas indices of the cards that can be played, by the
+/// atlas index of the card to play on.
+constexpr std::array<uint64_t, ATLAS_CARD_COUNT> PLAYABLE_ATLAS_INDICES = [] {
+    std::array<uint64_t, ATLAS_CARD_COUNT> indices {};
+    for (uint8_t other = 0; other < ATLAS_CARD_COUNT; other += 1) {
+        if (!is_card_atlas_index(other)) {
+            continue;
+        }
+        for (uint8_t index = 0; index < ATLAS_CARD_COUNT; index += 1) {
+            if (is_card_atlas_index(index)
+                && can_play_atlas_index_on(index, other)) {
+                indices[other] |= uint64_t {1} << index;
+            }
+        }
+    }
+    return indices;
+}();
+
+/// Bit sets of the faces that can be played, by color and rank to play on.
+constexpr std::array<uint64_t, COLOR_COUNT * RANK_COUNT> PLAYABLE_FACES = [] {
+    std::array<uint64_t, COLOR_COUNT * RANK_COUNT> faces {};
+    for (uint8_t color = 0; color < COLOR_COUNT; color += 1) {
+        for (uint8_t rank = 0; rank < RANK_COUNT; rank += 1) {
+            for (Face face = 0; face < FACE_COUNT; face += 1) {
+                if (is_wild(face) || face / RANKS_PER_COLOR == color
+                    || face_rank(face) == rank) {
+                    faces[color * RANK_COUNT + rank] |= uint64_t {1} << face;
+                }
+            }
+        }
+    }
+    return faces;
+}();
+
+/// Returns the bit set of the faces that can be played on a card of the
+/// color and rank.
+constexpr uint64_t playable_faces(Color color, uint8_t rank) noexcept {
+    return PLAYABLE_FACES[static_cast<uint8_t>(color) * RANK_COUNT + rank];
+}
+
+static_assert(
+    [] {
+        // The two relations agree on every colored card to play on.
+        for (uint8_t other = 0; other < ATLAS_CARD_COUNT; other += 1) {
+            const auto color = is_card_atlas_index(other)
+                ? atlas_color(other)
+                : std::nullopt;
+            if (!color.has_value()) {
+                continue;
+            }
+            const auto faces =
+                playable_faces(*color, face_rank(atlas_face(other)));
+            for (Face face = 0; face < FACE_COUNT; face += 1) {
+                const bool by_face = (faces >> face & 1) != 0;
+                const bool by_index =
+                    (PLAYABLE_ATLAS_INDICES[other] >> face & 1) != 0;
+                if (by_face != by_index) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }(),
+    "playable faces and playable atlas indices agree"
+);
+static_assert(
+    PLAYABLE_ATLAS_INDICES[WILD_FACE]
+        == (uint64_t {1} << WILD_FACE | uint64_t {1} << WILD_DRAW_FOUR_FACE
+            | uint64_t {0xFF} << FIRST_COLORED_WILD_INDEX),
+    "only wild cards are played on a wild card without a color"
+);
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+
+#include "action_card.hpp"
+#include "composition.hpp"
+#include "number_card.hpp"
+#include "wild_card.hpp"
+
+/// Returns a new card with the given index in the grid of cards of the
+/// atlas, which tells apart the colors chosen for wild cards, allocated from
+/// the memory resource.
+inline std::unique_ptr<Card> create_card(
+    uint8_t atlas_index,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+) {
+    if (!is_card_atlas_index(atlas_index)) {
+        throw std::invalid_argument("no card at this atlas index");
+    }
+    const auto face = atlas_face(atlas_index);
+    if (is_wild(face)) {
+        auto* card =
+            new (resource) WildCard(static_cast<WildSymbol>(face - WILD_FACE));
+        if (const auto color = atlas_color(atlas_index)) {
+            card->set_color(*color);
+        }
+        return std::unique_ptr<Card>(card);
+    }
+    const auto color = face_color(face);
+    const auto rank = face_rank(face);
+    if (rank < DRAW_TWO_RANK) {
+        return std::unique_ptr<Card>(new (resource) NumberCard(color, rank));
+    }
+    return std::unique_ptr<Card>(new (resource) ActionCard(
+        color,
+        static_cast<ActionSymbol>(rank - DRAW_TWO_RANK)
+    ));
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cassert>
+
+#include "card.hpp"
+#include "composition.hpp"
+
+/// Returns the face of a card.
+inline Face face_of(const Card& card) noexcept {
+    return atlas_face(card.atlas_index());
+}
+
+/// Returns the color of a card, which is the chosen color for a wild card.
+inline Color color_of(const Card& card) noexcept {
+    const auto color = atlas_color(card.atlas_index());
+    assert(color.has_value());
+    return *color;
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <stdexcept>
+
 #include "card.hpp"
+#include "composition.hpp"
 
 /// A number UNO card.
 class NumberCard: public Card {
@@ -24,12 +27,9 @@ class NumberCard: public Card {
     }
 
     uint8_t atlas_index() const noexcept override {
-        return static_cast<uint8_t>(color_) * 13
-            + static_cast<uint8_t>(number_);
+        return colored_face(color_, number_);
     }
 
-    bool can_play_on(const Card& other) const noexcept override;
-
   private:
     Color color_;
     uint8_t number_;
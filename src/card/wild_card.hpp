@@ -1,6 +1,7 @@
 #pragma once
 
 #include "card.hpp"
+#include "composition.hpp"
 
 enum class WildSymbol : uint8_t { Wild, WildDrawFour };
 
@@ -26,15 +27,10 @@ class WildCard: public Card {
     }
 
     uint8_t atlas_index() const noexcept override {
-        if (!color_.has_value()) {
-            return 4 * 13 + static_cast<uint8_t>(symbol_);
-        }
-        return 56 + static_cast<uint8_t>(symbol_) * 4
-            + static_cast<uint8_t>(color_.value());
-    }
-
-    bool can_play_on(const Card&) const noexcept override {
-        return true;
+        return wild_atlas_index(
+            WILD_FACE + static_cast<uint8_t>(symbol_),
+            color_
+        );
     }
 
   private:
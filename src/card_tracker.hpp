@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "card/face.hpp"
+#include "game_listener.hpp"
+#include "seating.hpp"
+
+/// Keeps count of the cards that have been seen in play, and of the faces
+/// each player is known not to hold. Every event is applied in constant time,
+/// so that an AI can ask what is left without rescanning the discard pile.
+class CardTracker: public GameListener {
+  public:
+    void on_card_turned_up(const Card& card) override {
+        discard(card);
+    }
+
+    /// A player who draws for lack of a playable card holds none of the faces
+    /// playable on the top card. Any other face may be the one drawn, so
+    /// earlier inferences no longer hold, and a penalty leaves nothing known.
+    void on_card_drawn(uint8_t seat, DrawReason reason, const Card*)
+        override {
+        if (reason == DrawReason::NoPlayableCard) {
+            voids_[seat] = playable_faces(top_color_, face_rank(top_face_));
+        } else {
+            voids_[seat] = 0;
+        }
+    }
+
+    void on_card_played(uint8_t, const Card& card) override {
+        discard(card);
+    }
+
+    void on_hands_swapped(uint8_t seat, uint8_t other_seat) override {
+        std::swap(voids_[seat], voids_[other_seat]);
+    }
+
+    void on_deck_refilled() override {
+        for (Face face = 0; face < FACE_COUNT; face += 1) {
+            copies_[face] += FACE_COPIES[face];
+        }
+    }
+
+    /// Returns the copies of the face that are neither discarded nor among
+    /// the given copies held by the player.
+    uint8_t unseen(Face face, uint8_t held) const noexcept {
+        const auto seen = discarded_[face] + held;
+        return static_cast<uint8_t>(
+            copies_[face] > seen ? copies_[face] - seen : 0
+        );
+    }
+
+    /// Returns the unseen copies of every face, given the player's hand.
+    std::array<uint8_t, FACE_COUNT> unseen_faces(
+        const std::array<uint8_t, FACE_COUNT>& hand
+    ) const noexcept {
+        std::array<uint8_t, FACE_COUNT> unseen;
+        for (Face face = 0; face < FACE_COUNT; face += 1) {
+            unseen[face] = this->unseen(face, hand[face]);
+        }
+        return unseen;
+    }
+
+    /// Returns the bit set of the faces the player at the seat is known not
+    /// to hold.
+    uint64_t voids(uint8_t seat) const noexcept {
+        return voids_[seat];
+    }
+
+    /// Returns whether the player at the seat is known to hold no card of
+    /// the color.
+    bool is_void(uint8_t seat, Color color) const noexcept {
+        const auto first = static_cast<uint8_t>(color) * RANKS_PER_COLOR;
+        const auto faces = ((uint64_t {1} << RANKS_PER_COLOR) - 1) << first;
+        return (voids_[seat] & faces) == faces;
+    }
+
+  private:
+    void discard(const Card& card) {
+        const auto atlas_index = card.atlas_index();
+        const auto face = atlas_face(atlas_index);
+        discarded_[face] += 1;
+        // Wild cards set aside while dealing have no color to play on.
+        if (const auto color = atlas_color(atlas_index)) {
+            top_face_ = face;
+            top_color_ = *color;
+        }
+    }
+
+    std::array<uint16_t, FACE_COUNT> copies_ = [] {
+        std::array<uint16_t, FACE_COUNT> copies;
+        std::ranges::copy(FACE_COPIES, copies.begin());
+        return copies;
+    }();
+    std::array<uint16_t, FACE_COUNT> discarded_ {};
+    std::array<uint64_t, MAX_SEATS> voids_ {};
+    Face top_face_ = 0;
+    Color top_color_ = Color::Red;
+};
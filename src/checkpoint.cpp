@@ -0,0 +1,369 @@
+#include "checkpoint.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include "card/composition.hpp"
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+/// The header at the start of a checkpoint log. It is followed by records of
+/// a `RecordHeader` and a payload, in native byte order.
+struct LogHeader {
+    static constexpr std::array<char, 8> MAGIC =
+        {'U', 'N', 'O', 'C', 'K', 'P', 'T', '\0'};
+    static constexpr uint32_t VERSION = 1;
+
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t reserved;
+};
+
+struct RecordHeader {
+    uint32_t size; // Of the payload
+    uint32_t checksum;
+};
+
+/// Returns the FNV-1a hash of the bytes.
+uint32_t checksum(std::span<const std::byte> bytes) {
+    uint32_t hash = 0x811C9DC5;
+    for (const auto byte : bytes) {
+        hash = (hash ^ static_cast<uint8_t>(byte)) * 0x01000193;
+    }
+    return hash;
+}
+
+std::span<const std::byte> as_bytes(const std::string& string) {
+    return std::as_bytes(std::span(string));
+}
+
+/// Writes the contents of the file through to the disk, so that they
+/// survive a power loss. Throws `std::runtime_error` on failure.
+void sync_file(const std::filesystem::path& path) {
+#ifdef _WIN32
+    const auto file = CreateFileW(
+        path.c_str(),
+        GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    const bool is_synced =
+        file != INVALID_HANDLE_VALUE && FlushFileBuffers(file);
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+    }
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    const bool is_synced = fd >= 0 && fsync(fd) == 0;
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+    if (!is_synced) {
+        throw std::runtime_error("failed to sync " + path.string());
+    }
+}
+
+/// Writes the entries of the directory through to the disk, so that a rename
+/// in it survives a power loss. NTFS journals renames by itself, so this only
+/// syncs on POSIX. Throws `std::runtime_error` on failure.
+void sync_directory([[maybe_unused]] const std::filesystem::path& path) {
+#ifndef _WIN32
+    sync_file(path.empty() ? "." : path);
+#endif
+}
+
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void put_cards(std::string& out, const std::vector<uint8_t>& cards) {
+    out.append(reinterpret_cast<const char*>(cards.data()), cards.size());
+}
+
+/// Writes a record with the payload, and returns its size.
+size_t put_record(std::ofstream& file, const std::string& payload) {
+    const RecordHeader record {
+        static_cast<uint32_t>(payload.size()),
+        checksum(as_bytes(payload))
+    };
+    file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    return sizeof(record) + payload.size();
+}
+
+/// Reads the fields of a payload in order.
+class Reader {
+  public:
+    explicit Reader(std::span<const std::byte> bytes) : rest_(bytes) {}
+
+    template <typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+        return value;
+    }
+
+    void get_cards(std::vector<uint8_t>& cards, size_t count) {
+        const auto bytes = take(count);
+        cards.resize(count);
+        std::memcpy(cards.data(), bytes.data(), count);
+        // Only the atlas cells of cards, including colored wild cards.
+        for (const auto index : cards) {
+            if (!is_card_atlas_index(index)) {
+                malformed();
+            }
+        }
+    }
+
+    bool empty() const noexcept {
+        return rest_.empty();
+    }
+
+    [[noreturn]] static void malformed() {
+        throw std::runtime_error("malformed checkpoint");
+    }
+
+  private:
+    std::span<const std::byte> take(size_t count) {
+        if (rest_.size() < count) {
+            malformed();
+        }
+        const auto bytes = rest_.first(count);
+        rest_ = rest_.subspan(count);
+        return bytes;
+    }
+
+    std::span<const std::byte> rest_;
+};
+
+/// Reads the latest payload of every unfinished table, up to the first
+/// record that is torn or corrupt.
+std::unordered_map<uint32_t, std::string> read_log(
+    const std::filesystem::path& path
+) {
+    std::unordered_map<uint32_t, std::string> latest;
+    std::error_code error;
+    if (!std::filesystem::exists(path, error)) {
+        return latest;
+    }
+    const MappedFile file(path);
+    auto bytes = file.bytes();
+    LogHeader header;
+    if (bytes.size() < sizeof(header)) {
+        throw std::runtime_error(path.string() + " is not a checkpoint log");
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != LogHeader::MAGIC) {
+        throw std::runtime_error(path.string() + " is not a checkpoint log");
+    }
+    if (header.version != LogHeader::VERSION) {
+        throw std::runtime_error(
+            path.string() + " has an unsupported checkpoint version"
+        );
+    }
+    bytes = bytes.subspan(sizeof(header));
+
+    while (bytes.size() >= sizeof(RecordHeader)) {
+        RecordHeader record;
+        std::memcpy(&record, bytes.data(), sizeof(record));
+        bytes = bytes.subspan(sizeof(record));
+        if (bytes.size() < record.size) {
+            break;
+        }
+        const auto payload = bytes.first(record.size);
+        bytes = bytes.subspan(record.size);
+        if (checksum(payload) != record.checksum) {
+            break;
+        }
+        const auto checkpoint = Checkpoint::decode(payload);
+        if (checkpoint.seat_count == 0) {
+            latest.erase(checkpoint.table);
+        } else {
+            latest[checkpoint.table].assign(
+                reinterpret_cast<const char*>(payload.data()),
+                payload.size()
+            );
+        }
+    }
+    return latest;
+}
+
+/// Decodes the latest payload of every table, ordered by table, so that a
+/// host resumes its tables in order.
+std::vector<Checkpoint> decode_by_table(
+    const std::unordered_map<uint32_t, std::string>& latest
+) {
+    std::vector<uint32_t> tables;
+    for (const auto& [table, payload] : latest) {
+        tables.push_back(table);
+    }
+    std::ranges::sort(tables);
+    std::vector<Checkpoint> checkpoints;
+    for (const auto table : tables) {
+        checkpoints.push_back(Checkpoint::decode(as_bytes(latest.at(table))));
+    }
+    return checkpoints;
+}
+} // namespace
+
+void Checkpoint::encode(std::string& out) const {
+    put(out, table);
+    put(out, static_cast<uint32_t>(seed));
+    put(out, shuffle_count);
+    put(out, seat_count);
+    put(out, current_seat);
+    put(out, direction);
+    put(out, pending_draw);
+    put(out, top_seat);
+    put(out, static_cast<uint16_t>(deck.size()));
+    put(out, static_cast<uint16_t>(discard_pile.size()));
+    for (uint8_t seat = 0; seat < seat_count; seat += 1) {
+        put(out, static_cast<uint16_t>(hands[seat].size()));
+    }
+    put_cards(out, deck);
+    put_cards(out, discard_pile);
+    for (uint8_t seat = 0; seat < seat_count; seat += 1) {
+        put_cards(out, hands[seat]);
+    }
+}
+
+Checkpoint Checkpoint::decode(std::span<const std::byte> payload) {
+    Reader reader(payload);
+    Checkpoint checkpoint;
+    checkpoint.table = reader.get<uint32_t>();
+    checkpoint.seed = reader.get<uint32_t>();
+    checkpoint.shuffle_count = reader.get<uint32_t>();
+    checkpoint.seat_count = reader.get<uint8_t>();
+    checkpoint.current_seat = reader.get<uint8_t>();
+    const auto direction = reader.get<int8_t>();
+    checkpoint.pending_draw = reader.get<uint8_t>();
+    checkpoint.top_seat = reader.get<uint8_t>();
+    // A finished table has no seats.
+    if ((checkpoint.seat_count != 0
+         && (checkpoint.seat_count < MIN_SEATS
+             || checkpoint.seat_count > MAX_SEATS
+             || checkpoint.current_seat >= checkpoint.seat_count
+             || (checkpoint.top_seat != Checkpoint::NO_SEAT
+                 && checkpoint.top_seat >= checkpoint.seat_count)
+             || checkpoint.shuffle_count == 0))
+        || (direction != 1 && direction != -1)) {
+        Reader::malformed();
+    }
+    checkpoint.direction = static_cast<Direction>(direction);
+
+    const auto deck_size = reader.get<uint16_t>();
+    if (deck_size > DECK_SIZE) {
+        Reader::malformed();
+    }
+    const auto discard_size = reader.get<uint16_t>();
+    std::array<uint16_t, MAX_SEATS> hand_sizes {};
+    for (uint8_t seat = 0; seat < checkpoint.seat_count; seat += 1) {
+        hand_sizes[seat] = reader.get<uint16_t>();
+    }
+    reader.get_cards(checkpoint.deck, deck_size);
+    reader.get_cards(checkpoint.discard_pile, discard_size);
+    for (uint8_t seat = 0; seat < checkpoint.seat_count; seat += 1) {
+        reader.get_cards(checkpoint.hands[seat], hand_sizes[seat]);
+    }
+    if (!reader.empty()
+        || (checkpoint.seat_count != 0 && checkpoint.discard_pile.empty())) {
+        Reader::malformed();
+    }
+    return checkpoint;
+}
+
+CheckpointLog::CheckpointLog(
+    std::filesystem::path path,
+    size_t compact_size
+) :
+    path_(std::move(path)),
+    compact_size_(compact_size),
+    latest_(read_log(path_)) {
+    compact();
+}
+
+void CheckpointLog::append(const Checkpoint& checkpoint) {
+    payload_.clear();
+    checkpoint.encode(payload_);
+    write_record(payload_);
+    latest_[checkpoint.table] = payload_;
+}
+
+void CheckpointLog::finish(uint32_t table) {
+    Checkpoint finished;
+    finished.table = table;
+    payload_.clear();
+    finished.encode(payload_);
+    write_record(payload_);
+    latest_.erase(table);
+}
+
+void CheckpointLog::flush() {
+    file_.flush();
+    if (!file_) {
+        throw std::runtime_error("failed to write " + path_.string());
+    }
+    if (appended_size_ >= compact_size_) {
+        compact();
+    }
+}
+
+std::vector<Checkpoint> CheckpointLog::checkpoints() const {
+    return decode_by_table(latest_);
+}
+
+std::vector<Checkpoint> CheckpointLog::load(
+    const std::filesystem::path& path
+) {
+    return decode_by_table(read_log(path));
+}
+
+void CheckpointLog::write_record(const std::string& payload) {
+    appended_size_ += put_record(file_, payload);
+}
+
+void CheckpointLog::compact() {
+    auto temporary = path_;
+    temporary += ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        LogHeader header {};
+        header.magic = LogHeader::MAGIC;
+        header.version = LogHeader::VERSION;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& [table, payload] : latest_) {
+            put_record(file, payload);
+        }
+        file.close();
+        if (!file) {
+            throw std::runtime_error("failed to write " + temporary.string());
+        }
+    }
+    // Synced before the rename, so that the path never holds a log whose
+    // contents are still on their way to the disk.
+    sync_file(temporary);
+    // The log is closed first, as Windows does not rename over open files.
+    file_.close();
+    std::filesystem::rename(temporary, path_);
+    sync_directory(path_.parent_path());
+    file_.open(path_, std::ios::binary | std::ios::app);
+    if (!file_) {
+        throw std::runtime_error("failed to open " + path_.string());
+    }
+    appended_size_ = 0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "seating.hpp"
+
+/// Everything needed to resume a game: the cards, by their atlas indices,
+/// whose turn it is, and where the random numbers of the deck stand.
+struct Checkpoint {
+    /// Stands for no seat in `top_seat`.
+    static constexpr uint8_t NO_SEAT = 0xFF;
+
+    uint32_t table = 0; // Tells apart the games of a host
+    unsigned int seed = 0;
+    uint32_t shuffle_count = 0; // Decks shuffled since seeding
+    uint8_t seat_count = 0;
+    uint8_t current_seat = 0;
+    Direction direction = Direction::Clockwise;
+    uint8_t pending_draw = 0;
+    uint8_t top_seat = NO_SEAT; // Played the top card, if a player did
+    std::vector<uint8_t> deck;         // Drawn from the back
+    std::vector<uint8_t> discard_pile; // From the bottom
+    std::array<std::vector<uint8_t>, MAX_SEATS> hands;
+
+    /// Appends the checkpoint as the payload of a record.
+    void encode(std::string& out) const;
+
+    /// Parses the payload of a record. Throws `std::runtime_error` if it is
+    /// malformed.
+    static Checkpoint decode(std::span<const std::byte> payload);
+};
+
+/// A file of checkpoints, to which a host appends the checkpoint of each of
+/// its tables after every turn.
+///
+/// Every record carries its size and a checksum, so that loading stops at a
+/// record torn by a crash. Once the file has grown by `compact_size`, the
+/// latest checkpoint of every unfinished table is written to a new file,
+/// synced to the disk, which then replaces the log by a rename: at any
+/// moment, even after a power loss, the path holds a complete log.
+class CheckpointLog {
+  public:
+    /// Opens the log at the path, keeping the games it holds, and starts a
+    /// fresh file with them. Throws `std::runtime_error` on failure.
+    explicit CheckpointLog(
+        std::filesystem::path path,
+        size_t compact_size = 1 << 20
+    );
+
+    /// Adds the checkpoint, replacing the last one of its table.
+    void append(const Checkpoint& checkpoint);
+
+    /// Marks the game of the table as over, so that it is not resumed.
+    void finish(uint32_t table);
+
+    /// Writes the records appended so far, which then survive a crash of the
+    /// process. They are not synced to the disk, as that would cost every
+    /// turn, so a power loss may take the records since the last compaction.
+    /// Throws `std::runtime_error` on failure.
+    void flush();
+
+    /// Returns the latest checkpoint of every unfinished table of the log, by
+    /// table. Unlike `load`, does not open the file again, which Windows
+    /// refuses while the log holds it.
+    std::vector<Checkpoint> checkpoints() const;
+
+    /// Returns the latest checkpoint of every unfinished table of the log at
+    /// the path, by table, or none if there is no such file.
+    static std::vector<Checkpoint> load(const std::filesystem::path& path);
+
+  private:
+    void write_record(const std::string& payload);
+    /// Replaces the file with the latest checkpoint of every table.
+    void compact();
+
+    std::filesystem::path path_;
+    size_t compact_size_;
+    std::ofstream file_;
+    size_t appended_size_ = 0; // Since the last compaction
+    /// Latest payload of every unfinished table, for compaction.
+    std::unordered_map<uint32_t, std::string> latest_;
+    std::string payload_; // Reused for every record
+};
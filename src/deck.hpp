@@ -2,84 +2,111 @@
 
 #include <SFML/Graphics.hpp>
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <random>
+#include <span>
 #include <vector>
 
-#include "card/action_card.hpp"
-#include "card/number_card.hpp"
-#include "card/wild_card.hpp"
+#include "card/composition.hpp"
+#include "card/create_card.hpp"
+#include "metrics.hpp"
+#include "sprite_batch.hpp"
 
 using std::optional;
 using std::unique_ptr;
 using std::vector;
 
 /// A deck of UNO cards.
+///
+/// The deck keeps the atlas indices of its cards, and creates a card as it
+/// is drawn, from the memory resource of its game, so that starting over is
+/// a copy of `UNSHUFFLED_DECK` and a shuffle.
 class Deck {
   public:
     /// Constructs a deck with all 108 UNO cards.
-    Deck(std::mt19937 rng) : rng_(rng) {
-        cards_.reserve(108);
-        initialize_cards();
+    Deck(
+        std::mt19937 rng,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) :
+        rng_(rng),
+        resource_(resource) {
+        refill();
     }
 
-    /// Draws a card from the deck.
-    optional<unique_ptr<Card>> draw() noexcept {
-        if (cards_.empty()) {
-            initialize_cards();
+    /// Restores a deck holding the cards of the atlas indices, drawn from
+    /// the back, whose generator had shuffled `shuffle_count` decks.
+    ///
+    /// The state of the generator is not saved but replayed: a shuffle draws
+    /// the same random numbers whatever the cards, so shuffling as many
+    /// decks of placeholders brings it back to where it was.
+    Deck(
+        std::mt19937 rng,
+        uint32_t shuffle_count,
+        std::span<const uint8_t> atlas_indices,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) :
+        rng_(rng),
+        resource_(resource),
+        shuffle_count_(shuffle_count) {
+        assert(atlas_indices.size() <= DECK_SIZE);
+        std::ranges::copy(atlas_indices, cards_.begin());
+        size_ = atlas_indices.size();
+        std::array<uint8_t, DECK_SIZE> placeholders {};
+        for (uint32_t i = 0; i < shuffle_count; i += 1) {
+            std::ranges::shuffle(placeholders, rng_);
         }
-        auto card = std::move(cards_.back());
-        cards_.pop_back();
-        return card;
     }
 
-    void render(sf::RenderTarget& render_target) const {
-        auto sprite = Card::get_back_sprite();
-        sprite.setPosition(
-            sf::Vector2f(render_target.getSize()) / 2.0f
-            - sf::Vector2f(170.0f, 0.0f)
-        );
-        render_target.draw(sprite);
+    /// Draws a card from the deck. Throws `std::bad_alloc` if the card cannot
+    /// be allocated.
+    optional<unique_ptr<Card>> draw() {
+        if (size_ == 0) {
+            GameMetrics::get().deck_refills.add();
+            refill();
+        }
+        size_ -= 1;
+        return create_card(cards_[size_], resource_);
     }
 
-  private:
-    void initialize_cards() {
-        // UNO includes 108 cards: 25 in each of four color suits (red, yellow,
-        // green, blue), each suit consisting of one zero, two each of 1
-        // through 9, and two each of the action cards "Skip", "Draw Two", and
-        // "Reverse". The deck also contains four "Wild" cards and four "Wild
-        // Draw Four".
-        for (const auto color :
-             {Color::Red, Color::Blue, Color::Green, Color::Yellow}) {
-            cards_.push_back(std::make_unique<NumberCard>(color, 0));
-            for (uint8_t number = 1; number <= 9; number++) {
-                cards_.push_back(std::make_unique<NumberCard>(color, number));
-                cards_.push_back(std::make_unique<NumberCard>(color, number));
-            }
-            for (const auto symbol :
-                 {ActionSymbol::DrawTwo,
-                  ActionSymbol::Reverse,
-                  ActionSymbol::Skip}) {
-                cards_.push_back(std::make_unique<ActionCard>(color, symbol));
-                cards_.push_back(std::make_unique<ActionCard>(color, symbol));
-            }
-        }
-        for (int i = 0; i < 4; i++) {
-            cards_.push_back(std::make_unique<WildCard>(WildSymbol::Wild));
-            cards_.push_back(
-                std::make_unique<WildCard>(WildSymbol::WildDrawFour)
-            );
-        }
-        shuffle();
+    /// Returns the number of cards left before the deck starts over.
+    size_t size() const noexcept {
+        return size_;
+    }
+
+    /// Returns the number of decks shuffled since the generator was seeded.
+    uint32_t shuffle_count() const noexcept {
+        return shuffle_count_;
     }
 
-    /// Shuffles the deck.
-    void shuffle() {
+    /// Copies the atlas indices of the cards left, drawn from the back.
+    void save(std::vector<uint8_t>& atlas_indices) const {
+        atlas_indices.assign(cards_.begin(), cards_.begin() + size_);
+    }
+
+    void render(SpriteBatch& batch, sf::Vector2f position) const {
+        auto sprite = Card::get_back_sprite();
+        sprite.setPosition(position);
+        batch.add(sprite);
+    }
+
+  private:
+    /// Starts over with all 108 cards, shuffled.
+    void refill() noexcept {
+        // The faces of the deck are the atlas indices of its cards.
+        cards_ = UNSHUFFLED_DECK;
+        size_ = DECK_SIZE;
         std::ranges::shuffle(cards_, rng_);
+        shuffle_count_ += 1;
     }
 
-    vector<unique_ptr<Card>> cards_;
+    std::array<uint8_t, DECK_SIZE> cards_; // Atlas indices
+    size_t size_ = 0;
     std::mt19937 rng_;
+    std::pmr::memory_resource* resource_; // Of the cards drawn
+    uint32_t shuffle_count_ = 0;
 };
@@ -1,47 +1,58 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cassert>
+#include <cstdint>
 #include <memory>
-#include <random>
+#include <memory_resource>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include "card/card.hpp"
 #include "config.hpp"
+#include "rules.hpp"
+#include "sprite_batch.hpp"
 
 using std::unique_ptr;
 using std::vector;
 
 class DiscardPile {
   public:
+    explicit DiscardPile(
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) :
+        cards_(resource) {}
+
     void push_back(unique_ptr<Card> card) {
         cards_.push_back(std::move(card));
     }
 
-    const std::vector<unique_ptr<Card>>& cards() const {
+    const std::pmr::vector<unique_ptr<Card>>& cards() const {
         return cards_;
     }
 
-    void render(sf::RenderTarget& render_target) const {
-        static auto seed = std::random_device {}();
-        std::mt19937 gen(seed);
-        std::uniform_real_distribution<float> distrib(-1.0f, 1.0f);
-        for (size_t i = 0; i < cards_.size(); i += 1) {
-            auto sprite = cards_[i]->sprite();
-            sprite.setPosition(sf::Vector2f(render_target.getSize()) / 2.0f);
+    /// Renders the cards of a pile, given by their atlas indices from the
+    /// bottom, around the position.
+    static void render(
+        SpriteBatch& batch,
+        sf::Vector2f position,
+        std::span<const uint8_t> atlas_indices
+    ) {
+        for (size_t i = 0; i < atlas_indices.size(); i += 1) {
+            auto sprite = Card::get_sprite(atlas_indices[i]);
 
-            // Generate random offset to make cards look naturally stacked.
-            const sf::Vector2f offset(distrib(gen) * 10.f, distrib(gen) * 10.f);
-            sprite.setPosition(
-                sf::Vector2f(render_target.getSize()) / 2.0f + offset
-            );
-            sprite.setRotation(sf::degrees(distrib(gen) * 5.f));
+            // Offset each card a little to make them look naturally stacked.
+            const sf::Vector2f offset(jitter(i, 0) * 10.f, jitter(i, 1) * 10.f);
+            sprite.setPosition(position + offset);
+            sprite.setRotation(sf::degrees(jitter(i, 2) * 5.f));
 
             // Dim the cards below the top card.
-            if (i < cards_.size() - 1) {
+            if (i < atlas_indices.size() - 1) {
                 sprite.setColor(DIM_COLOR);
             }
 
-            render_target.draw(sprite);
+            batch.add(sprite);
         }
     }
 
@@ -49,6 +60,52 @@ class DiscardPile {
         return *cards_.back().get();
     }
 
+    /// Returns whether the card can be played on top of the pile. Only games
+    /// that stack draw penalties leave one pending, so their engine passes
+    /// `stacking` as its rules do, and the others skip the check.
+    template <bool stacking = true>
+    bool accepts(const Card& card) const {
+        if constexpr (stacking) {
+            if (pending_draw_ > 0) {
+                return can_stack_on(card, peek_top());
+            }
+        } else {
+            assert(pending_draw_ == 0);
+        }
+        return card.can_play_on(peek_top());
+    }
+
+    /// Returns the number of cards the next player must draw unless they
+    /// stack another draw card.
+    uint8_t pending_draw() const noexcept {
+        return pending_draw_;
+    }
+
+    void add_pending_draw(uint8_t count) noexcept {
+        pending_draw_ += count;
+    }
+
+    /// Clears the pending draw penalty and returns it.
+    uint8_t take_pending_draw() noexcept {
+        return std::exchange(pending_draw_, 0);
+    }
+
   private:
-    vector<unique_ptr<Card>> cards_;
+    /// Returns a number in [-1, 1] that looks random but only depends on
+    /// the position of a card in the pile and on which of its coordinates it
+    /// moves, so that a card stays put from one frame, run or platform to the
+    /// next.
+    static float jitter(size_t index, uint64_t coordinate) noexcept {
+        // SplitMix64 finalizer.
+        auto bits = (uint64_t {index} * 3 + coordinate + 1)
+            * 0x9e37'79b9'7f4a'7c15;
+        bits = (bits ^ (bits >> 30)) * 0xbf58'476d'1ce4'e5b9;
+        bits = (bits ^ (bits >> 27)) * 0x94d0'49bb'1331'11eb;
+        bits ^= bits >> 31;
+        // The top 24 bits fit a float exactly.
+        return static_cast<float>(bits >> 40) / float {1 << 23} - 1.f;
+    }
+
+    std::pmr::vector<unique_ptr<Card>> cards_;
+    uint8_t pending_draw_ = 0;
 };
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+#include "memory_stats.hpp"
+
+/// The memory of one game: its cards, hands and discard pile.
+///
+/// Blocks are taken in turn from a buffer held by the arena, and then from
+/// chunks of the default resource once a long game has used it up. Nothing
+/// is freed before the game ends, when all of it is released at once: a
+/// game draws a few hundred cards of a few dozen bytes each, which is less
+/// than sorting out which blocks are free would cost. No other game touches
+/// the memory, so tables played on different threads do not contend for the
+/// global heap.
+///
+/// Not thread-safe: a game is played on one thread at a time.
+class GameArena {
+  public:
+    /// Size of the buffer, which fits a typical game.
+    static constexpr size_t BUFFER_SIZE = 16 * 1024;
+
+    GameArena() : blocks_(buffer_.data(), buffer_.size()) {}
+
+    /// Records the peak memory of the game, if memory is counted.
+    ~GameArena() {
+        if constexpr (ARE_MEMORY_STATS_ENABLED) {
+            MemoryStats::end_game(memory());
+        }
+    }
+
+    GameArena(const GameArena&) = delete;
+    GameArena& operator=(const GameArena&) = delete;
+
+    /// Returns the memory for a subsystem of the game, which is counted for
+    /// it if memory is counted.
+    std::pmr::memory_resource* resource(Subsystem subsystem) noexcept {
+        if constexpr (ARE_MEMORY_STATS_ENABLED) {
+            for (auto& tracked : tracked_) {
+                if (tracked.subsystem() == subsystem) {
+                    return &tracked;
+                }
+            }
+        }
+        return &blocks_;
+    }
+
+    /// Returns the peak memory of the game so far. Only counted with memory
+    /// stats enabled.
+    GameMemory memory() const noexcept {
+        GameMemory memory;
+        for (const auto& tracked : tracked_) {
+            memory.peak_bytes[static_cast<size_t>(tracked.subsystem())] =
+                tracked.counter().usage().peak_bytes;
+        }
+        return memory;
+    }
+
+  private:
+    alignas(std::max_align_t) std::array<std::byte, BUFFER_SIZE> buffer_;
+    std::pmr::monotonic_buffer_resource blocks_;
+    std::array<TrackedResource, 3> tracked_ {
+        TrackedResource(Subsystem::Deck, &blocks_),
+        TrackedResource(Subsystem::DiscardPile, &blocks_),
+        TrackedResource(Subsystem::Hands, &blocks_),
+    };
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+#include "card/card.hpp"
+
+/// Why a player draws a card.
+enum class DrawReason : uint8_t {
+    NoPlayableCard,
+    Penalty, // Draw Two, Wild Draw Four or a stacked penalty
+};
+
+/// Receives the events of a game as the engine plays it.
+class GameListener {
+  public:
+    virtual ~GameListener() = default;
+
+    /// Called when a card is turned up from the deck to start the discard
+    /// pile.
+    virtual void on_card_turned_up(const Card&) {}
+
+    /// Called after the player at the seat draws a card from the deck. The
+    /// card is given to the table's listener and to the player who drew it,
+    /// and is null for the other players.
+    virtual void on_card_drawn(uint8_t, DrawReason, const Card*) {}
+
+    /// Called when the player at the seat plays a card, before its effects
+    /// are applied. A wild card already has its color.
+    virtual void on_card_played(uint8_t, const Card&) {}
+
+    /// Called after the players at the two seats exchange hands.
+    virtual void on_hands_swapped(uint8_t, uint8_t) {}
+
+    /// Called when the deck runs out, before a new deck is shuffled.
+    virtual void on_deck_refilled() {}
+
+    /// Returns a listener that ignores every event.
+    static GameListener& none() {
+        static GameListener instance;
+        return instance;
+    }
+};
@@ -3,77 +3,76 @@
 #include <SFML/Graphics.hpp>
 #include <memory>
 
-#include "SFML/Window/Mouse.hpp"
 #include "app_state.hpp"
+#include "input.hpp"
+#include "label.hpp"
+#include "sprite_batch.hpp"
 #include "text_button.hpp"
 
 /// A game over screen that displays the result and offers options to continue
 class GameOverMenu {
   public:
-    GameOverMenu(const sf::RenderTarget& render_target, bool player_won) :
-        font_("assets/fonts/arial.ttf") {
+    GameOverMenu(const sf::RenderTarget& render_target, bool player_won) {
         constexpr unsigned int title_font_size = 72;
         constexpr unsigned int option_font_size = 48;
 
         // Create title text
-        title_text_ = std::make_unique<sf::Text>(
-            font_,
+        title_text_ = std::make_unique<Label>(
             player_won ? "You Win!" : "You Lose! Try again",
             title_font_size
         );
-        title_text_->setFillColor(sf::Color::Yellow);
-        title_text_->setOrigin(title_text_->getLocalBounds().getCenter());
+        title_text_->set_color(sf::Color::Yellow);
+        title_text_->setOrigin(title_text_->local_bounds().getCenter());
         title_text_->setPosition(
             sf::Vector2f(render_target.getSize().x / 2.0f, 150.f)
         );
 
         // Create menu button
         menu_button_ = std::make_unique<TextButton>(
-            sf::Text(font_, "Back to Menu", option_font_size),
+            Label("Back to Menu", option_font_size),
             sf::Color::White,
             sf::Color(50, 150, 50)
         );
 
         // Create exit button
         exit_button_ = std::make_unique<TextButton>(
-            sf::Text(font_, "Exit", option_font_size),
+            Label("Exit", option_font_size),
             sf::Color::White,
             sf::Color(150, 50, 50)
         );
     }
 
-    AppState update(sf::RenderWindow& window) {
-        if (menu_button_->is_left_clicked(window)) {
-            while (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left))
-                ;
-            return AppState::StartMenu;
-        } else if (exit_button_->is_left_clicked(window)) {
-            while (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left))
-                ;
-            return AppState::Exit;
+    AppState update(const Input& input) {
+        switch (buttons_.clicked(input).value_or(Option::None)) {
+            case Option::Menu:
+                return AppState::StartMenu;
+            case Option::Exit:
+                return AppState::Exit;
+            case Option::None:
+                break;
         }
         return AppState::GameOver;
     }
 
-    void render(sf::RenderWindow& window) {
-        const auto window_size = sf::Vector2f(window.getSize());
+    void render(SpriteBatch& batch, const Input& input, sf::Vector2f size) {
+        title_text_->setPosition(sf::Vector2f(size.x / 2.0f, 150.f));
+        menu_button_->set_position(size / 2.0f - sf::Vector2f(0.f, 60.f));
+        exit_button_->set_position(size / 2.0f + sf::Vector2f(0.f, 60.f));
 
-        title_text_->setPosition(sf::Vector2f(window_size.x / 2.0f, 150.f));
-        menu_button_->set_position(
-            window_size / 2.0f - sf::Vector2f(0.f, 60.f)
-        );
-        exit_button_->set_position(
-            window_size / 2.0f + sf::Vector2f(0.f, 60.f)
-        );
+        title_text_->render(batch);
+        menu_button_->render(batch, input.mouse_position());
+        exit_button_->render(batch, input.mouse_position());
 
-        window.draw(*title_text_);
-        menu_button_->render(window);
-        exit_button_->render(window);
+        buttons_.clear();
+        buttons_.add(menu_button_->bounds(), Option::Menu);
+        buttons_.add(exit_button_->bounds(), Option::Exit);
     }
 
   private:
-    std::unique_ptr<sf::Text> title_text_;
+    enum class Option { None, Menu, Exit };
+
+    std::unique_ptr<Label> title_text_;
     std::unique_ptr<TextButton> menu_button_;
     std::unique_ptr<TextButton> exit_button_;
-    sf::Font font_;
+    HitRegions<Option> buttons_; // Buttons as last rendered
 };
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <optional>
+#include <vector>
+
+/// The mouse input of a frame, gathered from the window's events.
+///
+/// Positions are mapped to world coordinates once per frame, after the events
+/// are handled, so widgets only compare them against their bounds.
+class Input {
+  public:
+    /// Forgets the click of the previous frame.
+    void begin_frame() noexcept {
+        left_click_pixel_.reset();
+        left_click_.reset();
+    }
+
+    /// Records the mouse events among the window's events.
+    void handle(const sf::Event& event) {
+        if (const auto moved = event.getIf<sf::Event::MouseMoved>()) {
+            mouse_pixel_ = moved->position;
+        } else if (const auto pressed =
+                       event.getIf<sf::Event::MouseButtonPressed>()) {
+            mouse_pixel_ = pressed->position;
+            // Keep the first click, should several arrive within a frame.
+            if (pressed->button == sf::Mouse::Button::Left
+                && !left_click_pixel_.has_value()) {
+                left_click_pixel_ = pressed->position;
+            }
+        }
+    }
+
+    /// Maps the positions of the frame to the coordinates of the target's
+    /// view.
+    void map(const sf::RenderTarget& target) {
+        mouse_position_ = target.mapPixelToCoords(mouse_pixel_);
+        if (left_click_pixel_.has_value()) {
+            left_click_ = target.mapPixelToCoords(*left_click_pixel_);
+        }
+    }
+
+    sf::Vector2f mouse_position() const noexcept {
+        return mouse_position_;
+    }
+
+    /// Returns where the left button was pressed during the frame, if it was.
+    std::optional<sf::Vector2f> left_click() const noexcept {
+        return left_click_;
+    }
+
+  private:
+    sf::Vector2i mouse_pixel_;
+    std::optional<sf::Vector2i> left_click_pixel_;
+
+    sf::Vector2f mouse_position_;
+    std::optional<sf::Vector2f> left_click_;
+};
+
+/// Regions of the screen that take clicks, stacked in the order they are
+/// added. Rebuilt every frame as widgets are drawn.
+template <typename Id>
+class HitRegions {
+  public:
+    /// Removes every region, keeping the memory for the next frame.
+    void clear() noexcept {
+        regions_.clear();
+    }
+
+    /// Adds a region on top of the others.
+    void add(sf::FloatRect bounds, Id id) {
+        regions_.push_back({bounds, id});
+    }
+
+    /// Returns the topmost region containing the point.
+    std::optional<Id> hit(sf::Vector2f point) const {
+        for (auto it = regions_.rbegin(); it != regions_.rend(); ++it) {
+            if (it->bounds.contains(point)) {
+                return it->id;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// Returns the topmost region under the left click of the frame.
+    std::optional<Id> clicked(const Input& input) const {
+        if (const auto click = input.left_click()) {
+            return hit(*click);
+        }
+        return std::nullopt;
+    }
+
+  private:
+    struct Region {
+        sf::FloatRect bounds;
+        Id id;
+    };
+
+    std::vector<Region> regions_;
+};
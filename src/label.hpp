@@ -0,0 +1,88 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "atlas.hpp"
+#include "memory_stats.hpp"
+#include "sprite_batch.hpp"
+
+/// A text drawn from the glyphs in the atlas, in place of `sf::Text`, so
+/// that it goes into the same batch as the rest of the frame. Laid out like
+/// `sf::Text`, with the first baseline one font size below the origin.
+class Label: public sf::Transformable {
+  public:
+    Label(std::string_view text, unsigned int size) : size_(size) {
+        set_text(text);
+    }
+
+    /// Copies the text, into the memory of the previous one if it fits.
+    void set_text(std::string_view text) {
+        const MemoryScope scope(Subsystem::Text);
+        text_.assign(text);
+    }
+
+    void set_color(sf::Color color) noexcept {
+        color_ = color;
+    }
+
+    /// Returns the rectangle covered by the glyphs, before the transform.
+    sf::FloatRect local_bounds() const {
+        constexpr auto INF = std::numeric_limits<float>::infinity();
+        sf::Vector2f min(INF, INF);
+        sf::Vector2f max(-INF, -INF);
+        for_each_glyph([&](const AtlasGlyph&, const sf::FloatRect& rect) {
+            const auto end = rect.position + rect.size;
+            min = {std::min(min.x, rect.position.x),
+                   std::min(min.y, rect.position.y)};
+            max = {std::max(max.x, end.x), std::max(max.y, end.y)};
+        });
+        if (min.x > max.x) {
+            return {}; // No visible glyph
+        }
+        return sf::FloatRect(min, max - min);
+    }
+
+    /// Returns the rectangle covered by the glyphs on the target.
+    sf::FloatRect global_bounds() const {
+        return getTransform().transformRect(local_bounds());
+    }
+
+    void render(SpriteBatch& batch) const {
+        for_each_glyph([&](const AtlasGlyph& glyph, const sf::FloatRect& rect) {
+            batch.add_quad(getTransform(), rect, glyph.texture_rect, color_);
+        });
+    }
+
+  private:
+    /// Calls `f` with every visible glyph and where it goes, before the
+    /// transform.
+    template <typename F>
+    void for_each_glyph(F&& f) const {
+        const auto& atlas = Atlas::get();
+        sf::Vector2f pen(0.0f, static_cast<float>(size_));
+        for (const auto character : text_) {
+            if (character == '\n') {
+                pen = {0.0f, pen.y + atlas.line_spacing(size_)};
+                continue;
+            }
+            const auto& glyph = atlas.glyph(
+                size_,
+                static_cast<char32_t>(static_cast<unsigned char>(character))
+            );
+            if (glyph.bounds.size.x > 0.0f && glyph.bounds.size.y > 0.0f) {
+                f(glyph,
+                  sf::FloatRect(pen + glyph.bounds.position, glyph.bounds.size)
+                );
+            }
+            pen.x += glyph.advance;
+        }
+    }
+
+    std::string text_;
+    unsigned int size_;
+    sf::Color color_ = sf::Color::White;
+};
@@ -1,14 +1,29 @@
 #include <SFML/Graphics.hpp>
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
 #include <memory>
+#include <string>
 #include <thread>
 
 #include "app_state.hpp"
+#include "atlas.hpp"
+#include "audio.hpp"
+#include "checkpoint.hpp"
 #include "game_over_menu.hpp"
-#include "player/player.hpp"
+#include "input.hpp"
+#include "memory_stats.hpp"
+#include "metrics.hpp"
+#include "player/linear_evaluator.hpp"
+#include "presenter.hpp"
+#include "spectator_hud.hpp"
+#include "sprite_batch.hpp"
 #include "start_menu.hpp"
 #include "state.hpp"
+#include "table_grid.hpp"
 
 void on_enter(AppState, sf::RenderWindow&);
 void on_exit(AppState, sf::RenderWindow&);
@@ -18,24 +33,66 @@ std::unique_ptr<StartMenu> start_menu;
 
 std::unique_ptr<GameOverMenu> game_over_menu;
 
+std::unique_ptr<SpectatorHud> spectator_hud;
+
+Presenter presenter;
 std::unique_ptr<State> state;
 std::unique_ptr<std::jthread> gameplay_thread;
 
+/// Checkpoints of the game of the local player, which is resumed after a
+/// crash. Spectated games are not saved.
+const std::filesystem::path CHECKPOINT_PATH = "uno.checkpoint";
+std::unique_ptr<CheckpointLog> checkpoint_log;
+
+/// Number of tables on the wall.
+constexpr size_t WALL_TABLE_COUNT = 64;
+std::unique_ptr<TableGrid> table_grid;
+
+SpriteBatch sprite_batch;
+
 std::atomic<AppState> app_state = AppState::StartMenu;
 std::atomic<AppState> previous_app_state = AppState::None;
 bool is_player_won;
+uint8_t seat_count = 4;
+GameMode game_mode = GameMode::Play;
+bool is_spectating = false;
+size_t game_count = 0; // Games watched in a row
 
 int main() {
+    // Load the AI weights, and start decoding the sounds, before the first
+    // game.
+    LinearEvaluator::get();
+    Audio::get();
+
+    // Exports the metrics every ten seconds, and on exit, if asked to.
+    std::unique_ptr<MetricsExporter> metrics_exporter;
+    if (const auto* metrics_path = std::getenv("UNO_METRICS")) {
+        metrics_exporter = std::make_unique<MetricsExporter>(metrics_path);
+    }
+
     auto window = sf::RenderWindow(sf::VideoMode({1536u, 864u}), "UNO");
     window.setFramerateLimit(144);
 
-    sf::Texture background_texture("assets/images/background.png");
-    sf::Sprite background_sprite(background_texture);
+    // Every frame is drawn from the atlas, which needs the window's context.
+    const auto& atlas = Atlas::get();
+    sf::Sprite background_sprite(
+        atlas.texture(),
+        atlas.region(AtlasRegion::Background)
+    );
     background_sprite.setOrigin(background_sprite.getLocalBounds().getCenter());
     resize_background(background_sprite, window);
 
+    Input input;
+    sf::Clock frame_clock;
     while (window.isOpen()) {
+        const auto frame_duration = frame_clock.restart();
+        const auto frame_time = frame_duration.asSeconds();
+        GameMetrics::get().frame_time.record(
+            std::chrono::microseconds(frame_duration.asMicroseconds())
+        );
+        input.begin_frame();
         while (const auto event = window.pollEvent()) {
+            input.handle(*event);
             if (event->is<sf::Event::Closed>()) {
                 app_state = AppState::Exit;
             }
@@ -48,30 +105,63 @@ int main() {
                 resize_background(background_sprite, window);
             }
         }
+        input.map(window);
 
-        const auto previous_state =
-            previous_app_state.exchange(app_state.load());
-        if (previous_state != app_state) {
+        // The gameplay thread may change the state at any time, so this frame
+        // goes on with the state as of now.
+        const auto current_state = app_state.load();
+        const auto previous_state = previous_app_state.exchange(current_state);
+        if (previous_state != current_state) {
             on_exit(previous_state, window);
-            on_enter(app_state, window);
+            on_enter(current_state, window);
         }
 
-        window.clear();
-        window.draw(background_sprite);
+        const auto window_size = sf::Vector2f(window.getSize());
+        sprite_batch.clear();
+        sprite_batch.add(background_sprite);
 
-        switch (app_state) {
+        switch (current_state) {
             case AppState::StartMenu:
-                app_state = start_menu->update(window);
-                start_menu->render(window);
+                app_state = start_menu->update(input);
+                start_menu->render(sprite_batch, input, window_size);
                 break;
 
             case AppState::Gameplay:
-                state->render(window);
+                if (is_spectating) {
+                    const auto next_state = spectator_hud->update(input);
+                    if (next_state != AppState::Gameplay) {
+                        app_state = next_state;
+                    }
+                }
+
+                if (table_grid) {
+                    table_grid->update(frame_time, spectator_hud->time_scale());
+                    table_grid->render(sprite_batch, window_size);
+                    game_count = table_grid->game_count();
+                } else {
+                    if (is_spectating) {
+                        presenter.set_time_scale(spectator_hud->time_scale());
+                    }
+                    presenter.update(frame_time);
+                    state->handle_input(input);
+                    state->render(
+                        sprite_batch,
+                        presenter.animator(),
+                        window_size
+                    );
+                }
+
+                if (is_spectating) {
+                    spectator_hud->render(sprite_batch, input, game_count);
+                }
+                break;
+
+            case AppState::NextGame:
                 break;
 
             case AppState::GameOver:
-                app_state = game_over_menu->update(window);
-                game_over_menu->render(window);
+                app_state = game_over_menu->update(input);
+                game_over_menu->render(sprite_batch, input, window_size);
                 break;
 
             case AppState::Exit:
@@ -83,9 +173,19 @@ int main() {
                 break;
         }
 
+        window.clear();
+        sprite_batch.draw(window);
         window.display();
+        if constexpr (ARE_MEMORY_STATS_ENABLED) {
+            MemoryStats::end_frame();
+        }
     }
 
+    if constexpr (ARE_MEMORY_STATS_ENABLED) {
+        std::string report;
+        MemoryStats::write(report);
+        std::fputs(report.c_str(), stderr);
+    }
     return 0;
 }
 
@@ -98,14 +198,67 @@ void on_enter(AppState app_state_entered, sf::RenderWindow& window) {
         case AppState::Gameplay:
             assert(state == nullptr);
             assert(gameplay_thread == nullptr);
-            state = std::make_unique<State>(window);
+            if (game_mode == GameMode::Wall) {
+                table_grid =
+                    std::make_unique<TableGrid>(WALL_TABLE_COUNT, seat_count);
+                break;
+            }
+            presenter.reset(
+                is_spectating ? Presenter::NO_LOCAL_SEAT : State::LOCAL_SEAT
+            );
+            presenter.set_time_scale(
+                is_spectating ? spectator_hud->time_scale() : 1.0f
+            );
+            if (is_spectating) {
+                state = std::make_unique<State>(seat_count, presenter, true);
+            } else {
+                if (checkpoint_log == nullptr) {
+                    checkpoint_log =
+                        std::make_unique<CheckpointLog>(CHECKPOINT_PATH);
+                }
+                // Carry on with a game that was cut short, if any. Taken from
+                // the open log, as Windows will not map the file it holds.
+                const auto saved = checkpoint_log->checkpoints();
+                state = saved.empty()
+                    ? std::make_unique<State>(seat_count, presenter)
+                    : std::make_unique<State>(saved.front(), presenter);
+            }
+            game_count += 1;
             gameplay_thread =
                 std::make_unique<std::jthread>([&](std::stop_token stop_token) {
+                    Checkpoint checkpoint;
                     while (!stop_token.stop_requested()) {
-                        app_state = state->update();
+                        // Let the turn play out on screen before the next.
+                        auto next_app_state = state->update();
+                        if (!is_spectating) {
+                            if (next_app_state == AppState::GameOver) {
+                                checkpoint_log->finish(checkpoint.table);
+                            } else {
+                                state->checkpoint(checkpoint);
+                                checkpoint_log->append(checkpoint);
+                            }
+                            checkpoint_log->flush();
+                        }
+                        presenter.wait_until_presented();
+                        // Spectators watch one game after another.
+                        if (is_spectating
+                            && next_app_state == AppState::GameOver) {
+                            next_app_state = AppState::NextGame;
+                        }
+                        // Leave alone a state the render thread changed.
+                        auto expected = AppState::Gameplay;
+                        app_state.compare_exchange_strong(
+                            expected,
+                            next_app_state
+                        );
                     }
                 });
             break;
+        case AppState::NextGame: {
+            auto expected = AppState::NextGame;
+            app_state.compare_exchange_strong(expected, AppState::Gameplay);
+            break;
+        }
         case AppState::GameOver:
             assert(game_over_menu == nullptr);
             game_over_menu =
@@ -119,11 +272,24 @@ void on_enter(AppState app_state_entered, sf::RenderWindow& window) {
 void on_exit(AppState app_state_exited, sf::RenderWindow& window) {
     switch (app_state_exited) {
         case AppState::StartMenu:
+            seat_count = start_menu->seat_count();
+            game_mode = start_menu->game_mode();
+            is_spectating = game_mode != GameMode::Play;
             start_menu.reset();
+            game_count = 0;
+            if (is_spectating && spectator_hud == nullptr) {
+                spectator_hud = std::make_unique<SpectatorHud>();
+            }
             break;
         case AppState::Gameplay:
-            is_player_won = state->position() == Position::South;
+            if (table_grid) {
+                table_grid.reset();
+                break;
+            }
+            // Stop the gameplay thread before reading the final state.
+            presenter.cancel();
             gameplay_thread.reset();
+            is_player_won = state->current_seat() == State::LOCAL_SEAT;
             state.reset();
             break;
         case AppState::GameOver:
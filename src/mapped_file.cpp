@@ -0,0 +1,91 @@
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    file_ = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file_ == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("failed to open " + path.string());
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size)) {
+        CloseHandle(file_);
+        throw std::runtime_error("failed to stat " + path.string());
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_ == 0) {
+        return;
+    }
+    mapping_ =
+        CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ == nullptr) {
+        CloseHandle(file_);
+        throw std::runtime_error("failed to map " + path.string());
+    }
+    data_ = static_cast<const std::byte*>(
+        MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0)
+    );
+    if (data_ == nullptr) {
+        CloseHandle(mapping_);
+        CloseHandle(file_);
+        throw std::runtime_error("failed to map " + path.string());
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    CloseHandle(file_);
+}
+#else
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("failed to open " + path.string());
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        throw std::runtime_error("failed to stat " + path.string());
+    }
+    size_ = static_cast<size_t>(status.st_size);
+    if (size_ > 0) {
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("failed to map " + path.string());
+        }
+        data_ = static_cast<const std::byte*>(data);
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        munmap(const_cast<std::byte*>(data_), size_);
+    }
+}
+#endif
@@ -0,0 +1,184 @@
+#include "memory_stats.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+constexpr std::array<std::string_view, SUBSYSTEM_COUNT> SUBSYSTEM_NAMES = {
+    "other",
+    "deck",
+    "discard pile",
+    "hands",
+    "sprites",
+    "audio",
+    "text",
+};
+
+// Zero-initialized before any constructor runs, so that allocations of
+// static constructors are counted too.
+std::array<MemoryCounter, SUBSYSTEM_COUNT> subsystem_counters;
+MemoryCounter heap_counter;
+
+std::atomic<uint64_t> largest_frame_bytes = 0;
+std::atomic<uint64_t> game_count = 0;
+std::atomic<uint64_t> largest_game_bytes = 0;
+
+thread_local Subsystem current_subsystem = Subsystem::Other;
+
+void store_max(std::atomic<uint64_t>& max, uint64_t value) noexcept {
+    auto current = max.load(std::memory_order_relaxed);
+    while (current < value
+           && !max.compare_exchange_weak(
+               current,
+               value,
+               std::memory_order_relaxed
+           )) {
+    }
+}
+} // namespace
+
+std::string_view to_string(Subsystem subsystem) noexcept {
+    return SUBSYSTEM_NAMES[static_cast<size_t>(subsystem)];
+}
+
+MemoryCounter& MemoryStats::of(Subsystem subsystem) noexcept {
+    return subsystem_counters[static_cast<size_t>(subsystem)];
+}
+
+const MemoryCounter& MemoryStats::heap() noexcept {
+    return heap_counter;
+}
+
+uint64_t MemoryStats::end_frame() noexcept {
+    const auto peak = heap_counter.reset_peak();
+    store_max(largest_frame_bytes, peak);
+    return peak;
+}
+
+void MemoryStats::end_game(const GameMemory& game) noexcept {
+    game_count.fetch_add(1, std::memory_order_relaxed);
+    store_max(largest_game_bytes, game.total());
+}
+
+void MemoryStats::write(std::string& out) {
+    for (size_t i = 0; i <= SUBSYSTEM_COUNT; i += 1) {
+        const auto is_heap = i == SUBSYSTEM_COUNT;
+        const auto usage =
+            is_heap ? heap_counter.usage() : subsystem_counters[i].usage();
+        out += is_heap ? std::string_view("heap") : SUBSYSTEM_NAMES[i];
+        out += ": " + std::to_string(usage.allocation_count)
+            + " allocations, " + std::to_string(usage.live_bytes)
+            + " bytes live, " + std::to_string(usage.peak_bytes)
+            + " bytes at peak\n";
+    }
+    out += "largest frame: "
+        + std::to_string(largest_frame_bytes.load(std::memory_order_relaxed))
+        + " bytes\n";
+    out += "largest of "
+        + std::to_string(game_count.load(std::memory_order_relaxed))
+        + " games: "
+        + std::to_string(largest_game_bytes.load(std::memory_order_relaxed))
+        + " bytes\n";
+}
+
+Subsystem MemoryStats::current() noexcept {
+    return current_subsystem;
+}
+
+Subsystem MemoryStats::exchange_current(Subsystem subsystem) noexcept {
+    const auto previous = current_subsystem;
+    current_subsystem = subsystem;
+    return previous;
+}
+
+#ifdef UNO_MEMORY_STATS
+
+namespace {
+/// Put before every block from `operator new`, for `operator delete` to know
+/// what to count off. Keeps the block aligned as `malloc` does.
+struct alignas(std::max_align_t) BlockHeader {
+    size_t size;
+    Subsystem subsystem;
+};
+
+void* allocate(size_t size) noexcept {
+    auto* const header =
+        static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + size));
+    if (header == nullptr) {
+        return nullptr;
+    }
+    header->size = size;
+    header->subsystem = current_subsystem;
+    MemoryStats::of(header->subsystem).allocated(size);
+    heap_counter.allocated(size);
+    return header + 1;
+}
+
+void deallocate(void* block) noexcept {
+    if (block == nullptr) {
+        return;
+    }
+    auto* const header = static_cast<BlockHeader*>(block) - 1;
+    MemoryStats::of(header->subsystem).freed(header->size);
+    heap_counter.freed(header->size);
+    std::free(header);
+}
+
+void* allocate_or_throw(size_t size) {
+    while (true) {
+        if (auto* const block = allocate(size)) {
+            return block;
+        }
+        const auto handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+} // namespace
+
+// Over-aligned allocations keep the default operators, which pair with
+// each other.
+
+void* operator new(size_t size) {
+    return allocate_or_throw(size);
+}
+
+void* operator new[](size_t size) {
+    return allocate_or_throw(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* block) noexcept {
+    deallocate(block);
+}
+
+void operator delete[](void* block) noexcept {
+    deallocate(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+    deallocate(block);
+}
+
+void operator delete[](void* block, size_t) noexcept {
+    deallocate(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+    deallocate(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+    deallocate(block);
+}
+
+#endif
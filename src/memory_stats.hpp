@@ -0,0 +1,196 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+/// Whether allocations are counted, which a build turns on with
+/// `xmake f --memory_stats=y`. Counting replaces the global `operator new`,
+/// and costs every allocation of the program a few atomic adds.
+#ifdef UNO_MEMORY_STATS
+constexpr bool ARE_MEMORY_STATS_ENABLED = true;
+#else
+constexpr bool ARE_MEMORY_STATS_ENABLED = false;
+#endif
+
+/// A part of the game that memory is counted for.
+enum class Subsystem : uint8_t {
+    Other,
+    Deck,        // Cards, from when they are drawn to the end of the game
+    DiscardPile, // The pile itself, not the cards on it
+    Hands,       // The hands themselves, not the cards in them
+    Sprites,     // Images of the atlas and sprites of the cards
+    Audio,       // Decoded sound buffers
+    Text,        // Strings of labels
+};
+
+constexpr size_t SUBSYSTEM_COUNT = 7;
+
+std::string_view to_string(Subsystem subsystem) noexcept;
+
+/// The memory of a subsystem at one point in time.
+struct MemoryUsage {
+    uint64_t allocation_count = 0;
+    uint64_t live_bytes = 0;
+    uint64_t peak_bytes = 0; // Since the peak was last reset
+};
+
+/// Counts allocations and the bytes they hold. Safe to update from any
+/// thread.
+class MemoryCounter {
+  public:
+    void allocated(size_t bytes) noexcept {
+        allocation_count_.fetch_add(1, std::memory_order_relaxed);
+        const auto live =
+            live_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        auto peak = peak_bytes_.load(std::memory_order_relaxed);
+        while (peak < live
+               && !peak_bytes_.compare_exchange_weak(
+                   peak,
+                   live,
+                   std::memory_order_relaxed
+               )) {
+        }
+    }
+
+    void freed(size_t bytes) noexcept {
+        live_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    MemoryUsage usage() const noexcept {
+        return {
+            allocation_count_.load(std::memory_order_relaxed),
+            live_bytes_.load(std::memory_order_relaxed),
+            peak_bytes_.load(std::memory_order_relaxed),
+        };
+    }
+
+    /// Starts the peak over from the bytes live now, and returns the peak
+    /// before.
+    uint64_t reset_peak() noexcept {
+        return peak_bytes_.exchange(
+            live_bytes_.load(std::memory_order_relaxed),
+            std::memory_order_relaxed
+        );
+    }
+
+  private:
+    std::atomic<uint64_t> allocation_count_ = 0;
+    std::atomic<uint64_t> live_bytes_ = 0;
+    std::atomic<uint64_t> peak_bytes_ = 0;
+};
+
+/// The peak memory of a game, by subsystem.
+struct GameMemory {
+    std::array<uint64_t, SUBSYSTEM_COUNT> peak_bytes {};
+
+    uint64_t total() const noexcept {
+        uint64_t total = 0;
+        for (const auto bytes : peak_bytes) {
+            total += bytes;
+        }
+        return total;
+    }
+};
+
+/// The memory of the program, by subsystem.
+///
+/// With memory stats enabled, every `operator new` is counted for the
+/// subsystem of the innermost `MemoryScope` of its thread, or for `Other`,
+/// and every `operator delete` for the subsystem it was counted for.
+/// Memory handed out by a `TrackedResource` is counted for its subsystem as
+/// well, so the bytes of a game arena count both for the subsystems that
+/// use them and for whoever allocated the arena.
+class MemoryStats {
+  public:
+    static MemoryCounter& of(Subsystem subsystem) noexcept;
+
+    /// Returns the memory allocated with `operator new` by every subsystem
+    /// together, in which an arena counts once.
+    static const MemoryCounter& heap() noexcept;
+
+    /// Ends a frame, and returns the most heap bytes that were live during
+    /// it.
+    static uint64_t end_frame() noexcept;
+
+    /// Records the peak memory of a game that ended.
+    static void end_game(const GameMemory& game) noexcept;
+
+    /// Writes the memory of every subsystem, of the largest frame and of
+    /// the largest game, a line each.
+    static void write(std::string& out);
+
+    /// Returns the subsystem that allocations of the calling thread are
+    /// counted for.
+    static Subsystem current() noexcept;
+
+  private:
+    friend class MemoryScope;
+
+    static Subsystem exchange_current(Subsystem subsystem) noexcept;
+};
+
+/// Counts the allocations of the calling thread for a subsystem while it
+/// lives. Scopes nest, and the innermost one wins.
+class MemoryScope {
+  public:
+    explicit MemoryScope(Subsystem subsystem) noexcept :
+        previous_(MemoryStats::exchange_current(subsystem)) {}
+
+    ~MemoryScope() {
+        MemoryStats::exchange_current(previous_);
+    }
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+  private:
+    Subsystem previous_;
+};
+
+/// Hands out the memory of another resource, counting it for a subsystem,
+/// both among the memory of the program and on its own.
+class TrackedResource: public std::pmr::memory_resource {
+  public:
+    TrackedResource(
+        Subsystem subsystem,
+        std::pmr::memory_resource* upstream
+    ) noexcept :
+        subsystem_(subsystem),
+        upstream_(upstream) {}
+
+    Subsystem subsystem() const noexcept {
+        return subsystem_;
+    }
+
+    /// Returns the memory handed out through this resource alone.
+    const MemoryCounter& counter() const noexcept {
+        return counter_;
+    }
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        auto* const block = upstream_->allocate(bytes, alignment);
+        counter_.allocated(bytes);
+        MemoryStats::of(subsystem_).allocated(bytes);
+        return block;
+    }
+
+    void do_deallocate(void* block, size_t bytes, size_t alignment) override {
+        counter_.freed(bytes);
+        MemoryStats::of(subsystem_).freed(bytes);
+        upstream_->deallocate(block, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    Subsystem subsystem_;
+    std::pmr::memory_resource* upstream_;
+    MemoryCounter counter_;
+};
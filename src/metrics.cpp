@@ -0,0 +1,226 @@
+#include "metrics.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+/// Powers of two of a nanosecond at which histograms are cut for export,
+/// from about a quarter of a microsecond to 17 seconds.
+constexpr size_t FIRST_EXPORTED_POWER = 8;
+constexpr size_t LAST_EXPORTED_POWER = 34;
+
+void append_number(std::string& out, double value) {
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void append_number(std::string& out, uint64_t value) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void append_header(
+    std::string& out,
+    const std::string& name,
+    const std::string& help,
+    const char* type
+) {
+    out += "# HELP " + name + ' ' + help + '\n';
+    out += "# TYPE " + name + ' ' + type + '\n';
+}
+} // namespace
+
+uint64_t HistogramSnapshot::quantile(double q) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+    const auto rank = std::max<uint64_t>(
+        static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * count)),
+        1
+    );
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket += 1) {
+        seen += counts[bucket];
+        if (seen >= rank) {
+            return lower_bound(bucket);
+        }
+    }
+    return lower_bound(BUCKET_COUNT - 1);
+}
+
+HistogramSnapshot Histogram::snapshot() const noexcept {
+    HistogramSnapshot snapshot;
+    for (const auto& shard : shards_) {
+        for (size_t i = 0; i < HistogramSnapshot::BUCKET_COUNT; i += 1) {
+            const auto count = shard.counts[i].load(std::memory_order_relaxed);
+            snapshot.counts[i] += count;
+            snapshot.count += count;
+        }
+        snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+Metrics& Metrics::get() {
+    static Metrics instance;
+    return instance;
+}
+
+Counter& Metrics::counter(std::string_view name, std::string_view help) {
+    const std::lock_guard lock(mutex_);
+    auto& entry = find_or_add(name, help);
+    if (entry.histogram != nullptr) {
+        throw std::runtime_error(entry.name + " is a histogram");
+    }
+    if (entry.counter == nullptr) {
+        entry.counter = std::make_unique<Counter>();
+    }
+    return *entry.counter;
+}
+
+Histogram& Metrics::histogram(std::string_view name, std::string_view help) {
+    const std::lock_guard lock(mutex_);
+    auto& entry = find_or_add(name, help);
+    if (entry.counter != nullptr) {
+        throw std::runtime_error(entry.name + " is a counter");
+    }
+    if (entry.histogram == nullptr) {
+        entry.histogram = std::make_unique<Histogram>();
+    }
+    return *entry.histogram;
+}
+
+void Metrics::write(std::string& out) const {
+    const std::lock_guard lock(mutex_);
+    for (const auto& entry : entries_) {
+        if (entry.counter != nullptr) {
+            append_header(out, entry.name, entry.help, "counter");
+            out += entry.name + ' ';
+            append_number(out, entry.counter->value());
+            out += '\n';
+            continue;
+        }
+
+        // Buckets are cumulative, and cut at powers of two, which fall on
+        // the edges of the buckets of the histogram.
+        const auto snapshot = entry.histogram->snapshot();
+        append_header(out, entry.name, entry.help, "histogram");
+        uint64_t seen = 0;
+        size_t bucket = 0;
+        for (auto power = FIRST_EXPORTED_POWER; power <= LAST_EXPORTED_POWER;
+             power += 1) {
+            const auto edge = uint64_t {1} << power;
+            for (; HistogramSnapshot::lower_bound(bucket) < edge; bucket += 1) {
+                seen += snapshot.counts[bucket];
+            }
+            out += entry.name + "_bucket{le=\"";
+            append_number(out, static_cast<double>(edge) * 1e-9);
+            out += "\"} ";
+            append_number(out, seen);
+            out += '\n';
+        }
+        out += entry.name + "_bucket{le=\"+Inf\"} ";
+        append_number(out, snapshot.count);
+        out += '\n' + entry.name + "_sum ";
+        append_number(out, static_cast<double>(snapshot.sum) * 1e-9);
+        out += '\n' + entry.name + "_count ";
+        append_number(out, snapshot.count);
+        out += '\n';
+    }
+}
+
+void Metrics::dump(const std::filesystem::path& path) const {
+    std::string text;
+    write(text);
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        file.close();
+        if (!file) {
+            throw std::runtime_error("failed to write " + temporary.string());
+        }
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+Metrics::Entry& Metrics::find_or_add(
+    std::string_view name,
+    std::string_view help
+) {
+    for (auto& entry : entries_) {
+        if (entry.name == name) {
+            return entry;
+        }
+    }
+    return entries_.emplace_back(
+        Entry {std::string(name), std::string(help), nullptr, nullptr}
+    );
+}
+
+const GameMetrics& GameMetrics::get() {
+    auto& metrics = Metrics::get();
+    static const GameMetrics instance {
+        .turns = metrics.counter("uno_turns_total", "Turns played."),
+        .draws = metrics.counter("uno_draws_total", "Cards drawn in play."),
+        .deck_refills = metrics.counter(
+            "uno_deck_refills_total",
+            "Times the deck ran out and was shuffled anew."
+        ),
+        .turn_time = metrics.histogram(
+            "uno_turn_seconds",
+            "Time to play a turn, including the decision of the player."
+        ),
+        .decision_time = metrics.histogram(
+            "uno_ai_decision_seconds",
+            "Time an AI player takes to choose a card."
+        ),
+        .frame_time = metrics.histogram(
+            "uno_frame_seconds",
+            "Time between frames of the window."
+        ),
+    };
+    return instance;
+}
+
+MetricsExporter::MetricsExporter(
+    std::filesystem::path path,
+    std::chrono::milliseconds period
+) :
+    path_(std::move(path)) {
+    thread_ = std::jthread([this, period](std::stop_token stop_token) {
+        std::mutex mutex;
+        std::condition_variable_any wake_up;
+        std::unique_lock lock(mutex);
+        while (!stop_token.stop_requested()) {
+            // Wakes up early only to stop.
+            wake_up.wait_for(lock, stop_token, period, [] { return false; });
+            if (!stop_token.stop_requested()) {
+                dump();
+            }
+        }
+    });
+}
+
+MetricsExporter::~MetricsExporter() {
+    thread_.request_stop();
+    thread_.join();
+    dump();
+}
+
+void MetricsExporter::dump() const noexcept {
+    try {
+        Metrics::get().dump(path_);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "metrics: %s\n", error.what());
+    }
+}
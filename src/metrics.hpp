@@ -0,0 +1,264 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// Number of copies of every metric. Threads are spread over the copies, so
+/// that threads counting at once rarely write to the same cache line.
+constexpr size_t METRIC_SHARD_COUNT = 16;
+
+/// Whether metrics are recorded. Counting and timing cost a few nanoseconds,
+/// and can be turned off to compare.
+inline std::atomic<bool> are_metrics_enabled = true;
+
+/// Returns the copy of the metrics the calling thread updates. Threads take
+/// the copies in turn as they first count.
+inline size_t metric_shard() noexcept {
+    static std::atomic<size_t> next_shard = 0;
+    thread_local const size_t shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARD_COUNT;
+    return shard;
+}
+
+/// A count that only goes up, such as the number of turns played.
+class Counter {
+  public:
+    void add(uint64_t amount = 1) noexcept {
+        if (!are_metrics_enabled.load(std::memory_order_relaxed)) {
+            return;
+        }
+        shards_[metric_shard()].value.fetch_add(
+            amount,
+            std::memory_order_relaxed
+        );
+    }
+
+    /// Returns the sum of the counts of every thread.
+    uint64_t value() const noexcept {
+        uint64_t total = 0;
+        for (const auto& shard : shards_) {
+            total += shard.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+  private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value = 0;
+    };
+
+    std::array<Shard, METRIC_SHARD_COUNT> shards_;
+};
+
+/// The counts of a histogram at one point in time.
+struct HistogramSnapshot {
+    static constexpr size_t SUB_BUCKET_BITS = 3;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t {1} << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (64 - 2) * SUB_BUCKET_COUNT;
+
+    std::array<uint64_t, BUCKET_COUNT> counts {};
+    uint64_t count = 0;
+    uint64_t sum = 0;
+
+    /// Returns the bucket of a value. Values below `SUB_BUCKET_COUNT` have a
+    /// bucket each, and every power of two above is split into
+    /// `SUB_BUCKET_COUNT` buckets, so a bucket is never wider than an eighth
+    /// of its values.
+    static constexpr size_t bucket_of(uint64_t value) noexcept {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        const auto exponent = static_cast<size_t>(std::bit_width(value)) - 1;
+        const auto shift = exponent - SUB_BUCKET_BITS;
+        const auto sub_bucket = (value >> shift) & (SUB_BUCKET_COUNT - 1);
+        return (shift + 1) * SUB_BUCKET_COUNT + static_cast<size_t>(sub_bucket);
+    }
+
+    /// Returns the smallest value of a bucket.
+    static constexpr uint64_t lower_bound(size_t bucket) noexcept {
+        if (bucket < SUB_BUCKET_COUNT) {
+            return bucket;
+        }
+        const auto shift = bucket / SUB_BUCKET_COUNT - 1;
+        const auto sub_bucket = bucket % SUB_BUCKET_COUNT;
+        return (SUB_BUCKET_COUNT + sub_bucket) << shift;
+    }
+
+    /// Returns the value below which the fraction `q` of the values fall, to
+    /// within the width of a bucket, or 0 if there are none.
+    uint64_t quantile(double q) const noexcept;
+};
+
+/// A distribution of durations, in nanoseconds, such as how long turns take.
+///
+/// Buckets are log-linear, like those of HdrHistogram, so durations from a
+/// few nanoseconds to hours are kept to within 12.5% in a fixed 4 KiB per
+/// thread, and recording is an increment without a lock.
+class Histogram {
+  public:
+    /// One in this many timings is taken by a `ScopedTimer`, as reading the
+    /// clock costs more than the rest of a turn's metrics together.
+    static constexpr uint64_t SAMPLE_PERIOD = 8;
+
+    /// Records a duration, counted `weight` times.
+    void record(uint64_t nanoseconds, uint64_t weight = 1) noexcept {
+        if (!are_metrics_enabled.load(std::memory_order_relaxed)) {
+            return;
+        }
+        auto& shard = shards_[metric_shard()];
+        shard.counts[HistogramSnapshot::bucket_of(nanoseconds)].fetch_add(
+            weight,
+            std::memory_order_relaxed
+        );
+        shard.sum.fetch_add(nanoseconds * weight, std::memory_order_relaxed);
+    }
+
+    void record(std::chrono::nanoseconds duration, uint64_t weight = 1)
+        noexcept {
+        record(
+            static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0)),
+            weight
+        );
+    }
+
+    /// Returns true for one call in `SAMPLE_PERIOD` of each thread, or so:
+    /// threads sharing a copy of the histogram may lose a tick to each
+    /// other.
+    bool should_sample() noexcept {
+        auto& ticks = shards_[metric_shard()].ticks;
+        const auto tick = ticks.load(std::memory_order_relaxed);
+        ticks.store(tick + 1, std::memory_order_relaxed);
+        return tick % SAMPLE_PERIOD == 0;
+    }
+
+    /// Adds up the counts of every thread.
+    HistogramSnapshot snapshot() const noexcept;
+
+  private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, HistogramSnapshot::BUCKET_COUNT>
+            counts {};
+        std::atomic<uint64_t> sum = 0;
+        std::atomic<uint64_t> ticks = 0; // Calls to `should_sample`
+    };
+
+    std::array<Shard, METRIC_SHARD_COUNT> shards_;
+};
+
+/// The named metrics of the process, exported in the text format of
+/// Prometheus.
+class Metrics {
+  public:
+    static Metrics& get();
+
+    /// Returns the counter of the name, registering it the first time.
+    /// Metrics live as long as the process. Throws `std::runtime_error` if
+    /// the name belongs to a histogram.
+    Counter& counter(std::string_view name, std::string_view help);
+
+    /// Returns the histogram of the name, registering it the first time. It
+    /// is exported in seconds. Throws `std::runtime_error` if the name
+    /// belongs to a counter.
+    Histogram& histogram(std::string_view name, std::string_view help);
+
+    /// Appends every metric in the text format of Prometheus.
+    void write(std::string& out) const;
+
+    /// Writes every metric to the file, which is replaced at once so that a
+    /// scraper never reads half of it. Throws `std::runtime_error` on
+    /// failure.
+    void dump(const std::filesystem::path& path) const;
+
+  private:
+    Metrics() = default;
+
+    struct Entry {
+        std::string name;
+        std::string help;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    Entry& find_or_add(std::string_view name, std::string_view help);
+
+    mutable std::mutex mutex_; // Guards the entries, not the metrics
+    std::vector<Entry> entries_;
+};
+
+/// The metrics of the game engine.
+struct GameMetrics {
+    Counter& turns;
+    Counter& draws;
+    Counter& deck_refills;
+    Histogram& turn_time;
+    Histogram& decision_time; // Of AI players only
+    Histogram& frame_time;
+
+    static const GameMetrics& get();
+};
+
+/// Records the time from its construction to its destruction, for one in
+/// `Histogram::SAMPLE_PERIOD` of the timers of a histogram, each standing for
+/// the whole period. The clock is not read by the others, nor while metrics
+/// are disabled.
+class ScopedTimer {
+  public:
+    explicit ScopedTimer(Histogram& histogram) noexcept {
+        if (are_metrics_enabled.load(std::memory_order_relaxed)
+            && histogram.should_sample()) {
+            histogram_ = &histogram;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedTimer() {
+        if (histogram_ != nullptr) {
+            histogram_->record(
+                std::chrono::steady_clock::now() - start_,
+                Histogram::SAMPLE_PERIOD
+            );
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  private:
+    Histogram* histogram_ = nullptr;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/// Dumps the metrics to a file every period, and once more when destroyed.
+class MetricsExporter {
+  public:
+    static constexpr std::chrono::seconds DEFAULT_PERIOD {10};
+
+    explicit MetricsExporter(
+        std::filesystem::path path,
+        std::chrono::milliseconds period = DEFAULT_PERIOD
+    );
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+  private:
+    /// Dumps the metrics, reporting rather than throwing a failure, which
+    /// should not stop the game.
+    void dump() const noexcept;
+
+    std::filesystem::path path_;
+    std::jthread thread_;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "card/face.hpp"
+#include "seating.hpp"
+
+/// What the current player knows when choosing a card, in a fixed-width
+/// layout.
+struct Observation {
+    std::array<uint8_t, FACE_COUNT> hand; // Copies of each face in the hand
+    /// Hand sizes by seat, starting with the player and following the
+    /// direction of play. Sizes over 255 are saturated.
+    std::array<uint8_t, MAX_SEATS> hand_sizes;
+    uint64_t legal_faces; // Bit set of the faces the player may play
+    Face top_face;
+    Color top_color; // Color to play on, chosen for a wild top card
+    Direction direction;
+    uint8_t seat;
+    uint8_t seat_count;
+    uint8_t pending_draw; // Penalty to stack on or take
+};
+
+/// A card played by a player, and the color chosen for it if it is wild.
+struct Action {
+    Face face;
+    Color color;
+};
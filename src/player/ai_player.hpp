@@ -1,25 +1,20 @@
 #pragma once
 
+#include <array>
 #include <cassert>
 #include <cstdint>
-#include <thread>
 
+#include "../card_tracker.hpp"
 #include "player.hpp"
 
-constexpr std::chrono::duration THINKING_DELAY =
-    std::chrono::milliseconds(1500);
-
 /// An AI-controlled player for the UNO game.
 class AiPlayer: public Player {
   public:
-    AiPlayer(Position position, Deck& deck) : Player(position, deck) {}
-
     unique_ptr<Card> play_card(const DiscardPile& discard_pile) override {
         for (auto it = cards_.begin(); it != cards_.end(); ++it) {
-            if ((*it)->can_play_on(discard_pile.peek_top())) {
+            if (discard_pile.accepts(**it)) {
                 auto card = std::move(*it);
                 cards_.erase(it);
-                std::this_thread::sleep_for(THINKING_DELAY);
                 return card;
             }
         }
@@ -27,6 +22,45 @@ class AiPlayer: public Player {
         return nullptr;
     }
 
+    unique_ptr<Card> jump_in(const DiscardPile& discard_pile) override {
+        const auto& top = discard_pile.peek_top();
+        for (auto it = cards_.begin(); it != cards_.end(); ++it) {
+            if ((*it)->atlas_index() == top.atlas_index()
+                && discard_pile.accepts(**it)) {
+                auto card = std::move(*it);
+                cards_.erase(it);
+                return card;
+            }
+        }
+        return nullptr;
+    }
+
+    void on_card_turned_up(const Card& card) override {
+        tracker_.on_card_turned_up(card);
+    }
+
+    void on_card_drawn(uint8_t seat, DrawReason reason, const Card* card)
+        override {
+        tracker_.on_card_drawn(seat, reason, card);
+    }
+
+    void on_card_played(uint8_t seat, const Card& card) override {
+        tracker_.on_card_played(seat, card);
+    }
+
+    void on_hands_swapped(uint8_t seat, uint8_t other_seat) override {
+        tracker_.on_hands_swapped(seat, other_seat);
+    }
+
+    void on_deck_refilled() override {
+        tracker_.on_deck_refilled();
+    }
+
+    /// Returns what the player knows about the cards in play.
+    const CardTracker& tracker() const noexcept {
+        return tracker_;
+    }
+
     Color select_wild_color() const override {
         // Choose the most common color in the player's hand.
         std::array<uint8_t, 4> color_counts = {0, 0, 0, 0};
@@ -43,4 +77,7 @@ class AiPlayer: public Player {
             std::max_element(color_counts.begin(), color_counts.end())
         ));
     }
+
+  protected:
+    CardTracker tracker_;
 };
@@ -0,0 +1,429 @@
+#include "endgame_solver.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <span>
+#include <utility>
+
+namespace {
+/// Appends the bytes of a value to an FNV-1a hash.
+template <typename T>
+void hash_bytes(uint64_t& hash, const T& value) {
+    const auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    for (size_t i = 0; i < sizeof(T); i += 1) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3;
+    }
+}
+
+uint64_t legal_faces(uint64_t hand_faces, Face top_face, Color top_color) {
+    return hand_faces & playable_faces(top_color, face_rank(top_face));
+}
+
+/// Calls `visit` with every move playing one of the faces: once for a
+/// colored face, and once per color for a wild face.
+template <typename F>
+void for_each_action(uint64_t faces, F&& visit) {
+    for (; faces != 0; faces &= faces - 1) {
+        const auto face = static_cast<Face>(std::countr_zero(faces));
+        if (!is_wild(face)) {
+            if (!visit(Action {face, face_color(face)})) {
+                return;
+            }
+            continue;
+        }
+        for (uint8_t color = 0; color < COLOR_COUNT; color += 1) {
+            if (!visit(Action {face, static_cast<Color>(color)})) {
+                return;
+            }
+        }
+    }
+}
+} // namespace
+
+bool EndgameSolver::applies(const Observation& observation) const {
+    const auto sizes = std::span(observation.hand_sizes)
+                           .first(observation.seat_count);
+    return limits_.card_threshold > 0 && observation.pending_draw == 0
+        && std::accumulate(sizes.begin(), sizes.end(), 0u)
+        <= limits_.card_threshold;
+}
+
+std::optional<Action> EndgameSolver::solve(
+    const Observation& observation,
+    const std::array<uint8_t, FACE_COUNT>& unseen
+) {
+    assert(observation.legal_faces != 0);
+    assert(!memo_.empty()); // A disabled solver has no memo
+    const auto total = std::accumulate(unseen.begin(), unseen.end(), 0u);
+    for (Face face = 0; face < FACE_COUNT; face += 1) {
+        face_odds_[face] = total > 0
+            ? static_cast<float>(unseen[face]) / total
+            : static_cast<float>(FACE_COPIES[face]) / 108;
+    }
+
+    Position root {};
+    root.hand = observation.hand;
+    for (Face face = 0; face < FACE_COUNT; face += 1) {
+        if (root.hand[face] > 0) {
+            root.hand_faces |= uint64_t {1} << face;
+        }
+    }
+    root.sizes = observation.hand_sizes;
+    root.top_face = observation.top_face;
+    root.top_color = observation.top_color;
+    root.direction = 1;
+    root.seat_count = observation.seat_count;
+
+    search_ += 1;
+    if (search_ == 0) {
+        // The numbers wrapped around: forget the searches that used them.
+        for (auto& entry : memo_) {
+            entry.search = 0;
+        }
+        search_ = 1;
+    }
+    node_count_ = 0;
+    aborted_ = false;
+    deadline_ = std::chrono::steady_clock::now() + limits_.time_budget;
+
+    std::optional<Action> best_action;
+    for (uint8_t depth = 1; depth <= limits_.max_depth; depth += 1) {
+        Action action {};
+        float best = -1.0f;
+        bool is_exact = false;
+        bool is_solved = true; // Whether every move was valued exactly
+        const auto legal = legal_faces(
+            root.hand_faces,
+            root.top_face,
+            root.top_color
+        );
+        for_each_action(legal, [&](Action candidate) {
+            const auto estimate_count = estimate_count_;
+            auto child = root;
+            float value;
+            if (!play(child, candidate, value)) {
+                value = search(child, depth - 1, std::max(best, 0.0f), 1.0f);
+            }
+            const auto is_value_exact = estimate_count_ == estimate_count;
+            is_solved = is_solved && is_value_exact;
+            if (value > best) {
+                action = candidate;
+                best = value;
+                is_exact = is_value_exact;
+            }
+            // No move can beat a certain win.
+            return !aborted_ && !(is_exact && best >= 1.0f);
+        });
+        if (aborted_) {
+            break;
+        }
+
+        best_action = action;
+        value_ = best;
+        is_exact_ = is_exact;
+        if (is_solved || (is_exact && best >= 1.0f)) {
+            break;
+        }
+    }
+    return best_action;
+}
+
+float EndgameSolver::search(
+    const Position& position,
+    uint8_t depth,
+    float alpha,
+    float beta
+) {
+    if (out_of_budget()) {
+        return 0.0f;
+    }
+    node_count_ += 1;
+    if (depth == 0) {
+        return estimate(position);
+    }
+
+    const auto key = hash(position);
+    auto& entry = memo_[key & (MEMO_SIZE - 1)];
+    if (entry.search == search_ && entry.key == key) {
+        if (entry.depth >= depth) {
+            if (entry.depth != SOLVED) {
+                // The value rests on estimates made deeper in the tree.
+                estimate_count_ += 1;
+            }
+            if (entry.bound == Bound::Exact
+                || (entry.bound == Bound::Lower && entry.value >= beta)
+                || (entry.bound == Bound::Upper && entry.value <= alpha)) {
+                return entry.value;
+            }
+        }
+    }
+
+    const auto estimate_count = estimate_count_;
+    const auto value = position.turn == 0
+        ? search_player(position, depth, alpha, beta)
+        : search_opponent(position, depth);
+    if (aborted_) {
+        return value;
+    }
+
+    // Replaces whichever position the search below stored in the entry.
+    entry = {key, value, depth, Bound::Exact, search_};
+    if (value <= alpha) {
+        entry.bound = Bound::Upper;
+    } else if (value >= beta) {
+        entry.bound = Bound::Lower;
+    }
+    if (estimate_count_ == estimate_count) {
+        entry.depth = SOLVED;
+    }
+    return value;
+}
+
+float EndgameSolver::search_player(
+    const Position& position,
+    uint8_t depth,
+    float alpha,
+    float beta
+) {
+    const auto legal = legal_faces(
+        position.hand_faces,
+        position.top_face,
+        position.top_color
+    );
+    if (position.penalty > 0 || legal == 0) {
+        return search_draw(position, depth, alpha, beta);
+    }
+
+    float best = 0.0f;
+    for_each_action(legal, [&](Action action) {
+        auto child = position;
+        float value;
+        if (!play(child, action, value)) {
+            value = search(child, depth - 1, std::max(alpha, best), beta);
+        }
+        best = std::max(best, value);
+        return best < beta && !aborted_;
+    });
+    return best;
+}
+
+float EndgameSolver::search_draw(
+    const Position& position,
+    uint8_t depth,
+    float alpha,
+    float beta
+) {
+    if (position.sizes[0] >= limits_.hand_cap) {
+        return estimate(position);
+    }
+
+    // Star1 pruning: stop once the remaining odds cannot bring the expected
+    // value back inside the window.
+    float sum = 0.0f;
+    float remaining = 1.0f;
+    for (Face face = 0; face < FACE_COUNT; face += 1) {
+        const auto odds = face_odds_[face];
+        if (odds == 0.0f) {
+            continue;
+        }
+        auto child = position;
+        child.hand[face] += 1;
+        child.hand_faces |= uint64_t {1} << face;
+        child.sizes[0] += 1;
+        if (child.penalty > 0) {
+            child.penalty -= 1;
+            if (child.penalty == 0) {
+                child.turn = next_seat(child);
+            }
+        }
+
+        remaining -= odds;
+        const auto child_alpha = (alpha - sum - remaining) / odds;
+        const auto child_beta = (beta - sum) / odds;
+        const auto value = search(
+            child,
+            depth - 1,
+            std::max(child_alpha, 0.0f),
+            std::min(child_beta, 1.0f)
+        );
+        sum += odds * value;
+        if (aborted_ || sum >= beta) {
+            return sum;
+        }
+        if (sum + remaining <= alpha) {
+            return sum + std::max(remaining, 0.0f);
+        }
+    }
+    return sum;
+}
+
+float EndgameSolver::search_opponent(const Position& position, uint8_t depth) {
+    const auto seat = position.turn;
+    const auto hand_size = position.sizes[seat];
+    const auto playable = playable_faces(
+        position.top_color,
+        face_rank(position.top_face)
+    );
+
+    float playable_odds = 0.0f;
+    for (auto faces = playable; faces != 0; faces &= faces - 1) {
+        playable_odds += face_odds_[std::countr_zero(faces)];
+    }
+    if (playable_odds == 0.0f) {
+        // The opponent draws a card they cannot play and passes.
+        auto child = position;
+        child.sizes[seat] = std::min(hand_size + 1, 255);
+        child.turn = next_seat(child);
+        return search(child, depth - 1, 0.0f, 1.0f);
+    }
+
+    // Without a playable card, the opponent draws until they draw one.
+    const auto misses = static_cast<uint8_t>(std::min(
+        std::round((1.0f - playable_odds) / playable_odds),
+        static_cast<float>(limits_.hand_cap)
+    ));
+
+    // Values of each face played from the hand, and after drawing, with the
+    // color worst for the player.
+    std::array<std::pair<float, Face>, FACE_COUNT> held;
+    size_t held_count = 0;
+    float drawn_value = 0.0f;
+    for (auto faces = playable; faces != 0; faces &= faces - 1) {
+        const auto face = static_cast<Face>(std::countr_zero(faces));
+        if (face_odds_[face] == 0.0f) {
+            continue;
+        }
+        float from_hand = 1.0f;
+        float from_draw = 1.0f;
+        for_each_action(uint64_t {1} << face, [&](Action action) {
+            for (const auto drawn : {uint8_t {0}, misses}) {
+                auto child = position;
+                child.sizes[seat] = std::min(hand_size + drawn, 255);
+                float value;
+                if (!play(child, action, value)) {
+                    value = search(child, depth - 1, 0.0f, 1.0f);
+                }
+                auto& best = drawn == 0 ? from_hand : from_draw;
+                best = std::min(best, value);
+            }
+            return !aborted_;
+        });
+        held[held_count++] = {from_hand, face};
+        drawn_value += face_odds_[face] / playable_odds * from_draw;
+    }
+
+    // The opponent plays the worst face for the player among the faces they
+    // hold, each of their cards being one of the faces with its odds.
+    std::sort(held.begin(), held.begin() + held_count);
+    float value = 0.0f;
+    float worse_odds = 0.0f;
+    for (size_t i = 0; i < held_count; i += 1) {
+        const auto& [face_value, face] = held[i];
+        const auto odds = face_odds_[face];
+        value += face_value
+            * (std::pow(1.0f - worse_odds, hand_size)
+               - std::pow(1.0f - worse_odds - odds, hand_size));
+        worse_odds += odds;
+    }
+    return value + std::pow(1.0f - playable_odds, hand_size) * drawn_value;
+}
+
+bool EndgameSolver::play(Position& position, Action action, float& value) {
+    const auto seat = position.turn;
+    const auto face = action.face;
+    if (seat == 0) {
+        position.hand[face] -= 1;
+        if (position.hand[face] == 0) {
+            position.hand_faces &= ~(uint64_t {1} << face);
+        }
+    }
+    position.sizes[seat] -= 1;
+    if (position.sizes[seat] == 0) {
+        value = seat == 0 ? 1.0f : 0.0f;
+        return true;
+    }
+
+    position.top_face = face;
+    position.top_color = action.color;
+    const auto penalize = [&](uint8_t count) {
+        position.turn = next_seat(position);
+        if (position.turn == 0) {
+            // The player draws before the turn passes them by.
+            position.penalty = count;
+        } else {
+            auto& size = position.sizes[position.turn];
+            size = static_cast<uint8_t>(std::min(size + count, 255));
+        }
+    };
+    switch (face_rank(face)) {
+        case WILD_RANK:
+            if (face == WILD_DRAW_FOUR_FACE) {
+                penalize(4);
+            }
+            break;
+        case DRAW_TWO_RANK:
+            penalize(2);
+            break;
+        case REVERSE_RANK:
+            position.direction = static_cast<int8_t>(-position.direction);
+            // With two players, a Reverse acts like a Skip.
+            if (position.seat_count == 2) {
+                position.turn = next_seat(position);
+            }
+            break;
+        case SKIP_RANK:
+            position.turn = next_seat(position);
+            break;
+    }
+    if (position.penalty == 0) {
+        position.turn = next_seat(position);
+    }
+    return false;
+}
+
+uint8_t EndgameSolver::next_seat(const Position& position) {
+    int seat = position.turn + position.direction;
+    seat += seat < 0 ? position.seat_count : 0;
+    seat -= seat >= position.seat_count ? position.seat_count : 0;
+    return static_cast<uint8_t>(seat);
+}
+
+float EndgameSolver::estimate(const Position& position) {
+    // Weigh every player by the inverse of their hand size.
+    estimate_count_ += 1;
+    const auto weight = [](unsigned int size) {
+        return 1.0f / std::max(size, 1u);
+    };
+    float total = 0.0f;
+    for (uint8_t seat = 0; seat < position.seat_count; seat += 1) {
+        total += weight(position.sizes[seat]);
+    }
+    return weight(position.sizes[0] + position.penalty) / total;
+}
+
+bool EndgameSolver::out_of_budget() {
+    if (!aborted_ && node_count_ >= limits_.node_budget) {
+        aborted_ = true;
+    }
+    // Reading the clock costs more than a node, so check it now and then.
+    if (!aborted_ && node_count_ % 256 == 0
+        && std::chrono::steady_clock::now() > deadline_) {
+        aborted_ = true;
+    }
+    return aborted_;
+}
+
+uint64_t EndgameSolver::hash(const Position& position) {
+    uint64_t hash = 0xCBF29CE484222325;
+    hash_bytes(hash, position.hand);
+    hash_bytes(hash, position.sizes);
+    hash_bytes(hash, position.top_face);
+    hash_bytes(hash, position.top_color);
+    hash_bytes(hash, position.turn);
+    hash_bytes(hash, position.direction);
+    hash_bytes(hash, position.penalty);
+    return hash;
+}
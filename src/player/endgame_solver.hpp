@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "../observation.hpp"
+
+/// Limits of an endgame search.
+struct EndgameLimits {
+    /// Solve only positions with at most this many cards in all hands. 0
+    /// disables the solver.
+    uint8_t card_threshold = 8;
+    /// Hands growing past this size are estimated instead of searched.
+    uint8_t hand_cap = 8;
+    /// Turns and draws searched ahead, at most.
+    uint8_t max_depth = 16;
+    size_t node_budget = 100'000;
+    std::chrono::microseconds time_budget {5'000};
+};
+
+/// Searches small endgames for the move with the best chance of winning.
+///
+/// The search is an expectiminimax over a model of the unseen cards: every
+/// card an opponent holds or anyone draws is an independent draw from the
+/// unseen cards, and opponents play the cards that are worst for the
+/// player. A position is then identified by the player's hand, the hand
+/// sizes and the top card, which lets the search memoize positions across
+/// transpositions and iterations. It deepens iteratively until the tree
+/// is solved without estimates or the budget runs out, and prunes chance
+/// nodes with alpha-beta bounds on win probabilities.
+///
+/// The memo is a table of fixed size, allocated with the solver, so that
+/// solving does not allocate.
+class EndgameSolver {
+  public:
+    explicit EndgameSolver(EndgameLimits limits = {}) :
+        limits_(limits),
+        memo_(limits.card_threshold > 0 ? MEMO_SIZE : 0) {}
+
+    /// Returns whether the position has few enough cards to solve.
+    bool applies(const Observation& observation) const;
+
+    /// Returns the best move, or `std::nullopt` if the budget ran out before
+    /// the first iteration completed. `unseen` holds the copies of each face
+    /// the player has not seen, and the player must have a legal move. The
+    /// solver must not be disabled.
+    std::optional<Action> solve(
+        const Observation& observation,
+        const std::array<uint8_t, FACE_COUNT>& unseen
+    );
+
+    /// Returns the probability of winning with the last move found.
+    float value() const noexcept {
+        return value_;
+    }
+
+    /// Returns whether the value of the last move found involved no
+    /// estimates.
+    bool is_exact() const noexcept {
+        return is_exact_;
+    }
+
+    /// Returns the number of nodes visited by the last search.
+    size_t node_count() const noexcept {
+        return node_count_;
+    }
+
+  private:
+    struct Position {
+        std::array<uint8_t, FACE_COUNT> hand; // Hand of the player
+        uint64_t hand_faces;                  // Bit set of the faces in hand
+        std::array<uint8_t, MAX_SEATS> sizes; // Hand sizes, from the player
+        Face top_face;
+        Color top_color;
+        uint8_t turn;     // Current seat, counted from the player
+        int8_t direction; // 1 to pass turns in the initial direction
+        uint8_t penalty;  // Cards the player must draw before being skipped
+        uint8_t seat_count;
+    };
+
+    enum class Bound : uint8_t { Exact, Lower, Upper };
+
+    struct Entry {
+        uint64_t key; // Hash of the position
+        float value;
+        uint8_t depth; // Depth searched, or `SOLVED`
+        Bound bound;
+        uint16_t search; // Number of the search that stored it
+    };
+
+    static_assert(sizeof(Entry) == 16);
+
+    /// Entries of the memo, a power of two. Positions whose hashes share
+    /// the low bits take the entry from one another.
+    static constexpr size_t MEMO_SIZE = size_t {1} << 14;
+
+    /// Marks a memoized value that no estimate went into.
+    static constexpr uint8_t SOLVED = 0xFF;
+
+    float search(const Position& position, uint8_t depth, float, float);
+    float search_player(const Position& position, uint8_t depth, float, float);
+    float search_draw(const Position& position, uint8_t depth, float, float);
+    float search_opponent(const Position& position, uint8_t depth);
+
+    /// Plays the action for the current player. Returns whether the game is
+    /// over, in which case `value` is set.
+    static bool play(Position& position, Action action, float& value);
+
+    static uint8_t next_seat(const Position& position);
+
+    /// Estimates the chance of winning from the hand sizes.
+    float estimate(const Position& position);
+
+    bool out_of_budget();
+
+    static uint64_t hash(const Position& position);
+
+    EndgameLimits limits_;
+
+    // Unseen cards as probabilities of each face.
+    std::array<float, FACE_COUNT> face_odds_ {};
+
+    std::vector<Entry> memo_;
+    uint16_t search_ = 0; // Entries of other searches are stale
+    std::chrono::steady_clock::time_point deadline_;
+    size_t node_count_ = 0;
+    size_t estimate_count_ = 0;
+    bool aborted_ = false;
+
+    float value_ = 0.0f;
+    bool is_exact_ = false;
+};
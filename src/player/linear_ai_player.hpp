@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+
+#include "ai_player.hpp"
+#include "endgame_solver.hpp"
+#include "linear_evaluator.hpp"
+
+/// An AI-controlled player that plays the move its evaluator scores highest,
+/// unless an endgame search solves the position exactly.
+class LinearAiPlayer: public AiPlayer {
+  public:
+    /// The evaluator must outlive the player.
+    explicit LinearAiPlayer(
+        const LinearEvaluator& evaluator,
+        EndgameLimits endgame_limits = {}
+    ) :
+        evaluator_(evaluator),
+        solver_(endgame_limits) {}
+
+    void observe(const Observation& observation) override {
+        observation_ = observation;
+    }
+
+    unique_ptr<Card> play_card(const DiscardPile& discard_pile) override {
+        const auto action = choose();
+        wild_color_ = action.color;
+        const auto it = std::ranges::find_if(cards_, [&](const auto& card) {
+            return face_of(*card) == action.face;
+        });
+        assert(it != cards_.end() && discard_pile.accepts(**it));
+        auto card = std::move(*it);
+        cards_.erase(it);
+        return card;
+    }
+
+    Color select_wild_color() const override {
+        return wild_color_;
+    }
+
+  private:
+    Action choose() {
+        if (solver_.applies(observation_)) {
+            // Estimates at the search horizon are cruder than the
+            // evaluator, so only trust values the search has proven.
+            const auto action = solver_.solve(
+                observation_,
+                tracker_.unseen_faces(observation_.hand)
+            );
+            if (action && solver_.is_exact()) {
+                return *action;
+            }
+        }
+        return evaluator_.choose(observation_);
+    }
+
+    const LinearEvaluator& evaluator_;
+    EndgameSolver solver_;
+    Observation observation_ {};
+    Color wild_color_ = Color::Red;
+};
@@ -0,0 +1,213 @@
+#include "linear_evaluator.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define UNO_SSE2
+#endif
+
+namespace {
+/// The parts of the features that do not depend on the move.
+struct Position {
+    std::array<uint8_t, COLOR_COUNT> color_cards {};
+    uint8_t wild_cards = 0;
+    uint8_t action_cards = 0;
+    float next_closeness;
+    float previous_closeness;
+    float fewest_closeness;
+};
+
+/// Returns how close a player with the given number of cards is to winning.
+float closeness(uint8_t hand_size) {
+    return 1.0f / std::max<uint8_t>(hand_size, 1);
+}
+
+bool is_action(uint8_t rank) {
+    return rank >= DRAW_TWO_RANK && rank <= SKIP_RANK;
+}
+
+Position summarize(const Observation& observation) {
+    Position position;
+    for (Face face = 0; face < FACE_COUNT; face += 1) {
+        const auto count = observation.hand[face];
+        if (is_wild(face)) {
+            position.wild_cards += count;
+            continue;
+        }
+        position.color_cards[face / RANKS_PER_COLOR] += count;
+        if (is_action(face_rank(face))) {
+            position.action_cards += count;
+        }
+    }
+
+    const auto& sizes = observation.hand_sizes;
+    const auto seat_count = observation.seat_count;
+    position.next_closeness = closeness(sizes[1]);
+    position.previous_closeness = closeness(sizes[seat_count - 1]);
+    position.fewest_closeness = closeness(*std::min_element(
+        sizes.begin() + 1,
+        sizes.begin() + seat_count
+    ));
+    return position;
+}
+
+void extract_features(
+    const Position& position,
+    const Observation& observation,
+    Action action,
+    FeatureVector& features
+) {
+    const auto face = action.face;
+    const auto rank = face_rank(face);
+
+    auto color_cards = position.color_cards;
+    auto wild_cards = position.wild_cards;
+    auto action_cards = position.action_cards;
+    if (is_wild(face)) {
+        wild_cards -= 1;
+    } else {
+        color_cards[face / RANKS_PER_COLOR] -= 1;
+        action_cards -= is_action(rank) ? 1 : 0;
+    }
+    const auto color_count = std::ranges::count_if(color_cards, [](auto n) {
+        return n > 0;
+    });
+    const auto attacks = rank == DRAW_TWO_RANK || rank == SKIP_RANK
+        || face == WILD_DRAW_FOUR_FACE
+        || (rank == REVERSE_RANK && observation.seat_count == 2);
+    const auto reverses =
+        rank == REVERSE_RANK && observation.seat_count > 2;
+
+    const auto set = [&](Feature feature, float value) {
+        features[static_cast<size_t>(feature)] = value;
+    };
+    features.fill(0.0f);
+    set(Feature::Bias, 1.0f);
+    set(Feature::HandSize, (observation.hand_sizes[0] - 1) / 10.0f);
+    set(Feature::ColorCount, color_count / 4.0f);
+    set(Feature::ColorCards,
+        color_cards[static_cast<uint8_t>(action.color)] / 10.0f);
+    set(Feature::WildCards, wild_cards / 4.0f);
+    set(Feature::ActionCards, action_cards / 4.0f);
+    set(Feature::CopiesLeft, observation.hand[face] - 1.0f);
+    set(Feature::NextHandSize, position.next_closeness);
+    set(Feature::PreviousHandSize, position.previous_closeness);
+    set(Feature::FewestCards, position.fewest_closeness);
+    set(Feature::PlayDirection, static_cast<int8_t>(observation.direction));
+    set(Feature::PlaysNumber, rank < DRAW_TWO_RANK);
+    set(Feature::NumberValue, rank < DRAW_TWO_RANK ? rank / 9.0f : 0.0f);
+    set(Feature::PlaysDrawTwo, rank == DRAW_TWO_RANK);
+    set(Feature::PlaysSkip, rank == SKIP_RANK);
+    set(Feature::PlaysReverse, rank == REVERSE_RANK);
+    set(Feature::PlaysWild, face == WILD_FACE);
+    set(Feature::PlaysWildDrawFour, face == WILD_DRAW_FOUR_FACE);
+    set(Feature::ChangesColor, action.color != observation.top_color);
+    set(Feature::AttacksNext, attacks ? position.next_closeness : 0.0f);
+    set(Feature::ReversesOnPrevious,
+        reverses ? position.previous_closeness : 0.0f);
+    set(Feature::StacksPenalty, observation.pending_draw / 10.0f);
+}
+} // namespace
+
+FeatureVector extract_features(const Observation& observation, Action action) {
+    FeatureVector features;
+    extract_features(summarize(observation), observation, action, features);
+    return features;
+}
+
+float dot(const FeatureVector& features, const Weights& weights) noexcept {
+    // Both paths add the products in the same order, so that scores and
+    // therefore moves are the same on every platform.
+#ifdef UNO_SSE2
+    __m128 sums = _mm_setzero_ps();
+    for (size_t i = 0; i < FEATURE_COUNT; i += 4) {
+        sums = _mm_add_ps(
+            sums,
+            _mm_mul_ps(
+                _mm_loadu_ps(&features[i]),
+                _mm_loadu_ps(&weights[i])
+            )
+        );
+    }
+    sums = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+    sums = _mm_add_ss(sums, _mm_shuffle_ps(sums, sums, 1));
+    return _mm_cvtss_f32(sums);
+#else
+    std::array<float, 4> sums {};
+    for (size_t i = 0; i < FEATURE_COUNT; i += 4) {
+        for (size_t lane = 0; lane < 4; lane += 1) {
+            sums[lane] += features[i + lane] * weights[i + lane];
+        }
+    }
+    return (sums[0] + sums[2]) + (sums[1] + sums[3]);
+#endif
+}
+
+LinearEvaluator LinearEvaluator::load(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("failed to open " + path.string());
+    }
+
+    Weights weights {};
+    std::string line;
+    for (size_t line_number = 1; std::getline(file, line); line_number += 1) {
+        std::istringstream stream(line);
+        std::string name;
+        if (!(stream >> name) || name.starts_with('#')) {
+            continue;
+        }
+        const auto it = std::ranges::find(FEATURE_NAMES, name);
+        float weight;
+        if (it == FEATURE_NAMES.end() || !(stream >> weight)) {
+            throw std::runtime_error(
+                path.string() + ":" + std::to_string(line_number)
+                + ": expected a feature name and a weight"
+            );
+        }
+        weights[std::distance(FEATURE_NAMES.begin(), it)] = weight;
+    }
+    return LinearEvaluator(weights);
+}
+
+const LinearEvaluator& LinearEvaluator::get() {
+    static const auto instance = load("assets/weights/linear.txt");
+    return instance;
+}
+
+Action LinearEvaluator::choose(const Observation& observation) const {
+    assert(observation.legal_faces != 0);
+    const auto position = summarize(observation);
+    FeatureVector features;
+    Action best {};
+    float best_score = -std::numeric_limits<float>::infinity();
+    const auto consider = [&](Action action) {
+        extract_features(position, observation, action, features);
+        const auto score = dot(features, weights_);
+        if (score > best_score) {
+            best = action;
+            best_score = score;
+        }
+    };
+
+    for (auto faces = observation.legal_faces; faces != 0;
+         faces &= faces - 1) {
+        const auto face = static_cast<Face>(std::countr_zero(faces));
+        if (!is_wild(face)) {
+            consider({face, face_color(face)});
+            continue;
+        }
+        for (uint8_t color = 0; color < COLOR_COUNT; color += 1) {
+            consider({face, static_cast<Color>(color)});
+        }
+    }
+    return best;
+}
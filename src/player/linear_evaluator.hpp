@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+#include "../observation.hpp"
+
+/// Features of a move, as seen by the player making it.
+enum class Feature : uint8_t {
+    Bias,
+    HandSize,           // Cards left after the move
+    ColorCount,         // Colors left after the move
+    ColorCards,         // Cards left of the color to play on next
+    WildCards,          // Wild cards left
+    ActionCards,        // Draw Two, Reverse and Skip cards left
+    CopiesLeft,         // Copies of the played face left
+    NextHandSize,       // Closeness of the next player to winning
+    PreviousHandSize,   // Closeness of the previous player to winning
+    FewestCards,        // Closeness of the leading opponent to winning
+    PlayDirection,      // 1 for clockwise, -1 for counterclockwise
+    PlaysNumber,
+    NumberValue,        // Value of a played number card
+    PlaysDrawTwo,
+    PlaysSkip,
+    PlaysReverse,
+    PlaysWild,
+    PlaysWildDrawFour,
+    ChangesColor,       // Color to play on changes
+    AttacksNext,        // Makes the next player draw or lose their turn
+    ReversesOnPrevious, // Passes the turn to the previous player
+    StacksPenalty,      // Penalty stacked on
+};
+
+/// Number of features, of which the last are padding for vector lanes.
+constexpr size_t FEATURE_COUNT = 24;
+
+/// Names of the features in weights files.
+constexpr std::array<std::string_view, 22> FEATURE_NAMES = {
+    "bias",
+    "hand_size",
+    "color_count",
+    "color_cards",
+    "wild_cards",
+    "action_cards",
+    "copies_left",
+    "next_hand_size",
+    "previous_hand_size",
+    "fewest_cards",
+    "play_direction",
+    "plays_number",
+    "number_value",
+    "plays_draw_two",
+    "plays_skip",
+    "plays_reverse",
+    "plays_wild",
+    "plays_wild_draw_four",
+    "changes_color",
+    "attacks_next",
+    "reverses_on_previous",
+    "stacks_penalty",
+};
+
+static_assert(FEATURE_NAMES.size() <= FEATURE_COUNT);
+static_assert(FEATURE_COUNT % 4 == 0);
+
+using FeatureVector = std::array<float, FEATURE_COUNT>;
+using Weights = std::array<float, FEATURE_COUNT>;
+
+/// Returns the features of playing the action.
+FeatureVector extract_features(const Observation& observation, Action action);
+
+/// Returns the dot product of the features and the weights.
+float dot(const FeatureVector& features, const Weights& weights) noexcept;
+
+/// Scores every legal move as a weighted sum of its features and picks the
+/// best.
+class LinearEvaluator {
+  public:
+    explicit LinearEvaluator(const Weights& weights) : weights_(weights) {}
+
+    /// Loads weights from a file of `name value` lines. Features left out
+    /// have a weight of 0. Throws `std::runtime_error` on failure.
+    static LinearEvaluator load(const std::filesystem::path& path);
+
+    /// Returns the evaluator with the bundled weights.
+    static const LinearEvaluator& get();
+
+    float score(const Observation& observation, Action action) const {
+        return dot(extract_features(observation, action), weights_);
+    }
+
+    /// Returns the legal move with the highest score, choosing a color for
+    /// wild cards. The player must have a legal move.
+    Action choose(const Observation& observation) const;
+
+    const Weights& weights() const noexcept {
+        return weights_;
+    }
+
+  private:
+    Weights weights_;
+};
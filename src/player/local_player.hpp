@@ -1,108 +1,133 @@
 #pragma once
 
 #include <algorithm>
-#include <cassert>
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <memory>
-#include <mutex>
 #include <optional>
 
 #include "../button.hpp"
+#include "../input.hpp"
 #include "player.hpp"
 
 class LocalPlayer: public Player {
   public:
-    LocalPlayer(
-        Position position,
-        Deck& deck,
-        sf::RenderTarget& render_target
-    ) :
-        Player(position, deck) {}
-
     unique_ptr<Card> play_card(const DiscardPile& discard_pile) override {
-        selected_card_index_ = std::nullopt;
-        while (!selected_card_index_.has_value())
-            ;
-
-        std::lock_guard lock(cards_mutex_);
-        auto card = std::move(cards_[selected_card_index_.value()]);
-        cards_.erase(std::next(cards_.begin(), selected_card_index_.value()));
-        selected_card_index_ = std::nullopt;
-
-        assert(card->can_play_on(discard_pile.peek_top()));
-        return card;
+        // The hand on the screen may lag behind the hand while cards are in
+        // flight, so a click names a card rather than a position in the
+        // hand. Clicks on a card that cannot be played are ignored.
+        selected_atlas_index_ = NO_CARD;
+        while (true) {
+            selected_atlas_index_.wait(NO_CARD);
+            const auto atlas_index = selected_atlas_index_.exchange(NO_CARD);
+
+            const auto it = std::ranges::find_if(cards_, [&](const auto& card) {
+                return card->atlas_index() == atlas_index
+                    && discard_pile.accepts(*card);
+            });
+            if (it != cards_.end()) {
+                auto card = std::move(*it);
+                cards_.erase(it);
+                return card;
+            }
+        }
     }
 
     Color select_wild_color() const override {
         is_picking_color_ = true;
-        while (is_picking_color_)
-            ;
+        is_picking_color_.wait(true);
         return picked_color_;
     }
 
-    virtual void render(
-        sf::RenderWindow& window,
-        const DiscardPile& discard_pile,
-        bool is_current_player
-    ) const override {
-        render_hand(window, discard_pile, is_current_player);
+    void handle_input(const Input& input) override {
+        mouse_position_ = input.mouse_position();
         if (is_picking_color_) {
-            render_color_picker(window);
+            if (const auto color = color_buttons_.clicked(input)) {
+                picked_color_ = *color;
+                is_picking_color_ = false;
+                is_picking_color_.notify_one();
+            }
+            return;
+        }
+        const auto card = hand_cards_.clicked(input);
+        if (card.has_value() && card->is_playable) {
+            selected_atlas_index_ = card->atlas_index;
+            selected_atlas_index_.notify_one();
         }
     }
 
-    virtual void draw_from_deck(Deck& deck) override {
-        std::lock_guard lock(cards_mutex_);
-        Player::draw_from_deck(deck);
+    virtual void render(
+        SpriteBatch& batch,
+        const TableSnapshot& snapshot,
+        const TableLayout& layout,
+        uint8_t seat
+    ) const override {
+        const auto is_current_player = snapshot.current_seat == seat;
+        render_hand(batch, layout, snapshot.hands[seat], is_current_player);
+    }
+
+    virtual void render_overlay(SpriteBatch& batch, const TableLayout& layout)
+        const override {
+        if (is_picking_color_) {
+            render_color_picker(batch, layout);
+        }
     }
 
   private:
+    static constexpr uint8_t NO_CARD = std::numeric_limits<uint8_t>::max();
+
+    /// A card of the hand as shown on the screen.
+    struct HandCard {
+        size_t index; // In the hand on the screen
+        uint8_t atlas_index;
+        bool is_playable; // Whether a click plays it
+    };
+
     void render_hand(
-        sf::RenderWindow& window,
-        const DiscardPile& discard_pile,
+        SpriteBatch& batch,
+        const TableLayout& layout,
+        const std::vector<CardView>& cards,
         bool is_current_player
     ) const {
-        std::lock_guard lock(cards_mutex_);
-
+        const auto table_size = layout.size();
         std::vector<sf::Sprite> sprites;
-        sprites.reserve(cards_.size());
+        sprites.reserve(cards.size());
 
-        for (size_t i = 0; i < cards_.size(); i += 1) {
-            auto sprite = cards_[i]->sprite();
+        for (size_t i = 0; i < cards.size(); i += 1) {
+            auto sprite = Card::get_sprite(cards[i].atlas_index);
 
-            const auto spacing = std::min(
-                window.getSize().x * 0.5f / cards_.size(),
-                MAX_SPACING
-            );
+            const auto spacing =
+                std::min(table_size.x * 0.5f / cards.size(), MAX_SPACING);
             const auto total_width = sprite.getGlobalBounds().size.x - spacing
-                + (cards_.size() - 1) * spacing;
+                + (cards.size() - 1) * spacing;
             sprite.setPosition(
-                {window.getSize().x / 2.0f - total_width / 2.0f + i * spacing,
-                 window.getSize().y - sprite.getGlobalBounds().size.y / 2.0f}
+                {table_size.x / 2.0f - total_width / 2.0f + i * spacing,
+                 table_size.y - sprite.getGlobalBounds().size.y / 2.0f}
             );
 
             sprites.push_back(std::move(sprite));
         }
 
-        // Update the hovered card index.
+        // The last card drawn is on top of the others.
+        hand_cards_.clear();
+        for (size_t i = 0; i < cards.size(); i += 1) {
+            hand_cards_.add(
+                sprites[i].getGlobalBounds(),
+                {i,
+                 cards[i].atlas_index,
+                 is_current_player && cards[i].is_playable}
+            );
+        }
         hovered_card_index_ = std::nullopt;
-        for (size_t i = 0; i < cards_.size(); i += 1) {
-            if (sprites[i].getGlobalBounds().contains(get_mouse_position(window)
-                )
-                && !(
-                    i + 1 < cards_.size()
-                    && sprites[i + 1].getGlobalBounds().contains(
-                        get_mouse_position(window)
-                    )
-                )) {
-                hovered_card_index_ = i;
-            }
+        if (const auto card = hand_cards_.hit(mouse_position_)) {
+            hovered_card_index_ = card->index;
         }
 
         // Draw the cards in the hand.
-        for (size_t i = 0; i < cards_.size(); i += 1) {
+        for (size_t i = 0; i < cards.size(); i += 1) {
             // Dim the cards that cannot be played.
-            if (!is_current_player
-                || !cards_[i]->can_play_on(discard_pile.peek_top())) {
+            if (!is_current_player || !cards[i].is_playable) {
                 sprites[i].setColor(DIM_COLOR);
             }
 
@@ -112,34 +137,18 @@ class LocalPlayer: public Player {
                 continue;
             }
 
-            window.draw(sprites[i]);
+            batch.add(sprites[i]);
         }
 
         // Draw the hovered card on top of the others.
         if (hovered_card_index_.has_value()) {
-            on_card_hovered(hovered_card_index_.value(), discard_pile, sprites);
-            window.draw(sprites[hovered_card_index_.value()]);
+            sprites[hovered_card_index_.value()].move({0.0f, -20.0f});
+            batch.add(sprites[hovered_card_index_.value()]);
         }
     }
 
-    void on_card_hovered(
-        size_t card_index,
-        const DiscardPile& discard_pile,
-        std::vector<sf::Sprite>& sprites
-    ) const {
-        assert(hovered_card_index_.has_value());
-        sprites[card_index].move({0.0f, -20.0f});
-        if (cards_[card_index]->can_play_on(discard_pile.peek_top())
-            && sf::Mouse::isButtonPressed(sf::Mouse::Button::Left)) {
-            on_card_left_clicked(card_index);
-        }
-    }
-
-    void on_card_left_clicked(size_t card_index) const {
-        selected_card_index_ = card_index;
-    }
-
-    void render_color_picker(sf::RenderWindow& render_target) const {
+    void render_color_picker(SpriteBatch& batch, const TableLayout& layout)
+        const {
         constexpr Color PICKER_COLORS[] =
             {Color::Red, Color::Green, Color::Blue, Color::Yellow};
         constexpr sf::Color PICKER_SFML_COLORS[] = {
@@ -150,6 +159,7 @@ class LocalPlayer: public Player {
         };
         constexpr float BUTTON_SIZE = 90.0f;
 
+        color_buttons_.clear();
         for (int i = 0; i < 4; i += 1) {
             auto rectangle = std::make_unique<sf::RectangleShape>(
                 sf::Vector2f(BUTTON_SIZE, BUTTON_SIZE)
@@ -157,27 +167,26 @@ class LocalPlayer: public Player {
             rectangle->setOrigin(
                 rectangle->getGeometricCenter() - sf::Vector2f(0.0f, -100.0f)
             );
-            rectangle->setPosition(sf::Vector2f(render_target.getSize() / 2u));
+            rectangle->setPosition(layout.center());
             rectangle->setFillColor(PICKER_SFML_COLORS[i]);
             rectangle->setRotation(sf::degrees(i * 90.0f));
 
             Button button(std::move(rectangle));
-            button.render(render_target);
-            if (button.is_left_clicked(render_target)) {
-                picked_color_ = PICKER_COLORS[i];
-                is_picking_color_ = false;
-            }
+            button.render(batch, mouse_position_);
+            color_buttons_.add(button.bounds(), PICKER_COLORS[i]);
         }
     }
 
-    sf::Vector2f get_mouse_position(sf::RenderWindow& window) const {
-        return window.mapPixelToCoords(sf::Mouse::getPosition(window));
-    }
-
-    mutable std::mutex cards_mutex_;
+    // Shared between the gameplay thread, which waits for a choice, and the
+    // render thread, which takes it.
+    mutable std::atomic<bool> is_picking_color_ = false;
+    mutable std::atomic<Color> picked_color_ = Color::Red;
+    mutable std::atomic<uint8_t> selected_atlas_index_ = NO_CARD;
 
-    mutable bool is_picking_color_ = false;
-    mutable Color picked_color_;
+    // Only touched by the render thread, which rebuilds the regions every
+    // frame and tests the next frame's click against them.
+    mutable HitRegions<HandCard> hand_cards_;
+    mutable HitRegions<Color> color_buttons_;
     mutable optional<size_t> hovered_card_index_ = std::nullopt;
-    mutable optional<size_t> selected_card_index_ = std::nullopt;
+    sf::Vector2f mouse_position_;
 };
@@ -1,10 +1,23 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <span>
 
 #include "../card/card.hpp"
+#include "../card/face.hpp"
 #include "../deck.hpp"
 #include "../discard_pile.hpp"
+#include "../game_listener.hpp"
+#include "../input.hpp"
+#include "../observation.hpp"
+#include "../sprite_batch.hpp"
+#include "../table_layout.hpp"
+#include "../table_snapshot.hpp"
 
 using std::optional;
 using std::unique_ptr;
@@ -12,40 +25,88 @@ using std::vector;
 
 constexpr float MAX_SPACING = 70.0f;
 
-enum class Position : uint8_t { North, East, South, West };
-
-/// A player in the Uno game.
-class Player {
+/// A player in the Uno game, who is told about every event of the game.
+class Player: public GameListener {
   public:
-    virtual ~Player() = default;
     /// Play a card from the player's hand.
     virtual unique_ptr<Card> play_card(const DiscardPile&) = 0;
     /// Choose a color for a Wild card.
     virtual Color select_wild_color() const = 0;
 
+    /// Receives what the player knows right before they play a card.
+    virtual void observe(const Observation&) {}
+
+    /// Play a card identical to the top card out of turn, if desired.
+    virtual unique_ptr<Card> jump_in(const DiscardPile&) {
+        return nullptr;
+    }
+
+    /// Choose the seat to swap hands with after playing a 7.
+    virtual size_t select_swap_target(
+        std::span<const size_t> hand_sizes,
+        size_t seat
+    ) const {
+        // Swap with the opponent holding the fewest cards.
+        size_t target = seat;
+        size_t fewest_cards = std::numeric_limits<size_t>::max();
+        for (size_t i = 0; i < hand_sizes.size(); i += 1) {
+            if (i != seat && hand_sizes[i] < fewest_cards) {
+                target = i;
+                fewest_cards = hand_sizes[i];
+            }
+        }
+        return target;
+    }
+
+    /// Takes the mouse input of a frame. Called from the render thread
+    /// before `render`.
+    virtual void handle_input(const Input&) {}
+
+    /// Renders the player's hand from the snapshot, face down, at their
+    /// seat. Called from the render thread.
     virtual void render(
-        sf::RenderWindow& window,
+        SpriteBatch& batch,
+        const TableSnapshot& snapshot,
+        const TableLayout& layout,
+        uint8_t seat
+    ) const {
+        const auto card_count = snapshot.hands[seat].size();
+        const auto transform = layout.seat_transform(seat);
+        const auto spacing =
+            std::min(layout.hand_width() / card_count, MAX_SPACING);
+        for (size_t i = 0; i < card_count; i += 1) {
+            auto sprite = Card::get_back_sprite();
+            sprite.setPosition({(i - (card_count - 1) / 2.0f) * spacing, 0.0f});
+            batch.add(sprite, transform);
+        }
+    }
+
+    /// Renders the controls of a local player over the cards of the table.
+    /// Called from the render thread.
+    virtual void render_overlay(SpriteBatch&, const TableLayout&) const {}
+
+    /// Copies the player's hand into a snapshot.
+    template <bool stacking = true>
+    void snapshot_hand(
         const DiscardPile& discard_pile,
-        bool is_current_player
+        std::vector<CardView>& hand
     ) const {
-        switch (position_) {
-            case Position::North:
-                render_north_hand(window);
-                break;
-            case Position::East:
-            case Position::West:
-                render_vertical_hand(window);
-                break;
-            default:
-                assert(false); // Unreachable.
-                return;
+        hand.clear();
+        for (const auto& card : cards_) {
+            hand.push_back(
+                {card->atlas_index(), discard_pile.accepts<stacking>(*card)}
+            );
         }
     }
 
-    /// Draw a card from the deck.
-    virtual void draw_from_deck(Deck& deck) {
-        auto new_card = deck.draw().value();
-        cards_.insert(
+    /// Draw a card from the deck, and return it.
+    virtual const Card& draw_from_deck(Deck& deck) {
+        return take(deck.draw().value());
+    }
+
+    /// Puts a card into the player's hand, in order, and returns it.
+    const Card& take(unique_ptr<Card> new_card) {
+        const auto it = cards_.insert(
             std::lower_bound(
                 cards_.begin(),
                 cards_.end(),
@@ -56,91 +117,73 @@ class Player {
             ),
             std::move(new_card)
         );
+        return **it;
     }
 
+    template <bool stacking = true>
     bool has_playable_card(const DiscardPile& discard_pile) const {
         return std::ranges::any_of(cards_, [&](auto& card) {
-            return card->can_play_on(discard_pile.peek_top());
+            return discard_pile.accepts<stacking>(*card);
         });
     }
 
-    /// Returns true if the player has no cards left in their hand.
-    bool is_hand_empty() const noexcept {
-        return cards_.empty();
-    }
-
-    /// Returns the position of the player.
-    Position position() const noexcept {
-        return position_;
+    /// Copies the atlas indices of the cards in the player's hand.
+    void save_hand(std::vector<uint8_t>& atlas_indices) const {
+        atlas_indices.clear();
+        for (const auto& card : cards_) {
+            atlas_indices.push_back(card->atlas_index());
+        }
     }
 
-  protected:
-    Player(Position position, Deck& deck) : position_(position) {
-        for (size_t i = 0; i < 7; i += 1) {
-            draw_from_deck(deck);
+    /// Returns the number of copies of each face in the player's hand.
+    std::array<uint8_t, FACE_COUNT> face_counts() const {
+        std::array<uint8_t, FACE_COUNT> counts {};
+        for (const auto& card : cards_) {
+            counts[face_of(*card)] += 1;
         }
+        return counts;
     }
 
-    vector<unique_ptr<Card>> cards_;
-
-  private:
-    void render_north_hand(sf::RenderTarget& render_target) const {
-        assert(position_ == Position::North);
-        for (size_t i = 0; i < cards_.size(); i += 1) {
-            auto sprite = Card::get_back_sprite();
-
-            const auto spacing = std::min(
-                render_target.getSize().x * 0.5f / cards_.size(),
-                MAX_SPACING
-            );
-            const auto total_width = sprite.getGlobalBounds().size.x - spacing
-                + (cards_.size() - 1) * spacing;
-            sprite.setPosition(
-                {render_target.getSize().x / 2.0f - total_width / 2.0f
-                     + i * spacing,
-                 sprite.getGlobalBounds().size.y / 2.0f}
-            );
-
-            render_target.draw(sprite);
+    /// Returns the bit set of the faces in the player's hand that can be
+    /// played on the pile.
+    uint64_t playable_faces(const DiscardPile& discard_pile) const {
+        uint64_t faces = 0;
+        for (const auto& card : cards_) {
+            if (discard_pile.accepts(*card)) {
+                faces |= uint64_t {1} << face_of(*card);
+            }
         }
+        return faces;
     }
 
-    void render_vertical_hand(sf::RenderTarget& render_target) const {
-        assert(position_ == Position::East || position_ == Position::West);
-        for (size_t i = 0; i < cards_.size(); i += 1) {
-            auto sprite = Card::get_back_sprite();
+    /// Keeps the player's hand in the memory of the game the player is
+    /// seated at. The hand must be empty.
+    void use_memory(std::pmr::memory_resource* resource) {
+        assert(cards_.empty());
+        // The memory of a vector is set once, when it is constructed.
+        std::destroy_at(&cards_);
+        std::construct_at(&cards_, resource);
+    }
 
-            float x_position;
-            switch (position_) {
-                case Position::East:
-                    sprite.rotate(sf::degrees(90.0f));
-                    x_position = render_target.getSize().x
-                        - sprite.getGlobalBounds().size.x / 2.0f;
-                    break;
-                case Position::West:
-                    sprite.rotate(sf::degrees(-90.0f));
-                    x_position = sprite.getGlobalBounds().size.x / 2.0f;
-                    break;
-                default:
-                    assert(false); // Unreachable.
-                    return;
-            }
+    /// Exchanges hands with another player of the same game.
+    void swap_hand(Player& other) {
+        cards_.swap(other.cards_);
+    }
 
-            const auto spacing = std::min(
-                render_target.getSize().y * 0.5f / cards_.size(),
-                MAX_SPACING
-            );
-            const auto total_height = sprite.getGlobalBounds().size.x - spacing
-                + (cards_.size() - 1) * spacing;
-            sprite.setPosition(
-                {x_position,
-                 render_target.getSize().y / 2.0f - total_height / 2.0f
-                     + i * spacing}
-            );
+    /// Returns the number of cards in the player's hand.
+    size_t hand_size() const noexcept {
+        return cards_.size();
+    }
 
-            render_target.draw(sprite);
-        }
+    /// Returns true if the player has no cards left in their hand.
+    bool is_hand_empty() const noexcept {
+        return cards_.empty();
     }
 
-    Position position_;
+  protected:
+    Player() = default;
+
+    /// Only touched by the gameplay thread; the render thread draws hands
+    /// from snapshots.
+    std::pmr::vector<unique_ptr<Card>> cards_;
 };
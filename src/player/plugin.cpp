@@ -0,0 +1,65 @@
+#include "plugin.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <dlfcn.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+void* open_library(const std::filesystem::path& path) {
+    return LoadLibraryW(path.c_str());
+}
+
+void* find_symbol(void* library, const char* name) {
+    return reinterpret_cast<void*>(
+        GetProcAddress(static_cast<HMODULE>(library), name)
+    );
+}
+
+void close_library(void* library) {
+    FreeLibrary(static_cast<HMODULE>(library));
+}
+#else
+void* open_library(const std::filesystem::path& path) {
+    // An absolute path keeps `dlopen` from searching the library path.
+    return dlopen(std::filesystem::absolute(path).c_str(), RTLD_NOW);
+}
+
+void* find_symbol(void* library, const char* name) {
+    return dlsym(library, name);
+}
+
+void close_library(void* library) {
+    dlclose(library);
+}
+#endif
+} // namespace
+
+Plugin::~Plugin() {
+    if (library_ != nullptr) {
+        close_library(library_);
+    }
+}
+
+std::shared_ptr<const Plugin> Plugin::load(const std::filesystem::path& path) {
+    void* library = open_library(path);
+    if (library == nullptr) {
+        throw std::runtime_error("failed to load " + path.string());
+    }
+    const auto entry = reinterpret_cast<UnoPluginEntry>(
+        find_symbol(library, UNO_PLUGIN_ENTRY)
+    );
+    const UnoStrategy* strategy = entry != nullptr ? entry() : nullptr;
+    if (strategy == nullptr || strategy->abi_version != UNO_PLUGIN_ABI_VERSION
+        || strategy->choose == nullptr
+        || (strategy->create == nullptr) != (strategy->destroy == nullptr)) {
+        close_library(library);
+        throw std::runtime_error("incompatible plugin " + path.string());
+    }
+    return std::shared_ptr<const Plugin>(new Plugin(library, *strategy));
+}
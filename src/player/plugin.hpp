@@ -0,0 +1,89 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+#include "../observation.hpp"
+#include "uno_plugin.h"
+
+static_assert(UNO_FACE_COUNT == FACE_COUNT);
+static_assert(UNO_WILD_FACE == WILD_FACE);
+static_assert(UNO_WILD_DRAW_FOUR_FACE == WILD_DRAW_FOUR_FACE);
+static_assert(UNO_RANKS_PER_COLOR == RANKS_PER_COLOR);
+static_assert(UNO_COLOR_COUNT == COLOR_COUNT);
+static_assert(UNO_MAX_SEATS == MAX_SEATS);
+
+// Observations are handed to plugins as they are.
+static_assert(sizeof(UnoObservation) == sizeof(Observation));
+static_assert(
+    offsetof(UnoObservation, hand) == offsetof(Observation, hand)
+    && offsetof(UnoObservation, hand_sizes)
+        == offsetof(Observation, hand_sizes)
+    && offsetof(UnoObservation, legal_faces)
+        == offsetof(Observation, legal_faces)
+    && offsetof(UnoObservation, top_face) == offsetof(Observation, top_face)
+    && offsetof(UnoObservation, top_color)
+        == offsetof(Observation, top_color)
+    && offsetof(UnoObservation, direction)
+        == offsetof(Observation, direction)
+    && offsetof(UnoObservation, seat) == offsetof(Observation, seat)
+    && offsetof(UnoObservation, seat_count)
+        == offsetof(Observation, seat_count)
+    && offsetof(UnoObservation, pending_draw)
+        == offsetof(Observation, pending_draw)
+);
+
+/// An AI strategy behind the C interface of `uno_plugin.h`, either loaded
+/// from a shared library or linked into the program.
+///
+/// Players share the plugin they play with, which keeps its library loaded
+/// until the last of them is gone. Loading a rebuilt library again then
+/// swaps the strategy for the players created afterwards.
+class Plugin {
+  public:
+    /// Wraps a strategy linked into the program, which must outlive the
+    /// plugin.
+    explicit Plugin(const UnoStrategy& strategy) : strategy_(strategy) {}
+    ~Plugin();
+
+    Plugin(const Plugin&) = delete;
+    Plugin& operator=(const Plugin&) = delete;
+
+    /// Loads the strategy of a shared library. Throws `std::runtime_error` if
+    /// the library cannot be loaded or has another ABI version.
+    static std::shared_ptr<const Plugin>
+    load(const std::filesystem::path& path);
+
+    std::string_view name() const noexcept {
+        return strategy_.name != nullptr ? strategy_.name : "";
+    }
+
+    /// Returns the state of a new player.
+    void* create() const {
+        return strategy_.create != nullptr ? strategy_.create() : nullptr;
+    }
+
+    void destroy(void* context) const {
+        if (strategy_.destroy != nullptr) {
+            strategy_.destroy(context);
+        }
+    }
+
+    /// Returns the action the strategy chooses, which may not be legal.
+    Action choose(void* context, const Observation& observation) const {
+        const auto view = std::bit_cast<UnoObservation>(observation);
+        const auto action = strategy_.choose(context, &view);
+        return {action.face, static_cast<Color>(action.color)};
+    }
+
+  private:
+    Plugin(void* library, const UnoStrategy& strategy) :
+        strategy_(strategy),
+        library_(library) {}
+
+    UnoStrategy strategy_;
+    void* library_ = nullptr; // Null for a linked strategy
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+
+#include "ai_player.hpp"
+#include "plugin.hpp"
+
+/// An AI-controlled player whose choice of card comes from a plugin.
+class PluginPlayer: public AiPlayer {
+  public:
+    explicit PluginPlayer(std::shared_ptr<const Plugin> plugin) :
+        plugin_(std::move(plugin)),
+        context_(plugin_->create()) {}
+
+    ~PluginPlayer() {
+        plugin_->destroy(context_);
+    }
+
+    PluginPlayer(const PluginPlayer&) = delete;
+    PluginPlayer& operator=(const PluginPlayer&) = delete;
+
+    void observe(const Observation& observation) override {
+        observation_ = observation;
+    }
+
+    unique_ptr<Card> play_card(const DiscardPile& discard_pile) override {
+        const auto action = plugin_->choose(context_, observation_);
+        if (is_legal(action)) {
+            wild_color_ = action.color;
+            const auto it = std::ranges::find_if(cards_, [&](const auto& card) {
+                return face_of(*card) == action.face;
+            });
+            auto card = std::move(*it);
+            cards_.erase(it);
+            return card;
+        }
+        // Whatever the plugin does, the game goes on.
+        wild_color_ = AiPlayer::select_wild_color();
+        return AiPlayer::play_card(discard_pile);
+    }
+
+    Color select_wild_color() const override {
+        return wild_color_;
+    }
+
+  private:
+    bool is_legal(Action action) const noexcept {
+        return action.face < FACE_COUNT
+            && (observation_.legal_faces >> action.face & 1) != 0
+            && static_cast<uint8_t>(action.color) < COLOR_COUNT;
+    }
+
+    std::shared_ptr<const Plugin> plugin_;
+    void* context_;
+    Observation observation_ {};
+    Color wild_color_ = Color::Red;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+
+#include "player.hpp"
+
+/// A player who plays the moves of a replay rather than choosing them. The
+/// replay sets the card of the turn, by its atlas index, before each turn.
+/// Hands are shown face up, for the review of a game.
+class ReplayPlayer: public Player {
+  public:
+    /// Plays the card of the atlas index `next_card`, which outlives the
+    /// player.
+    explicit ReplayPlayer(const uint8_t& next_card) : next_card_(next_card) {}
+
+    /// Throws `std::runtime_error` if the card is not one the player can
+    /// play, as in a replay of another game.
+    unique_ptr<Card> play_card(const DiscardPile& discard_pile) override {
+        if (!is_card_atlas_index(next_card_)) {
+            mismatch();
+        }
+        // A Wild card gets its color once played.
+        const auto atlas_index = atlas_face(next_card_);
+        for (auto it = cards_.begin(); it != cards_.end(); ++it) {
+            if ((*it)->atlas_index() == atlas_index
+                && discard_pile.accepts(**it)) {
+                auto card = std::move(*it);
+                cards_.erase(it);
+                return card;
+            }
+        }
+        mismatch();
+    }
+
+    Color select_wild_color() const override {
+        const auto color = is_card_atlas_index(next_card_)
+            ? atlas_color(next_card_)
+            : std::nullopt;
+        if (!color.has_value()) {
+            mismatch();
+        }
+        return *color;
+    }
+
+    void render(
+        SpriteBatch& batch,
+        const TableSnapshot& snapshot,
+        const TableLayout& layout,
+        uint8_t seat
+    ) const override {
+        const auto& hand = snapshot.hands[seat];
+        const auto transform = layout.seat_transform(seat);
+        const auto spacing =
+            std::min(layout.hand_width() / hand.size(), MAX_SPACING);
+        for (size_t i = 0; i < hand.size(); i += 1) {
+            auto sprite = Card::get_sprite(hand[i].atlas_index);
+            sprite.setPosition(
+                {(i - (hand.size() - 1) / 2.0f) * spacing, 0.0f}
+            );
+            batch.add(sprite, transform);
+        }
+    }
+
+  private:
+    [[noreturn]] static void mismatch() {
+        throw std::runtime_error("the replay does not match the game");
+    }
+
+    const uint8_t& next_card_;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+/*
+ * The C interface of AI strategy plugins.
+ *
+ * A plugin is a shared library exporting `uno_plugin_strategy`, which returns
+ * the strategy it implements. The game calls `choose` with what the player
+ * knows whenever it is the player's turn and they hold a playable card.
+ * Everything else a player does, such as drawing or jumping in, is left to
+ * the game. Several games may run on different threads at once, each with
+ * contexts of its own.
+ *
+ * The structures only hold fixed-width integers, so that a plugin built with
+ * any compiler works with any build of the game of the same ABI version.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+    #define UNO_EXTERN_C extern "C"
+#else
+    #define UNO_EXTERN_C
+#endif
+
+#ifdef _WIN32
+    #define UNO_PLUGIN_EXPORT UNO_EXTERN_C __declspec(dllexport)
+#else
+    #define UNO_PLUGIN_EXPORT \
+        UNO_EXTERN_C __attribute__((visibility("default")))
+#endif
+
+/* Bumped whenever a structure below changes. */
+#define UNO_PLUGIN_ABI_VERSION 1
+
+/* Name of the function a plugin exports, of type `UnoPluginEntry`. */
+#define UNO_PLUGIN_ENTRY "uno_plugin_strategy"
+
+/*
+ * Faces identify a card up to the color chosen for a wild card. The 52
+ * colored faces come 13 per color (0-9, Draw Two, Reverse, Skip), in the
+ * order red, blue, green, yellow, followed by Wild and Wild Draw Four.
+ */
+#define UNO_FACE_COUNT 54
+#define UNO_WILD_FACE 52
+#define UNO_WILD_DRAW_FOUR_FACE 53
+#define UNO_RANKS_PER_COLOR 13
+#define UNO_COLOR_COUNT 4
+#define UNO_MAX_SEATS 10
+
+/* What the player knows when choosing a card. */
+typedef struct UnoObservation {
+    uint8_t hand[UNO_FACE_COUNT]; /* Copies of each face in the hand */
+    /*
+     * Hand sizes by seat, starting with the player and following the
+     * direction of play. Sizes over 255 are saturated.
+     */
+    uint8_t hand_sizes[UNO_MAX_SEATS];
+    uint64_t legal_faces; /* Bit set of the faces the player may play */
+    uint8_t top_face;
+    uint8_t top_color; /* Color to play on, chosen for a wild top card */
+    int8_t direction;  /* 1 clockwise, -1 counterclockwise */
+    uint8_t seat;
+    uint8_t seat_count;
+    uint8_t pending_draw; /* Penalty to stack on or take */
+} UnoObservation;
+
+/* A card to play, and the color chosen for it if it is wild. */
+typedef struct UnoAction {
+    uint8_t face; /* One of the legal faces */
+    uint8_t color;
+} UnoAction;
+
+typedef struct UnoStrategy {
+    uint32_t abi_version; /* UNO_PLUGIN_ABI_VERSION */
+    const char* name;
+    /*
+     * Creates the state of one player, passed back to `choose`. Either both
+     * `create` and `destroy` are null, for a stateless strategy, or neither.
+     */
+    void* (*create)(void);
+    void (*destroy)(void* context);
+    /*
+     * Chooses a card to play. An action that is not legal is replaced by the
+     * first playable card.
+     */
+    UnoAction (*choose)(void* context, const UnoObservation* observation);
+} UnoStrategy;
+
+typedef const UnoStrategy* (*UnoPluginEntry)(void);
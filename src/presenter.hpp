@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+#include "animator.hpp"
+#include "audio.hpp"
+#include "game_listener.hpp"
+
+/// Seconds the other players seem to think before playing a card.
+constexpr float THINKING_DELAY = 1.5f;
+
+/// Presents a game to the local player: animates the cards the engine moves,
+/// plays sounds as they set off and holds the other players' cards back a
+/// little so that their moves can be followed. The engine never waits for
+/// the animations; the caller paces turns with `wait_until_presented`.
+class Presenter: public GameListener {
+  public:
+    /// Seat of the local player at a table of AI players only.
+    static constexpr uint8_t NO_LOCAL_SEAT = 0xFF;
+    /// Time scale that skips the animations and lets the engine run freely.
+    static constexpr float UNLIMITED = std::numeric_limits<float>::infinity();
+
+    void on_card_drawn(uint8_t seat, DrawReason, const Card* card) override {
+        if (time_scale_ == UNLIMITED) {
+            return;
+        }
+        animator_.push({
+            CardMotion::Kind::Draw,
+            seat,
+            card->atlas_index(),
+            seat == local_seat_,
+            0.0f,
+        });
+    }
+
+    void on_card_played(uint8_t seat, const Card& card) override {
+        if (time_scale_ == UNLIMITED) {
+            return;
+        }
+        animator_.push({
+            CardMotion::Kind::Play,
+            seat,
+            card.atlas_index(),
+            true,
+            seat == local_seat_ ? 0.0f : THINKING_DELAY,
+        });
+    }
+
+    /// Blocks the gameplay thread until every card moved so far has arrived.
+    void wait_until_presented() const {
+        animator_.wait_until_idle();
+    }
+
+    /// Returns whether every card moved so far has arrived.
+    bool is_presented() const noexcept {
+        return animator_.has_arrived();
+    }
+
+    /// Advances the animations by the time elapsed since the last frame.
+    /// Render thread only.
+    void update(float seconds) {
+        const float time_scale = time_scale_;
+        // Catch up on the motions left from before the speed was unlimited.
+        const auto scaled_seconds = time_scale == UNLIMITED
+            ? Animator::MAX_LAG
+            : seconds * time_scale;
+        // Sounds only keep up at the normal speed.
+        const auto is_muted = is_muted_ || time_scale != 1.0f;
+        animator_.update(scaled_seconds, [&](const CardMotion& motion) {
+            if (is_muted) {
+                return;
+            } else if (motion.kind == CardMotion::Kind::Draw) {
+                Audio::get().play(SoundEffect::Slide);
+            } else {
+                Audio::get().play(SoundEffect::Place);
+            }
+        });
+    }
+
+    /// Releases the gameplay thread so that it can be stopped.
+    void cancel() {
+        animator_.cancel();
+    }
+
+    /// Forgets the previous game, before a game with the local player at the
+    /// seat.
+    void reset(uint8_t local_seat) {
+        local_seat_ = local_seat;
+        animator_.reset();
+    }
+
+    /// Silences the game, e.g. one of many on the screen.
+    void set_muted(bool is_muted) noexcept {
+        is_muted_ = is_muted;
+    }
+
+    /// Sets how many times faster than normal the game is shown.
+    void set_time_scale(float time_scale) noexcept {
+        time_scale_ = time_scale;
+    }
+
+    const Animator& animator() const noexcept {
+        return animator_;
+    }
+
+  private:
+    uint8_t local_seat_ = NO_LOCAL_SEAT;
+    bool is_muted_ = false;
+    std::atomic<float> time_scale_ = 1.0f; // Read by the gameplay thread
+    Animator animator_;
+};
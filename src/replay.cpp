@@ -0,0 +1,224 @@
+#include "replay.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "player/replay_player.hpp"
+
+ReplayWriter::ReplayWriter(
+    const std::filesystem::path& path,
+    uint32_t keyframe_interval
+) :
+    file_(path, std::ios::binary | std::ios::trunc),
+    keyframe_interval_(keyframe_interval) {
+    assert(keyframe_interval > 0);
+    if (!file_) {
+        throw std::runtime_error("failed to create " + path.string());
+    }
+    // Reserve the header, which is written once the index is.
+    write_header(0);
+}
+
+ReplayWriter::~ReplayWriter() {
+    if (!finished_) {
+        try {
+            finish();
+        } catch (const std::runtime_error&) {
+            // Only an explicit call to `finish` can report the failure.
+        }
+    }
+}
+
+void ReplayWriter::begin_turn(const State& state) {
+    end_turn();
+    if (turn_count_ % keyframe_interval_ == 0) {
+        keyframe_offsets_.push_back(static_cast<uint64_t>(file_.tellp()));
+        state.checkpoint(checkpoint_);
+        payload_.clear();
+        checkpoint_.encode(payload_);
+        const auto size = static_cast<uint32_t>(payload_.size());
+        file_.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file_.write(
+            payload_.data(),
+            static_cast<std::streamsize>(payload_.size())
+        );
+    }
+    turn_count_ += 1;
+    is_in_turn_ = true;
+}
+
+void ReplayWriter::finish() {
+    end_turn();
+    const auto index_offset = static_cast<uint64_t>(file_.tellp());
+    file_.write(
+        reinterpret_cast<const char*>(keyframe_offsets_.data()),
+        static_cast<std::streamsize>(
+            keyframe_offsets_.size() * sizeof(uint64_t)
+        )
+    );
+    file_.seekp(0);
+    write_header(index_offset);
+    file_.close();
+    finished_ = true;
+    if (!file_) {
+        throw std::runtime_error("failed to write replay");
+    }
+}
+
+void ReplayWriter::end_turn() {
+    if (is_in_turn_) {
+        file_.put(static_cast<char>(card_));
+        card_ = NO_CARD;
+        is_in_turn_ = false;
+    }
+}
+
+void ReplayWriter::write_header(uint64_t index_offset) {
+    ReplayHeader header {};
+    header.magic = ReplayHeader::MAGIC;
+    header.version = ReplayHeader::VERSION;
+    header.keyframe_interval = keyframe_interval_;
+    header.turn_count = turn_count_;
+    header.keyframe_count = static_cast<uint32_t>(keyframe_offsets_.size());
+    header.index_offset = index_offset;
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+Replay::Replay(const std::filesystem::path& path) : file_(path) {
+    const auto bytes = file_.bytes();
+    if (bytes.size() < sizeof(ReplayHeader)) {
+        throw std::runtime_error(path.string() + " is not a replay");
+    }
+    std::memcpy(&header_, bytes.data(), sizeof(header_));
+    if (header_.magic != ReplayHeader::MAGIC) {
+        throw std::runtime_error(path.string() + " is not a replay");
+    }
+    if (header_.version != ReplayHeader::VERSION) {
+        throw std::runtime_error(
+            path.string() + " has an unsupported replay version"
+        );
+    }
+    const auto interval = header_.keyframe_interval;
+    if (interval == 0 || header_.turn_count == 0
+        || header_.keyframe_count
+            != (header_.turn_count + interval - 1) / interval
+        || header_.index_offset > bytes.size()
+        || (bytes.size() - header_.index_offset) / sizeof(uint64_t)
+            < header_.keyframe_count) {
+        throw std::runtime_error(path.string() + " is truncated");
+    }
+    // Every keyframe must hold a table in play and the turns after it, each
+    // either no card or a card of the atlas.
+    uint8_t seat_count = 0;
+    for (uint32_t keyframe = 0; keyframe < header_.keyframe_count;
+         keyframe += 1) {
+        const auto turns = std::min(
+            interval,
+            header_.turn_count - keyframe * interval
+        );
+        uint64_t offset;
+        std::memcpy(
+            &offset,
+            bytes.data() + header_.index_offset + keyframe * sizeof(offset),
+            sizeof(offset)
+        );
+        uint32_t size;
+        if (offset < sizeof(ReplayHeader)
+            || offset + sizeof(size) > header_.index_offset) {
+            throw std::runtime_error(path.string() + " is truncated");
+        }
+        std::memcpy(&size, bytes.data() + offset, sizeof(size));
+        if (offset + sizeof(size) + size + turns > header_.index_offset) {
+            throw std::runtime_error(path.string() + " is truncated");
+        }
+
+        Checkpoint checkpoint;
+        try {
+            checkpoint = Checkpoint::decode(
+                bytes.subspan(offset + sizeof(size), size)
+            );
+        } catch (const std::runtime_error&) {
+            throw std::runtime_error(
+                path.string() + " has a malformed keyframe"
+            );
+        }
+        if (checkpoint.seat_count == 0
+            || (seat_count != 0 && checkpoint.seat_count != seat_count)) {
+            throw std::runtime_error(
+                path.string() + " has a malformed keyframe"
+            );
+        }
+        seat_count = checkpoint.seat_count;
+
+        const auto cards = bytes.subspan(offset + sizeof(size) + size, turns);
+        for (const auto byte : cards) {
+            const auto card = static_cast<uint8_t>(byte);
+            if (card != ReplayWriter::NO_CARD && !is_card_atlas_index(card)) {
+                throw std::runtime_error(
+                    path.string() + " has a malformed turn"
+                );
+            }
+        }
+    }
+}
+
+Checkpoint Replay::keyframe(uint32_t index) const {
+    assert(index < header_.keyframe_count);
+    const auto bytes = file_.bytes();
+    uint64_t offset;
+    std::memcpy(
+        &offset,
+        bytes.data() + header_.index_offset + index * sizeof(offset),
+        sizeof(offset)
+    );
+    uint32_t size;
+    std::memcpy(&size, bytes.data() + offset, sizeof(size));
+    return Checkpoint::decode(bytes.subspan(offset + sizeof(size), size));
+}
+
+uint8_t Replay::card(uint32_t turn) const {
+    assert(turn < header_.turn_count);
+    const auto bytes = file_.bytes();
+    uint64_t offset;
+    std::memcpy(
+        &offset,
+        bytes.data() + header_.index_offset
+            + turn / header_.keyframe_interval * sizeof(offset),
+        sizeof(offset)
+    );
+    uint32_t size;
+    std::memcpy(&size, bytes.data() + offset, sizeof(size));
+    return static_cast<uint8_t>(
+        bytes[offset + sizeof(size) + size + turn % header_.keyframe_interval]
+    );
+}
+
+ReplayCursor::ReplayCursor(const Replay& replay) : replay_(replay) {
+    restore(0);
+}
+
+void ReplayCursor::seek(uint32_t turn) {
+    assert(turn <= replay_.turn_count());
+    const auto interval = replay_.keyframe_interval();
+    const auto last_keyframe = (replay_.turn_count() - 1) / interval;
+    const auto keyframe = std::min(turn / interval, last_keyframe);
+    if (turn < turn_ || turn_ < keyframe * interval) {
+        restore(keyframe);
+    }
+    while (turn_ < turn) {
+        next_card_ = replay_.card(turn_);
+        state_->update();
+        turn_ += 1;
+    }
+}
+
+void ReplayCursor::restore(uint32_t keyframe) {
+    const auto checkpoint = replay_.keyframe(keyframe);
+    std::vector<std::unique_ptr<Player>> players;
+    for (uint8_t seat = 0; seat < checkpoint.seat_count; seat += 1) {
+        players.push_back(std::make_unique<ReplayPlayer>(next_card_));
+    }
+    state_ = std::make_unique<State>(std::move(players), checkpoint);
+    turn_ = keyframe * replay_.keyframe_interval();
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "checkpoint.hpp"
+#include "mapped_file.hpp"
+#include "state.hpp"
+
+/// The header at the start of a replay file.
+///
+/// A replay records the turns of a game, a turn being a call to
+/// `State::update`, as the atlas index of the card played in each turn, or
+/// `NO_CARD` if none was. Every `keyframe_interval` turns, starting with the
+/// first, the turns are preceded by a keyframe: the size of an encoded
+/// `Checkpoint` of the table before the turn, and the checkpoint. An index
+/// of the offsets of the keyframes ends the file, at `index_offset`, so a
+/// turn is reached by restoring the keyframe before it and replaying at most
+/// `keyframe_interval` turns. Values are stored in native byte order.
+struct ReplayHeader {
+    static constexpr std::array<char, 8> MAGIC =
+        {'U', 'N', 'O', 'R', 'E', 'P', 'L', 'Y'};
+    static constexpr uint32_t VERSION = 1;
+
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t keyframe_interval;
+    uint32_t turn_count;
+    uint32_t keyframe_count;
+    uint64_t index_offset;
+    std::array<uint8_t, 32> reserved;
+};
+
+static_assert(sizeof(ReplayHeader) == 64);
+
+/// Records a game of official rules into a replay file, as the listener of
+/// its `State`:
+///
+///     ReplayWriter writer(path);
+///     State state(std::move(players), seed, writer);
+///     do {
+///         writer.begin_turn(state);
+///     } while (state.update() != AppState::GameOver);
+///     writer.finish();
+class ReplayWriter: public GameListener {
+  public:
+    /// Turns between keyframes, which bounds the turns replayed by a seek.
+    static constexpr uint32_t DEFAULT_KEYFRAME_INTERVAL = 32;
+
+    /// Creates the file. Throws `std::runtime_error` on failure.
+    explicit ReplayWriter(
+        const std::filesystem::path& path,
+        uint32_t keyframe_interval = DEFAULT_KEYFRAME_INTERVAL
+    );
+    /// Finishes the file, unless `finish` was called.
+    ~ReplayWriter();
+
+    /// Starts a turn of the game, which is about to be updated.
+    void begin_turn(const State& state);
+
+    void on_card_played(uint8_t, const Card& card) override {
+        assert(card_ == NO_CARD); // Official rules play one card per turn
+        card_ = card.atlas_index();
+    }
+
+    /// Writes the index and the header. Throws `std::runtime_error` on
+    /// failure.
+    void finish();
+
+    /// Stands for a turn in which no card was played.
+    static constexpr uint8_t NO_CARD = 0xFF;
+
+  private:
+    void end_turn();
+    void write_header(uint64_t index_offset);
+
+    std::ofstream file_;
+    uint32_t keyframe_interval_;
+    uint32_t turn_count_ = 0;
+    bool is_in_turn_ = false;
+    uint8_t card_ = NO_CARD; // Played in the current turn
+    std::vector<uint64_t> keyframe_offsets_;
+    Checkpoint checkpoint_; // Reused for every keyframe
+    std::string payload_;
+    bool finished_ = false;
+};
+
+/// A replay file, mapped into memory.
+class Replay {
+  public:
+    /// Opens the file. Throws `std::runtime_error` if it is not a replay.
+    explicit Replay(const std::filesystem::path& path);
+
+    /// Returns the number of turns of the game.
+    uint32_t turn_count() const noexcept {
+        return header_.turn_count;
+    }
+
+    uint32_t keyframe_interval() const noexcept {
+        return header_.keyframe_interval;
+    }
+
+    /// Returns the table before the turn of the keyframe.
+    Checkpoint keyframe(uint32_t index) const;
+
+    /// Returns the atlas index of the card played in the turn, or
+    /// `ReplayWriter::NO_CARD`.
+    uint8_t card(uint32_t turn) const;
+
+  private:
+    MappedFile file_;
+    ReplayHeader header_;
+};
+
+/// A game played back from a replay, which can be moved to any turn.
+class ReplayCursor {
+  public:
+    /// Starts before the first turn. The replay must outlive the cursor.
+    explicit ReplayCursor(const Replay& replay);
+
+    /// Moves to the table before the turn, or after the last turn for
+    /// `turn_count`. Going forward within the turns of a keyframe replays
+    /// the turns in between; otherwise the nearest keyframe is restored
+    /// first, so no seek replays more than `keyframe_interval` turns.
+    void seek(uint32_t turn);
+
+    uint32_t turn() const noexcept {
+        return turn_;
+    }
+
+    const State& state() const noexcept {
+        return *state_;
+    }
+
+  private:
+    void restore(uint32_t keyframe);
+
+    const Replay& replay_;
+    std::unique_ptr<State> state_;
+    uint32_t turn_ = 0;
+    uint8_t next_card_ = ReplayWriter::NO_CARD; // Read by the players
+};
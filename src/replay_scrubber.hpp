@@ -0,0 +1,87 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "input.hpp"
+#include "label.hpp"
+#include "sprite_batch.hpp"
+
+/// A bar along the bottom of the window to scrub through the turns of a
+/// replay: pressing or dragging on it picks the turn under the mouse, and
+/// every keyframe is marked with a tick.
+class ReplayScrubber {
+  public:
+    ReplayScrubber() : turn_text_("", 28) {
+        turn_text_.set_color(sf::Color::White);
+    }
+
+    /// Returns the turn picked with the mouse during the frame, if any,
+    /// among the turns from 0 to `turn_count`.
+    std::optional<uint32_t> update(const Input& input, uint32_t turn_count) {
+        if (input.left_click().has_value()) {
+            is_dragging_ = bar_.contains(*input.left_click());
+        }
+        if (!sf::Mouse::isButtonPressed(sf::Mouse::Button::Left)) {
+            is_dragging_ = false;
+        }
+        if (!is_dragging_ || bar_.size.x <= 0.f) {
+            return std::nullopt;
+        }
+        const auto fraction = std::clamp(
+            (input.mouse_position().x - bar_.position.x) / bar_.size.x,
+            0.f,
+            1.f
+        );
+        return static_cast<uint32_t>(std::lround(fraction * turn_count));
+    }
+
+    /// Renders the bar across the bottom of a window of the given size, with
+    /// the turn shown filled in.
+    void render(
+        SpriteBatch& batch,
+        sf::Vector2f window_size,
+        uint32_t turn,
+        uint32_t turn_count,
+        uint32_t keyframe_interval
+    ) {
+        constexpr float MARGIN = 40.f;
+        constexpr float HEIGHT = 16.f;
+        bar_ = sf::FloatRect(
+            {MARGIN, window_size.y - MARGIN - HEIGHT},
+            {window_size.x - 2 * MARGIN, HEIGHT}
+        );
+        batch.add(bar_, sf::Color(0, 0, 0, 160));
+        const auto scale = bar_.size.x / std::max<uint32_t>(turn_count, 1);
+        batch.add(
+            sf::FloatRect(bar_.position, {turn * scale, HEIGHT}),
+            sf::Color(230, 190, 40)
+        );
+        for (uint32_t keyframe = 0; keyframe <= turn_count;
+             keyframe += keyframe_interval) {
+            batch.add(
+                sf::FloatRect(
+                    {bar_.position.x + keyframe * scale - 1.f,
+                     bar_.position.y - 4.f},
+                    {2.f, 4.f}
+                ),
+                sf::Color::White
+            );
+        }
+
+        turn_text_.set_text(
+            "Turn " + std::to_string(turn) + " / " + std::to_string(turn_count)
+        );
+        turn_text_.setPosition({MARGIN, bar_.position.y - 44.f});
+        turn_text_.render(batch);
+    }
+
+  private:
+    sf::FloatRect bar_;
+    bool is_dragging_ = false;
+    Label turn_text_;
+};
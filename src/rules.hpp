@@ -0,0 +1,100 @@
+#pragma once
+
+#include <concepts>
+
+#include "card/action_card.hpp"
+#include "card/card.hpp"
+#include "card/wild_card.hpp"
+
+/// Draw penalties are applied to the next player as soon as they are played.
+struct NoStacking {
+    static constexpr bool enabled = false;
+};
+
+/// A Draw Two or Wild Draw Four may be answered with another draw card,
+/// passing the accumulated penalty on to the next player.
+struct Stacking {
+    static constexpr bool enabled = true;
+};
+
+/// A player without a playable card keeps drawing until they have one.
+struct DrawUntilPlayable {
+    static constexpr bool until_playable = true;
+};
+
+/// A player without a playable card draws once and passes if they still
+/// cannot play.
+struct DrawOneThenPass {
+    static constexpr bool until_playable = false;
+};
+
+/// Only the current player may play a card.
+struct NoJumpIn {
+    static constexpr bool enabled = false;
+};
+
+/// Any player holding a card identical to the top card may play it out of
+/// turn, and play continues from them.
+struct JumpIn {
+    static constexpr bool enabled = true;
+};
+
+/// Sevens and zeros have no special effect.
+struct NoSevenZero {
+    static constexpr bool enabled = false;
+};
+
+/// Playing a 7 swaps hands with another player, playing a 0 passes every hand
+/// on in the direction of play.
+struct SevenZero {
+    static constexpr bool enabled = true;
+};
+
+template <typename T>
+concept StackingPolicy = requires {
+    { T::enabled } -> std::convertible_to<bool>;
+};
+
+template <typename T>
+concept DrawPolicy = requires {
+    { T::until_playable } -> std::convertible_to<bool>;
+};
+
+template <typename T>
+concept JumpInPolicy = requires {
+    { T::enabled } -> std::convertible_to<bool>;
+};
+
+template <typename T>
+concept SevenZeroPolicy = requires {
+    { T::enabled } -> std::convertible_to<bool>;
+};
+
+/// A set of rule variants, resolved at compile time by the game engine.
+template <
+    StackingPolicy StackingRule,
+    DrawPolicy DrawRule,
+    JumpInPolicy JumpInRule,
+    SevenZeroPolicy SevenZeroRule>
+struct Rules {
+    static constexpr bool stacking = StackingRule::enabled;
+    static constexpr bool draw_until_playable = DrawRule::until_playable;
+    static constexpr bool jump_in = JumpInRule::enabled;
+    static constexpr bool seven_zero = SevenZeroRule::enabled;
+};
+
+using OfficialRules =
+    Rules<NoStacking, DrawUntilPlayable, NoJumpIn, NoSevenZero>;
+using HouseRules = Rules<Stacking, DrawOneThenPass, JumpIn, SevenZero>;
+
+/// Returns whether the card can answer a pending draw penalty on top.
+inline bool can_stack_on(const Card& card, const Card& top) noexcept {
+    if (auto wild_card = dynamic_cast<const WildCard*>(&card)) {
+        return wild_card->symbol() == WildSymbol::WildDrawFour;
+    }
+    const auto action_card = dynamic_cast<const ActionCard*>(&card);
+    const auto top_action_card = dynamic_cast<const ActionCard*>(&top);
+    return action_card && top_action_card
+        && action_card->symbol() == ActionSymbol::DrawTwo
+        && top_action_card->symbol() == ActionSymbol::DrawTwo;
+}
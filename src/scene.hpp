@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "animator.hpp"
+#include "player/ai_player.hpp"
+#include "player/local_player.hpp"
+#include "sprite_batch.hpp"
+#include "state.hpp"
+
+/// Colour behind the table of a scene, in place of the background image.
+const sf::Color SCENE_BACKGROUND(30, 90, 60);
+
+/// A still table to render in tests and benchmarks, the same on every run.
+struct SceneSpec {
+    unsigned int seed = 0;
+    uint8_t seat_count = 4;
+    size_t hand_size = 7;     // Cards in the local player's hand
+    size_t discard_count = 1; // Cards on the discard pile
+};
+
+/// Builds the table of a scene: the local player facing AI opponents, dealt
+/// from a deck shuffled with the seed.
+inline std::unique_ptr<State> build_scene(const SceneSpec& spec) {
+    std::vector<std::unique_ptr<Player>> players;
+    players.push_back(std::make_unique<LocalPlayer>());
+    while (players.size() < spec.seat_count) {
+        players.push_back(std::make_unique<AiPlayer>());
+    }
+    auto state = std::make_unique<State>(std::move(players), spec.seed);
+    state->stage(spec.hand_size, spec.discard_count);
+    return state;
+}
+
+/// Renders a frame of the table into a texture, without a window, and reads
+/// it back.
+inline sf::Image render_offscreen(const State& state, sf::Vector2u size) {
+    sf::RenderTexture texture(size);
+    SpriteBatch batch;
+    const Animator animator;
+    texture.clear(SCENE_BACKGROUND);
+    state.draw(texture, batch, animator);
+    texture.display();
+    return texture.getTexture().copyToImage();
+}
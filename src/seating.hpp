@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+constexpr uint8_t MIN_SEATS = 2;
+constexpr uint8_t MAX_SEATS = 10;
+
+enum class Direction : int8_t { Clockwise = 1, CounterClockwise = -1 };
+
+/// The seats around a table, whose turn it is and the direction of play.
+class Seating {
+  public:
+    Seating(
+        uint8_t count,
+        uint8_t current = 0,
+        Direction direction = Direction::Clockwise
+    ) :
+        count_(count),
+        current_(current),
+        direction_(direction) {
+        assert(count >= MIN_SEATS && count <= MAX_SEATS);
+        assert(current < count);
+    }
+
+    /// Returns the number of seats.
+    uint8_t count() const noexcept {
+        return count_;
+    }
+
+    /// Returns the seat of the current player.
+    uint8_t current() const noexcept {
+        return current_;
+    }
+
+    Direction direction() const noexcept {
+        return direction_;
+    }
+
+    /// Returns the seat the given number of turns after the current one.
+    uint8_t after(uint8_t steps) const noexcept {
+        assert(steps <= count_);
+        int seat = current_ + static_cast<int8_t>(direction_) * steps;
+        seat += seat < 0 ? count_ : 0;
+        seat -= seat >= count_ ? count_ : 0;
+        return static_cast<uint8_t>(seat);
+    }
+
+    /// Passes the turn to the next player.
+    void advance() noexcept {
+        current_ = after(1);
+    }
+
+    /// Passes the turn over the next player.
+    void skip() noexcept {
+        current_ = after(2);
+    }
+
+    void reverse() noexcept {
+        direction_ = static_cast<Direction>(-static_cast<int8_t>(direction_));
+    }
+
+    /// Gives the turn to the player at the given seat.
+    void seat(uint8_t seat) noexcept {
+        assert(seat < count_);
+        current_ = seat;
+    }
+
+  private:
+    uint8_t count_;
+    uint8_t current_;
+    Direction direction_;
+};
@@ -0,0 +1,305 @@
+#include "batch_engine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <span>
+
+namespace {
+/// Marks a running game without a playable card, as the index of the
+/// lowest set bit of an empty set.
+constexpr Face NO_FACE = 64;
+} // namespace
+
+template <typename Rng>
+BasicBatchEngine<Rng>::BasicBatchEngine(
+    size_t game_count,
+    uint8_t seat_count,
+    unsigned int first_seed
+) :
+    game_count_(game_count),
+    seat_count_(seat_count),
+    hands_(game_count * seat_count * HAND_STRIDE),
+    hand_faces_(game_count * seat_count),
+    hand_sizes_(game_count * seat_count),
+    decks_(game_count * DECK_SIZE),
+    deck_sizes_(game_count),
+    top_faces_(game_count),
+    top_colors_(game_count),
+    top_ranks_(game_count),
+    directions_(game_count, 1),
+    current_seats_(game_count, 0),
+    winners_(game_count, NO_WINNER),
+    turn_counts_(game_count),
+    actions_(game_count) {
+    rngs_.reserve(game_count);
+    running_.reserve(game_count);
+    for (size_t game = 0; game < game_count; game += 1) {
+        rngs_.emplace_back(first_seed + static_cast<unsigned int>(game));
+        for (uint8_t seat = 0; seat < seat_count; seat += 1) {
+            draw_to(game, seat, 7);
+        }
+
+        auto face = draw(game);
+        while (is_wild(face)) {
+            face = draw(game);
+        }
+        top_faces_[game] = face;
+        top_colors_[game] = face / RANKS_PER_COLOR;
+        top_ranks_[game] = face_rank(face);
+
+        running_.push_back(static_cast<uint32_t>(game));
+    }
+}
+
+template <typename Rng>
+size_t BasicBatchEngine<Rng>::step() {
+    if (policy_ != nullptr) {
+        choose_by_policy();
+    } else {
+        choose_lowest();
+    }
+
+    for (size_t i = 0; i < running_.size(); i += 1) {
+        play(running_[i], actions_[i]);
+    }
+
+    std::erase_if(running_, [&](uint32_t game) {
+        return winners_[game] != NO_WINNER;
+    });
+    return running_.size();
+}
+
+template <typename Rng>
+void BasicBatchEngine<Rng>::choose_lowest() {
+    // Pick the lowest playable face of every current hand, which is the first
+    // playable card of the sorted hand of an `AiPlayer`.
+    for (size_t i = 0; i < running_.size(); i += 1) {
+        const auto game = running_[i];
+        const auto player = game * seat_count_ + current_seats_[game];
+        const auto faces = hand_faces_[player] & playable_faces(game);
+        actions_[i].face = static_cast<Face>(std::countr_zero(faces));
+    }
+
+    // Players without a playable card draw until the drawn card is playable.
+    for (size_t i = 0; i < running_.size(); i += 1) {
+        if (actions_[i].face != NO_FACE) {
+            continue;
+        }
+        actions_[i].face = draw_playable(running_[i]);
+    }
+
+    // Wild cards do not count towards any color, so the color can be chosen
+    // before the card leaves the hand.
+    for (size_t i = 0; i < running_.size(); i += 1) {
+        const auto game = running_[i];
+        const auto face = actions_[i].face;
+        actions_[i].color = is_wild(face)
+            ? select_wild_color(game, current_seats_[game])
+            : face_color(face);
+    }
+}
+
+template <typename Rng>
+void BasicBatchEngine<Rng>::choose_by_policy() {
+    // Players without a playable card draw until they have one, then every
+    // player chooses among their playable cards.
+    observations_.clear();
+    for (const auto game : running_) {
+        const auto player = game * seat_count_ + current_seats_[game];
+        if ((hand_faces_[player] & playable_faces(game)) == 0) {
+            draw_playable(game);
+        }
+        observations_.push_back(observe(game));
+    }
+    policy_->choose(
+        observations_,
+        std::span(actions_).first(observations_.size())
+    );
+
+    // Whatever the policy does, the games go on.
+    for (size_t i = 0; i < running_.size(); i += 1) {
+        const auto game = running_[i];
+        const auto legal_faces = observations_[i].legal_faces;
+        auto& action = actions_[i];
+        if (action.face >= FACE_COUNT
+            || (legal_faces >> action.face & 1) == 0) {
+            action.face = static_cast<Face>(std::countr_zero(legal_faces));
+        }
+        if (!is_wild(action.face)) {
+            action.color = face_color(action.face);
+        } else if (static_cast<uint8_t>(action.color) >= COLOR_COUNT) {
+            action.color = select_wild_color(game, current_seats_[game]);
+        }
+    }
+}
+
+template <typename Rng>
+void BasicBatchEngine<Rng>::run() {
+    while (step() > 0) {
+    }
+}
+
+template <typename Rng>
+Observation BasicBatchEngine<Rng>::observe(size_t game) const {
+    const auto seat = current_seats_[game];
+    Observation observation {};
+    std::copy_n(
+        hands_.begin() + hand_index(game, seat),
+        FACE_COUNT,
+        observation.hand.begin()
+    );
+    for (uint8_t steps = 0; steps < seat_count_; steps += 1) {
+        const auto size = hand_size(game, seat_after(game, steps));
+        observation.hand_sizes[steps] =
+            static_cast<uint8_t>(std::min<uint16_t>(size, 255));
+    }
+    observation.legal_faces =
+        hand_faces_[game * seat_count_ + seat] & playable_faces(game);
+    observation.top_face = top_faces_[game];
+    observation.top_color = static_cast<Color>(top_colors_[game]);
+    observation.direction = direction(game);
+    observation.seat = seat;
+    observation.seat_count = seat_count_;
+    return observation;
+}
+
+template <typename Rng>
+uint64_t BasicBatchEngine<Rng>::playable_faces(size_t game) const {
+    return ::playable_faces(
+        static_cast<Color>(top_colors_[game]),
+        top_ranks_[game]
+    );
+}
+
+template <typename Rng>
+uint8_t BasicBatchEngine<Rng>::seat_after(size_t game, uint8_t steps)
+    const {
+    int seat = current_seats_[game] + directions_[game] * steps;
+    seat += seat < 0 ? seat_count_ : 0;
+    seat -= seat >= seat_count_ ? seat_count_ : 0;
+    return static_cast<uint8_t>(seat);
+}
+
+template <typename Rng>
+void BasicBatchEngine<Rng>::advance(size_t game) {
+    current_seats_[game] = seat_after(game, 1);
+}
+
+template <typename Rng>
+Face BasicBatchEngine<Rng>::draw(size_t game) {
+    auto& size = deck_sizes_[game];
+    const auto deck = std::span(decks_).subspan(game * DECK_SIZE, DECK_SIZE);
+    if (size == 0) {
+        // Like `Deck`, start over with a full shuffled deck.
+        std::ranges::copy(UNSHUFFLED_DECK, deck.begin());
+        std::ranges::shuffle(deck, rngs_[game]);
+        size = DECK_SIZE;
+    }
+    size -= 1;
+    return deck[size];
+}
+
+template <typename Rng>
+Face BasicBatchEngine<Rng>::draw_playable(size_t game) {
+    const auto playable = playable_faces(game);
+    Face face;
+    do {
+        face = draw_to(game, current_seats_[game]);
+    } while ((playable >> face & 1) == 0);
+    return face;
+}
+
+template <typename Rng>
+Face BasicBatchEngine<Rng>::draw_to(size_t game, uint8_t seat) {
+    const auto face = draw(game);
+    const auto player = game * seat_count_ + seat;
+    hands_[player * HAND_STRIDE + face] += 1;
+    hand_faces_[player] |= uint64_t {1} << face;
+    hand_sizes_[player] += 1;
+    return face;
+}
+
+template <typename Rng>
+void BasicBatchEngine<Rng>::draw_to(
+    size_t game,
+    uint8_t seat,
+    uint8_t count
+) {
+    for (uint8_t i = 0; i < count; i += 1) {
+        draw_to(game, seat);
+    }
+}
+
+template <typename Rng>
+void BasicBatchEngine<Rng>::play(size_t game, Action action) {
+    const auto [face, color] = action;
+    const auto seat = current_seats_[game];
+    const auto player = game * seat_count_ + seat;
+    if (listener_) {
+        listener_->on_play(game, observe(game), action);
+    }
+
+    auto& count = hands_[player * HAND_STRIDE + face];
+    count -= 1;
+    if (count == 0) {
+        hand_faces_[player] &= ~(uint64_t {1} << face);
+    }
+    hand_sizes_[player] -= 1;
+    turn_counts_[game] += 1;
+
+    if (hand_sizes_[player] == 0) {
+        winners_[game] = seat;
+        if (listener_) {
+            listener_->on_game_over(game, seat);
+        }
+        return;
+    }
+
+    top_faces_[game] = face;
+    top_colors_[game] = static_cast<uint8_t>(color);
+    top_ranks_[game] = face_rank(face);
+    switch (face_rank(face)) {
+        case WILD_RANK:
+            if (face == WILD_DRAW_FOUR_FACE) {
+                advance(game);
+                draw_to(game, current_seats_[game], 4);
+            }
+            break;
+        case DRAW_TWO_RANK:
+            advance(game);
+            draw_to(game, current_seats_[game], 2);
+            break;
+        case REVERSE_RANK:
+            directions_[game] = -directions_[game];
+            // With two players, a Reverse acts like a Skip.
+            if (seat_count_ == 2) {
+                advance(game);
+            }
+            break;
+        case SKIP_RANK:
+            advance(game);
+            break;
+    }
+    advance(game);
+}
+
+template <typename Rng>
+Color BasicBatchEngine<Rng>::select_wild_color(size_t game, uint8_t seat)
+    const {
+    // Choose the most common color in the hand, like `AiPlayer`.
+    const auto hand = &hands_[hand_index(game, seat)];
+    std::array<unsigned int, COLOR_COUNT> color_counts {};
+    for (uint8_t color = 0; color < COLOR_COUNT; color += 1) {
+        for (uint8_t rank = 0; rank < RANKS_PER_COLOR; rank += 1) {
+            color_counts[color] += hand[color * RANKS_PER_COLOR + rank];
+        }
+    }
+    return static_cast<Color>(std::distance(
+        color_counts.begin(),
+        std::ranges::max_element(color_counts)
+    ));
+}
+
+template class BasicBatchEngine<std::mt19937>;
+template class BasicBatchEngine<std::minstd_rand>;
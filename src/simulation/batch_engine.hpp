@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "../card/face.hpp"
+#include "../observation.hpp"
+
+/// Receives the moves of the games played by a batch engine.
+class BatchListener {
+  public:
+    virtual ~BatchListener() = default;
+
+    /// Called when the current player of the game plays a card.
+    virtual void on_play(size_t, const Observation&, Action) {}
+
+    /// Called when the player at the seat wins the game.
+    virtual void on_game_over(size_t, uint8_t) {}
+};
+
+/// Chooses the moves of the players of a batch engine, for many games at
+/// once.
+class BatchPolicy {
+  public:
+    virtual ~BatchPolicy() = default;
+
+    /// Chooses an action for each observation, each of which has at least
+    /// one legal face. Actions that are not legal are replaced by the lowest
+    /// legal face.
+    virtual void choose(
+        std::span<const Observation> observations,
+        std::span<Action> actions
+    ) = 0;
+};
+
+/// Plays many all-AI games under the official rules in lockstep.
+///
+/// Games are stored as structure of arrays: every hand is a vector of counts
+/// per face, so a turn reads and writes a handful of bytes per game instead
+/// of chasing card pointers. Game `i` is shuffled by an `Rng` seeded with
+/// `first_seed + i`; with `std::mt19937` it follows exactly the course of a
+/// `State` seated with `AiPlayer`s and the same seed.
+template <typename Rng>
+class BasicBatchEngine {
+  public:
+    static constexpr uint8_t NO_WINNER = 0xFF;
+
+    BasicBatchEngine(
+        size_t game_count,
+        uint8_t seat_count,
+        unsigned int first_seed
+    );
+
+    /// Plays one turn in every running game and returns the number of games
+    /// still running.
+    size_t step();
+
+    /// Plays every game to the end.
+    void run();
+
+    /// Reports every move to the listener, which must outlive the engine.
+    void set_listener(BatchListener* listener) noexcept {
+        listener_ = listener;
+    }
+
+    /// Lets the policy choose every move in place of the lowest playable
+    /// face. The policy must outlive the engine. A player without a playable
+    /// card still draws until they have one, then the policy chooses.
+    void set_policy(BatchPolicy* policy) noexcept {
+        policy_ = policy;
+    }
+
+    /// Returns what the current player of the game knows.
+    Observation observe(size_t game) const;
+
+    size_t game_count() const noexcept {
+        return game_count_;
+    }
+
+    uint8_t seat_count() const noexcept {
+        return seat_count_;
+    }
+
+    bool is_finished(size_t game) const {
+        return winners_[game] != NO_WINNER;
+    }
+
+    /// Returns the seat of the winner, or `NO_WINNER`.
+    uint8_t winner(size_t game) const {
+        return winners_[game];
+    }
+
+    uint8_t current_seat(size_t game) const {
+        return current_seats_[game];
+    }
+
+    Direction direction(size_t game) const {
+        return static_cast<Direction>(directions_[game]);
+    }
+
+    /// Returns the face of the top card of the discard pile.
+    Face top_face(size_t game) const {
+        return top_faces_[game];
+    }
+
+    /// Returns the color to play on, which is chosen for a wild top card.
+    Color top_color(size_t game) const {
+        return static_cast<Color>(top_colors_[game]);
+    }
+
+    uint16_t hand_size(size_t game, uint8_t seat) const {
+        return hand_sizes_[game * seat_count_ + seat];
+    }
+
+    /// Returns the number of copies of the face in the hand.
+    uint8_t count(size_t game, uint8_t seat, Face face) const {
+        return hands_[hand_index(game, seat) + face];
+    }
+
+    uint32_t turn_count(size_t game) const {
+        return turn_counts_[game];
+    }
+
+  private:
+    /// Each hand is padded to a cache line.
+    static constexpr size_t HAND_STRIDE = 64;
+
+    size_t hand_index(size_t game, uint8_t seat) const {
+        return (game * seat_count_ + seat) * HAND_STRIDE;
+    }
+
+    /// Returns the bit set of the faces that can be played on the top card.
+    uint64_t playable_faces(size_t game) const;
+
+    uint8_t seat_after(size_t game, uint8_t steps) const;
+    void advance(size_t game);
+
+    Face draw(size_t game);
+    /// Draws to the current player until a playable face, and returns it.
+    Face draw_playable(size_t game);
+    Face draw_to(size_t game, uint8_t seat);
+    void draw_to(size_t game, uint8_t seat, uint8_t count);
+    void choose_lowest();
+    void choose_by_policy();
+    void play(size_t game, Action action);
+    Color select_wild_color(size_t game, uint8_t seat) const;
+
+    size_t game_count_;
+    uint8_t seat_count_;
+
+    std::vector<uint8_t> hands_;         // Counts per face of every hand
+    std::vector<uint64_t> hand_faces_;   // Bit set of the faces in each hand
+    std::vector<uint16_t> hand_sizes_;   // Number of cards in each hand
+    std::vector<Face> decks_;            // Faces left in each deck
+    std::vector<uint8_t> deck_sizes_;    // Number of faces left in each deck
+    std::vector<Face> top_faces_;        // Face of the top card
+    std::vector<uint8_t> top_colors_;    // Color to play on
+    std::vector<uint8_t> top_ranks_;     // Rank to play on
+    std::vector<int8_t> directions_;     // Direction of play
+    std::vector<uint8_t> current_seats_; // Seat of the current player
+    std::vector<uint8_t> winners_;       // Seat of the winner, if any
+    std::vector<uint32_t> turn_counts_;  // Number of turns played
+    std::vector<Rng> rngs_;              // Deck shuffling
+
+    std::vector<uint32_t> running_; // Indices of the running games
+    std::vector<Action> actions_;   // Action chosen in each running game
+    /// Observation of each running game, for the policy.
+    std::vector<Observation> observations_;
+
+    BatchListener* listener_ = nullptr;
+    BatchPolicy* policy_ = nullptr;
+};
+
+extern template class BasicBatchEngine<std::mt19937>;
+extern template class BasicBatchEngine<std::minstd_rand>;
+
+/// Plays the same games as `State`.
+using BatchEngine = BasicBatchEngine<std::mt19937>;
+/// Plays other games with a much smaller random number generator per game.
+using FastBatchEngine = BasicBatchEngine<std::minstd_rand>;
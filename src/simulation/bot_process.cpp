@@ -0,0 +1,279 @@
+#include "bot_process.hpp"
+
+#include <stdexcept>
+
+#include "protocol.hpp"
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #include <fcntl.h>
+    #include <io.h>
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <csignal>
+    #include <ctime>
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <spawn.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace {
+[[noreturn]] void fail_to_start(const std::vector<std::string>& command) {
+    throw std::runtime_error("failed to start " + command.front());
+}
+
+#ifdef _WIN32
+/// Writes to a closed pipe fail without a signal on Windows.
+class SigpipeBlock {
+  public:
+    SigpipeBlock() noexcept {}
+};
+#else
+/// Blocks `SIGPIPE` on the calling thread while it lives, so that writing to
+/// a bot that exited fails with `EPIPE` instead of killing the engine, and
+/// takes back the signal such a write raised. The handler of the process
+/// is left alone.
+class SigpipeBlock {
+  public:
+    SigpipeBlock() noexcept {
+        sigemptyset(&sigpipe_);
+        sigaddset(&sigpipe_, SIGPIPE);
+        sigset_t pending;
+        sigpending(&pending);
+        was_pending_ = sigismember(&pending, SIGPIPE) == 1;
+        pthread_sigmask(SIG_BLOCK, &sigpipe_, &previous_);
+    }
+
+    ~SigpipeBlock() {
+        // A signal pending from before belongs to someone else.
+        if (!was_pending_) {
+            const timespec no_wait {0, 0};
+            while (sigtimedwait(&sigpipe_, nullptr, &no_wait) == -1
+                   && errno == EINTR) {
+            }
+        }
+        pthread_sigmask(SIG_SETMASK, &previous_, nullptr);
+    }
+
+    SigpipeBlock(const SigpipeBlock&) = delete;
+    SigpipeBlock& operator=(const SigpipeBlock&) = delete;
+
+  private:
+    sigset_t sigpipe_;
+    sigset_t previous_;
+    bool was_pending_;
+};
+
+/// Opens a pipe whose ends are closed on exec, so that other children,
+/// such as other bots, do not hold them and each bot sees the end of its
+/// input when its engine goes away.
+int open_pipe(int fds[2]) noexcept {
+    #ifdef __APPLE__
+    // No `pipe2`: a child spawned by another thread in between may inherit
+    // the pipe.
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return 0;
+    #else
+    return pipe2(fds, O_CLOEXEC);
+    #endif
+}
+#endif
+} // namespace
+
+#ifdef _WIN32
+void BotProcess::start(const std::vector<std::string>& command) {
+    std::string command_line;
+    for (const auto& argument : command) {
+        command_line += command_line.empty() ? "\"" : " \"";
+        command_line += argument;
+        command_line += '"';
+    }
+
+    SECURITY_ATTRIBUTES attributes {sizeof(attributes), nullptr, TRUE};
+    HANDLE child_input;
+    HANDLE to_child;
+    HANDLE from_child;
+    HANDLE child_output;
+    if (!CreatePipe(&child_input, &to_child, &attributes, 0)) {
+        fail_to_start(command);
+    }
+    if (!CreatePipe(&from_child, &child_output, &attributes, 0)) {
+        CloseHandle(child_input);
+        CloseHandle(to_child);
+        fail_to_start(command);
+    }
+    // Only the ends of the child are inherited.
+    SetHandleInformation(to_child, HANDLE_FLAG_INHERIT, 0);
+    SetHandleInformation(from_child, HANDLE_FLAG_INHERIT, 0);
+
+    STARTUPINFOA startup {};
+    startup.cb = sizeof(startup);
+    startup.dwFlags = STARTF_USESTDHANDLES;
+    startup.hStdInput = child_input;
+    startup.hStdOutput = child_output;
+    startup.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+    PROCESS_INFORMATION process {};
+    const auto started = CreateProcessA(
+        nullptr,
+        command_line.data(),
+        nullptr,
+        nullptr,
+        TRUE,
+        0,
+        nullptr,
+        nullptr,
+        &startup,
+        &process
+    );
+    CloseHandle(child_input);
+    CloseHandle(child_output);
+    if (!started) {
+        CloseHandle(to_child);
+        CloseHandle(from_child);
+        fail_to_start(command);
+    }
+    CloseHandle(process.hThread);
+    process_ = process.hProcess;
+    to_bot_ = _fdopen(
+        _open_osfhandle(reinterpret_cast<intptr_t>(to_child), _O_WRONLY),
+        "wb"
+    );
+    from_bot_ = _fdopen(
+        _open_osfhandle(reinterpret_cast<intptr_t>(from_child), _O_RDONLY),
+        "rb"
+    );
+}
+#else
+void BotProcess::start(const std::vector<std::string>& command) {
+    int to_child[2];
+    int from_child[2];
+    if (open_pipe(to_child) != 0) {
+        fail_to_start(command);
+    }
+    if (open_pipe(from_child) != 0) {
+        ::close(to_child[0]);
+        ::close(to_child[1]);
+        fail_to_start(command);
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, to_child[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, from_child[1], STDOUT_FILENO);
+    std::vector<char*> arguments;
+    for (const auto& argument : command) {
+        arguments.push_back(const_cast<char*>(argument.c_str()));
+    }
+    arguments.push_back(nullptr);
+    pid_t pid;
+    const int error = posix_spawnp(
+        &pid,
+        arguments[0],
+        &actions,
+        nullptr,
+        arguments.data(),
+        environ
+    );
+    posix_spawn_file_actions_destroy(&actions);
+    ::close(to_child[0]);
+    ::close(from_child[1]);
+    if (error != 0) {
+        ::close(to_child[1]);
+        ::close(from_child[0]);
+        fail_to_start(command);
+    }
+    process_ = pid;
+    to_bot_ = fdopen(to_child[1], "w");
+    from_bot_ = fdopen(from_child[0], "r");
+}
+#endif
+
+BotProcess::BotProcess(const std::vector<std::string>& command) {
+    if (command.empty()) {
+        throw std::runtime_error("no bot command");
+    }
+    name_ = command.front();
+    start(command);
+    try {
+        message_ = "uno " + std::to_string(PROTOCOL_VERSION) + "\n";
+        send();
+        receive();
+        if (line_ != "ok" && !line_.starts_with("ok ")) {
+            throw std::runtime_error(
+                command.front() + " does not speak the protocol"
+            );
+        }
+        if (line_.size() > 3) {
+            name_ = line_.substr(3);
+        }
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+
+BotProcess::~BotProcess() {
+    close();
+}
+
+void BotProcess::choose(
+    std::span<const Observation> observations,
+    std::span<Action> actions
+) {
+    message_ = "positions " + std::to_string(observations.size()) + "\n";
+    for (const auto& observation : observations) {
+        write_position(message_, observation);
+    }
+    send();
+    receive();
+    parse_moves(line_, actions.first(observations.size()));
+}
+
+void BotProcess::send() {
+    const SigpipeBlock sigpipe_block;
+    if (std::fwrite(message_.data(), 1, message_.size(), to_bot_)
+            != message_.size()
+        || std::fflush(to_bot_) != 0) {
+        throw std::runtime_error("bot " + name_ + " exited");
+    }
+}
+
+void BotProcess::receive() {
+    if (!read_line(from_bot_, line_)) {
+        throw std::runtime_error("bot " + name_ + " exited");
+    }
+}
+
+void BotProcess::close() noexcept {
+    if (to_bot_ != nullptr) {
+        const SigpipeBlock sigpipe_block;
+        std::fputs("quit\n", to_bot_);
+        std::fclose(to_bot_);
+        to_bot_ = nullptr;
+    }
+    if (from_bot_ != nullptr) {
+        std::fclose(from_bot_);
+        from_bot_ = nullptr;
+    }
+#ifdef _WIN32
+    if (process_ != nullptr) {
+        WaitForSingleObject(process_, INFINITE);
+        CloseHandle(process_);
+        process_ = nullptr;
+    }
+#else
+    if (process_ != -1) {
+        waitpid(process_, nullptr, 0);
+        process_ = -1;
+    }
+#endif
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "batch_engine.hpp"
+
+/// An external bot, run as a child process that speaks the protocol of
+/// `protocol.hpp` on its standard input and output.
+///
+/// Each call to `choose` is one round trip through the pipes, however many
+/// positions it holds. A bot that exits makes the next call throw: `SIGPIPE`
+/// is blocked on the calling thread around writes, and the signal handlers
+/// of the process are left as they are.
+class BotProcess: public BatchPolicy {
+  public:
+    /// Starts the program with its arguments, and checks that it speaks the
+    /// protocol. Throws `std::runtime_error` if it does not start or answer.
+    explicit BotProcess(const std::vector<std::string>& command);
+    ~BotProcess();
+
+    BotProcess(const BotProcess&) = delete;
+    BotProcess& operator=(const BotProcess&) = delete;
+
+    /// Returns the name the bot gave.
+    std::string_view name() const noexcept {
+        return name_;
+    }
+
+    /// Sends the positions in one message and reads back their moves.
+    /// Throws `std::runtime_error` if the bot exits or answers nonsense.
+    void choose(
+        std::span<const Observation> observations,
+        std::span<Action> actions
+    ) override;
+
+  private:
+    /// Starts the child process with pipes to its standard input and output.
+    void start(const std::vector<std::string>& command);
+    void send();
+    void receive();
+    /// Tells the bot to quit and waits for it.
+    void close() noexcept;
+
+    std::FILE* to_bot_ = nullptr;
+    std::FILE* from_bot_ = nullptr;
+#ifdef _WIN32
+    void* process_ = nullptr;
+#else
+    int process_ = -1;
+#endif
+    std::string name_;
+    std::string message_; // Reused for every message
+    std::string line_;    // Reused for every answer
+};
@@ -0,0 +1,164 @@
+#include "dataset.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+DatasetWriter::DatasetWriter(
+    const std::filesystem::path& path,
+    uint32_t block_rows
+) :
+    file_(path, std::ios::binary | std::ios::trunc),
+    block_rows_(block_rows),
+    block_(block_rows * ROW_WIDTH) {
+    assert(block_rows > 0 && block_rows % 64 == 0);
+    if (!file_) {
+        throw std::runtime_error("failed to create " + path.string());
+    }
+    // Reserve the header, which is written once the row count is known.
+    write_header();
+}
+
+DatasetWriter::~DatasetWriter() {
+    if (!finished_) {
+        try {
+            finish();
+        } catch (const std::runtime_error&) {
+            // Only an explicit call to `finish` can report the failure.
+        }
+    }
+}
+
+void DatasetWriter::begin_batch(size_t game_count) {
+    first_game_ += static_cast<uint32_t>(moves_.size());
+    moves_.resize(game_count);
+    for (auto& moves : moves_) {
+        moves.clear();
+    }
+}
+
+void DatasetWriter::on_play(
+    size_t game,
+    const Observation& observation,
+    Action action
+) {
+    moves_[game].push_back({observation, action});
+}
+
+void DatasetWriter::on_game_over(size_t game, uint8_t winner) {
+    const auto& moves = moves_[game];
+    for (size_t turn = 0; turn < moves.size(); turn += 1) {
+        write_row(
+            first_game_ + static_cast<uint32_t>(game),
+            static_cast<uint32_t>(turn),
+            moves[turn],
+            winner
+        );
+    }
+    moves_[game].clear();
+}
+
+void DatasetWriter::finish() {
+    if (block_size_ > 0) {
+        write_block();
+    }
+    file_.seekp(0);
+    write_header();
+    file_.close();
+    finished_ = true;
+    if (!file_) {
+        throw std::runtime_error("failed to write dataset");
+    }
+}
+
+void DatasetWriter::write_row(
+    uint32_t game,
+    uint32_t turn,
+    const Move& move,
+    uint8_t winner
+) {
+    const auto& observation = move.observation;
+    put(Column::Game, game);
+    put(Column::Turn, turn);
+    put(Column::Seat, observation.seat);
+    put(Column::SeatCount, observation.seat_count);
+    put(Column::Hand, observation.hand);
+    put(Column::HandSizes, observation.hand_sizes);
+    put(Column::LegalFaces, observation.legal_faces);
+    put(Column::TopFace, observation.top_face);
+    put(Column::TopColor, observation.top_color);
+    put(Column::PlayDirection, observation.direction);
+    put(Column::PendingDraw, observation.pending_draw);
+    put(Column::ActionFace, move.action.face);
+    put(Column::ActionColor, move.action.color);
+    put(Column::Winner, winner);
+
+    block_size_ += 1;
+    row_count_ += 1;
+    if (block_size_ == block_rows_) {
+        write_block();
+    }
+}
+
+void DatasetWriter::write_block() {
+    // Clear the unused rows of the last block, so that the file is
+    // reproducible.
+    for (size_t column = 0; column < COLUMN_COUNT; column += 1) {
+        const auto width = COLUMN_WIDTHS[column];
+        const auto start = column_start(static_cast<Column>(column));
+        std::fill(
+            block_.begin() + start * block_rows_ + block_size_ * width,
+            block_.begin() + (start + width) * block_rows_,
+            std::byte {0}
+        );
+    }
+    file_.write(
+        reinterpret_cast<const char*>(block_.data()),
+        static_cast<std::streamsize>(block_.size())
+    );
+    if (!file_) {
+        throw std::runtime_error("failed to write dataset");
+    }
+    block_size_ = 0;
+}
+
+void DatasetWriter::write_header() {
+    DatasetHeader header {};
+    header.magic = DatasetHeader::MAGIC;
+    header.version = DatasetHeader::VERSION;
+    header.block_rows = block_rows_;
+    header.row_count = row_count_;
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+DatasetReader::DatasetReader(const std::filesystem::path& path) :
+    file_(path) {
+    const auto bytes = file_.bytes();
+    if (bytes.size() < sizeof(DatasetHeader)) {
+        throw std::runtime_error(path.string() + " is not a dataset");
+    }
+    std::memcpy(&header_, bytes.data(), sizeof(header_));
+    if (header_.magic != DatasetHeader::MAGIC) {
+        throw std::runtime_error(path.string() + " is not a dataset");
+    }
+    if (header_.version != DatasetHeader::VERSION) {
+        throw std::runtime_error(
+            path.string() + " has an unsupported dataset version"
+        );
+    }
+    if (header_.block_rows == 0 || header_.block_rows % 64 != 0
+        || bytes.size() < sizeof(DatasetHeader)
+                + block_count() * header_.block_rows * ROW_WIDTH) {
+        throw std::runtime_error(path.string() + " is truncated");
+    }
+}
+
+DatasetBlock DatasetReader::block(size_t index) const {
+    assert(index < block_count());
+    const auto block_bytes = size_t {header_.block_rows} * ROW_WIDTH;
+    const auto first_row = index * header_.block_rows;
+    return DatasetBlock(
+        file_.bytes().data() + sizeof(DatasetHeader) + index * block_bytes,
+        header_.block_rows,
+        std::min<size_t>(header_.block_rows, header_.row_count - first_row)
+    );
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#include "../mapped_file.hpp"
+#include "../observation.hpp"
+#include "batch_engine.hpp"
+
+/// The columns of a self-play dataset, one row per card played.
+enum class Column : uint8_t {
+    Game,          // uint32_t
+    Turn,          // uint32_t, counted from 0 in each game
+    Seat,          // uint8_t
+    SeatCount,     // uint8_t
+    Hand,          // uint8_t[FACE_COUNT]
+    HandSizes,     // uint8_t[MAX_SEATS]
+    LegalFaces,    // uint64_t
+    TopFace,       // Face
+    TopColor,      // Color
+    PlayDirection, // Direction
+    PendingDraw,   // uint8_t
+    ActionFace,    // Face
+    ActionColor,   // Color
+    Winner,        // uint8_t, seat of the winner of the game
+};
+
+constexpr size_t COLUMN_COUNT = 14;
+
+/// Width of a value of each column in bytes.
+constexpr std::array<size_t, COLUMN_COUNT> COLUMN_WIDTHS = {
+    sizeof(uint32_t),
+    sizeof(uint32_t),
+    sizeof(uint8_t),
+    sizeof(uint8_t),
+    FACE_COUNT,
+    MAX_SEATS,
+    sizeof(uint64_t),
+    sizeof(Face),
+    sizeof(Color),
+    sizeof(Direction),
+    sizeof(uint8_t),
+    sizeof(Face),
+    sizeof(Color),
+    sizeof(uint8_t),
+};
+
+/// Returns the width of all columns before the given one.
+constexpr size_t column_start(Column column) {
+    size_t start = 0;
+    for (size_t i = 0; i < static_cast<size_t>(column); i += 1) {
+        start += COLUMN_WIDTHS[i];
+    }
+    return start;
+}
+
+/// Width of a row in bytes.
+constexpr size_t ROW_WIDTH = column_start(Column::Winner)
+    + COLUMN_WIDTHS[static_cast<size_t>(Column::Winner)];
+
+/// The header at the start of a dataset file.
+///
+/// It is followed by blocks of `block_rows` rows. Each block stores its
+/// columns one after another, and the last block is padded to full size, so
+/// block `i` starts at `sizeof(DatasetHeader) + i * block_rows * ROW_WIDTH`.
+/// Values are stored in native byte order.
+struct DatasetHeader {
+    static constexpr std::array<char, 8> MAGIC =
+        {'U', 'N', 'O', 'D', 'A', 'T', 'A', '\0'};
+    static constexpr uint32_t VERSION = 1;
+
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t block_rows;
+    uint64_t row_count;
+    std::array<uint8_t, 40> reserved;
+};
+
+static_assert(sizeof(DatasetHeader) == 64);
+
+/// Streams the moves of self-play games played by a batch engine into a
+/// dataset file. Moves are held back until their game ends, so that every row
+/// records the outcome.
+class DatasetWriter: public BatchListener {
+  public:
+    /// Block size, a multiple of 64 so that every column stays aligned.
+    static constexpr uint32_t DEFAULT_BLOCK_ROWS = 64 * 1024;
+
+    /// Creates the file. Throws `std::runtime_error` on failure.
+    DatasetWriter(
+        const std::filesystem::path& path,
+        uint32_t block_rows = DEFAULT_BLOCK_ROWS
+    );
+
+    /// Finishes the file if `finish` has not been called.
+    ~DatasetWriter() override;
+
+    /// Prepares for the games of the next batch, which are numbered after the
+    /// games of the previous one.
+    void begin_batch(size_t game_count);
+
+    void on_play(size_t game, const Observation& observation, Action action)
+        override;
+
+    void on_game_over(size_t game, uint8_t winner) override;
+
+    /// Writes the last block and the final row count. Throws
+    /// `std::runtime_error` on failure.
+    void finish();
+
+    uint64_t row_count() const noexcept {
+        return row_count_;
+    }
+
+  private:
+    struct Move {
+        Observation observation;
+        Action action;
+    };
+
+    void write_row(uint32_t game, uint32_t turn, const Move& move, uint8_t);
+    void write_block();
+    void write_header();
+
+    template <typename T>
+    void put(Column column, const T& value) {
+        const auto index = static_cast<size_t>(column);
+        assert(sizeof(T) == COLUMN_WIDTHS[index]);
+        const auto offset = column_start(column) * block_rows_
+            + block_size_ * COLUMN_WIDTHS[index];
+        std::memcpy(block_.data() + offset, &value, sizeof(T));
+    }
+
+    std::ofstream file_;
+    uint32_t block_rows_;
+    std::vector<std::byte> block_;
+    uint32_t block_size_ = 0; // Rows in the current block
+    uint64_t row_count_ = 0;
+    bool finished_ = false;
+
+    uint32_t first_game_ = 0; // Number of the first game of the batch
+    std::vector<std::vector<Move>> moves_; // Moves of the unfinished games
+};
+
+/// A block of rows, whose columns point into a mapped dataset.
+class DatasetBlock {
+  public:
+    DatasetBlock(const std::byte* data, uint32_t block_rows, size_t row_count) :
+        data_(data),
+        block_rows_(block_rows),
+        row_count_(row_count) {}
+
+    size_t row_count() const noexcept {
+        return row_count_;
+    }
+
+    std::span<const uint32_t> games() const {
+        return column<uint32_t>(Column::Game);
+    }
+
+    std::span<const uint32_t> turns() const {
+        return column<uint32_t>(Column::Turn);
+    }
+
+    std::span<const uint8_t> seats() const {
+        return column<uint8_t>(Column::Seat);
+    }
+
+    std::span<const uint8_t> seat_counts() const {
+        return column<uint8_t>(Column::SeatCount);
+    }
+
+    std::span<const std::array<uint8_t, FACE_COUNT>> hands() const {
+        return column<std::array<uint8_t, FACE_COUNT>>(Column::Hand);
+    }
+
+    std::span<const std::array<uint8_t, MAX_SEATS>> hand_sizes() const {
+        return column<std::array<uint8_t, MAX_SEATS>>(Column::HandSizes);
+    }
+
+    std::span<const uint64_t> legal_faces() const {
+        return column<uint64_t>(Column::LegalFaces);
+    }
+
+    std::span<const Face> top_faces() const {
+        return column<Face>(Column::TopFace);
+    }
+
+    std::span<const Color> top_colors() const {
+        return column<Color>(Column::TopColor);
+    }
+
+    std::span<const Direction> directions() const {
+        return column<Direction>(Column::PlayDirection);
+    }
+
+    std::span<const uint8_t> pending_draws() const {
+        return column<uint8_t>(Column::PendingDraw);
+    }
+
+    std::span<const Face> action_faces() const {
+        return column<Face>(Column::ActionFace);
+    }
+
+    std::span<const Color> action_colors() const {
+        return column<Color>(Column::ActionColor);
+    }
+
+    std::span<const uint8_t> winners() const {
+        return column<uint8_t>(Column::Winner);
+    }
+
+  private:
+    template <typename T>
+    std::span<const T> column(Column column) const {
+        assert(sizeof(T) == COLUMN_WIDTHS[static_cast<size_t>(column)]);
+        const auto values = data_ + column_start(column) * block_rows_;
+        return {reinterpret_cast<const T*>(values), row_count_};
+    }
+
+    const std::byte* data_;
+    uint32_t block_rows_;
+    size_t row_count_;
+};
+
+/// Reads a dataset by mapping it into memory, without copying any rows.
+class DatasetReader {
+  public:
+    /// Maps the file. Throws `std::runtime_error` if it is not a valid
+    /// dataset.
+    explicit DatasetReader(const std::filesystem::path& path);
+
+    uint64_t row_count() const noexcept {
+        return header_.row_count;
+    }
+
+    size_t block_count() const noexcept {
+        return (header_.row_count + header_.block_rows - 1)
+            / header_.block_rows;
+    }
+
+    DatasetBlock block(size_t index) const;
+
+  private:
+    MappedFile file_;
+    DatasetHeader header_;
+};
@@ -0,0 +1,226 @@
+#include "protocol.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+constexpr std::string_view HEX_DIGITS = "0123456789abcdef";
+
+/// Appends a number, in hexadecimal if `base` is 16.
+template <typename T>
+void append_number(std::string& out, T value, int base = 10) {
+    char buffer[24];
+    const auto end = std::to_chars(buffer, std::end(buffer), value, base).ptr;
+    out.append(buffer, end);
+}
+
+/// Splits a line into the fields separated by spaces.
+class Fields {
+  public:
+    explicit Fields(std::string_view line) : line_(line), rest_(line) {}
+
+    bool empty() const noexcept {
+        return rest_.find_first_not_of(' ') == std::string_view::npos;
+    }
+
+    /// Returns the next field.
+    std::string_view next() {
+        const auto start = rest_.find_first_not_of(' ');
+        if (start == std::string_view::npos) {
+            malformed();
+        }
+        rest_.remove_prefix(start);
+        const auto field = rest_.substr(0, rest_.find(' '));
+        rest_.remove_prefix(field.size());
+        return field;
+    }
+
+    /// Returns the next field as a number of at most `max`.
+    template <typename T>
+    T number(T max = std::numeric_limits<T>::max(), int base = 10) {
+        return parse_number(next(), max, base);
+    }
+
+    /// Parses a number of at most `max` out of the line.
+    template <typename T>
+    T parse_number(std::string_view field, T max, int base = 10) const {
+        T value;
+        const auto end = field.data() + field.size();
+        const auto [ptr, error] =
+            std::from_chars(field.data(), end, value, base);
+        if (error != std::errc() || ptr != end || value > max) {
+            malformed();
+        }
+        return value;
+    }
+
+    [[noreturn]] void malformed() const {
+        throw std::runtime_error("malformed line: " + std::string(line_));
+    }
+
+  private:
+    std::string_view line_;
+    std::string_view rest_;
+};
+} // namespace
+
+void write_position(std::string& out, const Observation& observation) {
+    append_number(out, observation.seat);
+    out.push_back(' ');
+    append_number(out, observation.seat_count);
+    out.push_back(' ');
+    append_number(out, static_cast<int8_t>(observation.direction));
+    out.push_back(' ');
+    append_number(out, observation.top_face);
+    out.push_back(' ');
+    append_number(out, static_cast<uint8_t>(observation.top_color));
+    out.push_back(' ');
+    append_number(out, observation.pending_draw);
+    out.push_back(' ');
+    append_number(out, observation.legal_faces, 16);
+    out.push_back(' ');
+    // Copies beyond 15 only come from refilled decks in very long games.
+    for (const auto count : observation.hand) {
+        out.push_back(HEX_DIGITS[std::min<uint8_t>(count, 15)]);
+    }
+    for (uint8_t i = 0; i < observation.seat_count; i += 1) {
+        out.push_back(' ');
+        append_number(out, observation.hand_sizes[i]);
+    }
+    out.push_back('\n');
+}
+
+Observation parse_position(std::string_view line) {
+    Fields fields(line);
+    Observation observation {};
+    observation.seat = fields.number<uint8_t>(MAX_SEATS - 1);
+    observation.seat_count = fields.number<uint8_t>(MAX_SEATS);
+    const auto direction = fields.number<int8_t>(1);
+    observation.top_face = fields.number<uint8_t>(FACE_COUNT - 1);
+    observation.top_color =
+        static_cast<Color>(fields.number<uint8_t>(COLOR_COUNT - 1));
+    observation.pending_draw = fields.number<uint8_t>();
+    observation.legal_faces = fields.number<uint64_t>(
+        (uint64_t {1} << FACE_COUNT) - 1,
+        16
+    );
+    if (observation.seat_count < MIN_SEATS
+        || observation.seat >= observation.seat_count
+        || (direction != 1 && direction != -1)) {
+        fields.malformed();
+    }
+    observation.direction = static_cast<Direction>(direction);
+
+    const auto hand = fields.next();
+    if (hand.size() != FACE_COUNT) {
+        fields.malformed();
+    }
+    for (Face face = 0; face < FACE_COUNT; face += 1) {
+        observation.hand[face] =
+            fields.parse_number<uint8_t>(hand.substr(face, 1), 15, 16);
+    }
+    for (uint8_t i = 0; i < observation.seat_count; i += 1) {
+        observation.hand_sizes[i] = fields.number<uint8_t>();
+    }
+    if (!fields.empty()) {
+        fields.malformed();
+    }
+    return observation;
+}
+
+void write_moves(std::string& out, std::span<const Action> actions) {
+    out += "moves";
+    for (const auto [face, color] : actions) {
+        out.push_back(' ');
+        append_number(out, face);
+        out.push_back(':');
+        append_number(out, static_cast<uint8_t>(color));
+    }
+    out.push_back('\n');
+}
+
+void parse_moves(std::string_view line, std::span<Action> actions) {
+    Fields fields(line);
+    if (fields.next() != "moves") {
+        fields.malformed();
+    }
+    for (auto& action : actions) {
+        const auto move = fields.next();
+        const auto colon = move.find(':');
+        if (colon == std::string_view::npos) {
+            fields.malformed();
+        }
+        // Out-of-range moves are left for the engine to replace.
+        action.face = fields.parse_number<uint8_t>(
+            move.substr(0, colon),
+            std::numeric_limits<uint8_t>::max()
+        );
+        action.color = static_cast<Color>(fields.parse_number<uint8_t>(
+            move.substr(colon + 1),
+            std::numeric_limits<uint8_t>::max()
+        ));
+    }
+    if (!fields.empty()) {
+        fields.malformed();
+    }
+}
+
+void serve_protocol(
+    std::string_view name,
+    const std::function<Action(const Observation&)>& choose
+) {
+    std::string line;
+    std::string out;
+    std::vector<Action> actions;
+    while (read_line(stdin, line)) {
+        Fields fields(line);
+        if (fields.empty()) {
+            continue;
+        }
+        const auto command = fields.next();
+        out.clear();
+        if (command == "uno") {
+            if (fields.number<int>() != PROTOCOL_VERSION) {
+                throw std::runtime_error("unsupported protocol version");
+            }
+            out += "ok ";
+            out += name;
+            out.push_back('\n');
+        } else if (command == "positions") {
+            actions.resize(fields.number<size_t>());
+            for (auto& action : actions) {
+                if (!read_line(stdin, line)) {
+                    throw std::runtime_error("truncated positions");
+                }
+                action = choose(parse_position(line));
+            }
+            write_moves(out, actions);
+        } else if (command == "quit") {
+            return;
+        } else {
+            fields.malformed();
+        }
+        std::fwrite(out.data(), 1, out.size(), stdout);
+        std::fflush(stdout);
+    }
+}
+
+bool read_line(std::FILE* file, std::string& line) {
+    line.clear();
+    char buffer[4096];
+    while (std::fgets(buffer, sizeof(buffer), file) != nullptr) {
+        line += buffer;
+        if (line.back() == '\n') {
+            line.pop_back();
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return true;
+        }
+    }
+    return !line.empty();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "../observation.hpp"
+
+/// The protocol between the engine and an external bot, which runs as a
+/// child process and reads commands on its standard input. Every command and
+/// answer is a line of ASCII text, with fields separated by spaces.
+///
+/// - `uno <version>`: sent first. The bot answers `ok <name>`.
+/// - `positions <n>`: followed by `n` lines of one position each. The bot
+///   answers a single line `moves <face>:<color> ...` with a move for each
+///   position, in order. Many positions in one message amortize the cost of
+///   the pipe.
+/// - `quit`: sent last. The bot exits without answering.
+///
+/// A position is what the current player knows, like `Observation`:
+///
+///     <seat> <seat count> <direction> <top face> <top color> <pending draw>
+///     <legal faces> <hand> <hand size>...
+///
+/// The direction is 1 clockwise or -1 counterclockwise. The legal faces are
+/// a bit set in hexadecimal. The hand has one hexadecimal digit per face,
+/// the number of copies held up to 15. The hand sizes are by seat, starting
+/// with the player and following the direction of play, one for every seat.
+/// Faces and colors are numbered as in `uno_plugin.h`.
+constexpr int PROTOCOL_VERSION = 1;
+
+/// Appends a position, followed by a newline.
+void write_position(std::string& out, const Observation& observation);
+
+/// Parses a position. Throws `std::runtime_error` if it is malformed.
+Observation parse_position(std::string_view line);
+
+/// Appends a `moves` answer, followed by a newline.
+void write_moves(std::string& out, std::span<const Action> actions);
+
+/// Parses a `moves` answer into `actions`. Throws `std::runtime_error` if it
+/// is malformed or does not hold one move per action.
+void parse_moves(std::string_view line, std::span<Action> actions);
+
+/// Answers the commands of the protocol on the standard input and output
+/// until `quit` or the end of the input, as a bot called `name` playing the
+/// moves of `choose`. Throws `std::runtime_error` on a malformed command.
+void serve_protocol(
+    std::string_view name,
+    const std::function<Action(const Observation&)>& choose
+);
+
+/// Reads a line without its newline. Returns false at the end of the file.
+bool read_line(std::FILE* file, std::string& line);
@@ -0,0 +1,198 @@
+#include "tournament.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+#include "../state.hpp"
+
+namespace {
+/// Iterations of the rating fit, far more than it needs to settle.
+constexpr size_t RATING_ITERATIONS = 1'000;
+
+/// Returns the expected score of a player rated `elo` above their opponent.
+double expected_score(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+/// Returns the Elo difference expected to score `score`, which is kept away
+/// from a clean sweep so that the difference stays finite.
+double elo_of_score(double score) {
+    constexpr double EPSILON = 1e-6;
+    score = std::clamp(score, EPSILON, 1.0 - EPSILON);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+} // namespace
+
+EloEstimate estimate_elo(size_t wins, size_t losses) {
+    const auto game_count = wins + losses;
+    if (game_count == 0) {
+        constexpr auto INF = std::numeric_limits<double>::infinity();
+        return {0.0, -INF, INF};
+    }
+    const auto score = static_cast<double>(wins) / game_count;
+    // The normal approximation of the score, 1.96 standard errors wide.
+    const auto margin = 1.96 * std::sqrt(score * (1.0 - score) / game_count);
+    return {
+        elo_of_score(score),
+        elo_of_score(score - margin),
+        elo_of_score(score + margin),
+    };
+}
+
+double log_likelihood_ratio(
+    size_t wins,
+    size_t losses,
+    double elo0,
+    double elo1
+) {
+    const auto p0 = expected_score(elo0);
+    const auto p1 = expected_score(elo1);
+    return wins * std::log(p1 / p0)
+        + losses * std::log((1.0 - p1) / (1.0 - p0));
+}
+
+Verdict judge(size_t wins, size_t losses, const SprtBounds& bounds) {
+    const auto upper = std::log((1.0 - bounds.beta) / bounds.alpha);
+    const auto lower = std::log(bounds.beta / (1.0 - bounds.alpha));
+    const auto stronger =
+        log_likelihood_ratio(wins, losses, 0.0, bounds.elo);
+    const auto weaker = log_likelihood_ratio(wins, losses, 0.0, -bounds.elo);
+    if (stronger >= upper) {
+        return Verdict::FirstStronger;
+    } else if (weaker >= upper) {
+        return Verdict::SecondStronger;
+    } else if (stronger <= lower && weaker <= lower) {
+        return Verdict::Even;
+    }
+    return Verdict::Running;
+}
+
+Tournament::Tournament(std::vector<Entrant> entrants, TournamentConfig config) :
+    entrants_(std::move(entrants)),
+    config_(config) {
+    for (size_t i = 0; i < entrants_.size(); i += 1) {
+        for (size_t j = i + 1; j < entrants_.size(); j += 1) {
+            pairings_.push_back({i, j});
+        }
+    }
+}
+
+void Tournament::run(
+    const std::function<void(const Pairing&)>& on_pairing_done
+) {
+    for (auto& pairing : pairings_) {
+        play(pairing);
+        if (on_pairing_done) {
+            on_pairing_done(pairing);
+        }
+    }
+}
+
+std::vector<double> Tournament::ratings() const {
+    // Fit a Bradley-Terry model by minorization-maximization. One virtual
+    // draw against every opponent keeps the rating of an entrant that never
+    // won finite.
+    const auto count = entrants_.size();
+    std::vector<double> wins(count, 0.0);
+    std::vector<double> game_counts(count * count, 0.0);
+    for (const auto& pairing : pairings_) {
+        wins[pairing.first] += pairing.first_wins + 0.5;
+        wins[pairing.second] += pairing.second_wins + 0.5;
+        const auto game_count = pairing.game_count() + 1.0;
+        game_counts[pairing.first * count + pairing.second] = game_count;
+        game_counts[pairing.second * count + pairing.first] = game_count;
+    }
+
+    std::vector<double> strengths(count, 1.0);
+    std::vector<double> next(count);
+    for (size_t iteration = 0; iteration < RATING_ITERATIONS; iteration += 1) {
+        double log_sum = 0.0;
+        for (size_t i = 0; i < count; i += 1) {
+            double denominator = 0.0;
+            for (size_t j = 0; j < count; j += 1) {
+                denominator +=
+                    game_counts[i * count + j] / (strengths[i] + strengths[j]);
+            }
+            next[i] = denominator > 0.0 ? wins[i] / denominator : 1.0;
+            log_sum += std::log(next[i]);
+        }
+        // Center the ratings on 0.
+        const auto mean = std::exp(log_sum / count);
+        for (size_t i = 0; i < count; i += 1) {
+            strengths[i] = next[i] / mean;
+        }
+    }
+
+    std::vector<double> ratings(count);
+    for (size_t i = 0; i < count; i += 1) {
+        ratings[i] = 400.0 * std::log10(strengths[i]);
+    }
+    return ratings;
+}
+
+void Tournament::play(Pairing& pairing) {
+    std::mutex mutex;
+    size_t claimed_pairs = 0;
+    const auto work = [&] {
+        while (true) {
+            unsigned int seed;
+            {
+                std::lock_guard lock(mutex);
+                if (pairing.verdict != Verdict::Running
+                    || 2 * claimed_pairs >= config_.max_games) {
+                    return;
+                }
+                seed = config_.first_seed
+                    + static_cast<unsigned int>(claimed_pairs);
+                claimed_pairs += 1;
+            }
+
+            const bool won = play_game(pairing, seed, false);
+            const bool won_swapped = play_game(pairing, seed, true);
+
+            std::lock_guard lock(mutex);
+            const auto first_wins = size_t {won} + size_t {won_swapped};
+            pairing.first_wins += first_wins;
+            pairing.second_wins += 2 - first_wins;
+            // Pairs under way when the test concluded still count.
+            if (pairing.verdict == Verdict::Running) {
+                pairing.verdict = judge(
+                    pairing.first_wins,
+                    pairing.second_wins,
+                    config_.sprt
+                );
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned int i = 0; i < std::max(config_.thread_count, 1u);
+             i += 1) {
+            workers.emplace_back(work);
+        }
+    }
+    if (pairing.verdict == Verdict::Running) {
+        pairing.verdict = Verdict::Inconclusive;
+    }
+}
+
+bool Tournament::play_game(
+    const Pairing& pairing,
+    unsigned int seed,
+    bool is_swapped
+) const {
+    std::vector<std::unique_ptr<Player>> players;
+    for (uint8_t seat = 0; seat < config_.seat_count; seat += 1) {
+        const bool is_first = (seat % 2 == 0) != is_swapped;
+        players.push_back(
+            entrants_[is_first ? pairing.first : pairing.second].create()
+        );
+    }
+    State state(std::move(players), seed);
+    while (state.update() != AppState::GameOver) {
+    }
+    return (state.current_seat() % 2 == 0) != is_swapped;
+}
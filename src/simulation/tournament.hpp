@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../player/player.hpp"
+
+/// A strategy taking part in a tournament.
+struct Entrant {
+    std::string name;
+    /// Creates a fresh player for every game.
+    std::function<std::unique_ptr<Player>()> create;
+};
+
+/// Hypotheses of the sequential probability ratio test run on a pairing.
+struct SprtBounds {
+    /// Smallest Elo difference worth detecting.
+    double elo = 30.0;
+    /// Chance of declaring a difference where there is none.
+    double alpha = 0.05;
+    /// Chance of missing a difference of `elo`.
+    double beta = 0.05;
+};
+
+/// What the games of a pairing have shown so far.
+enum class Verdict : uint8_t {
+    Running,        // Too few games to tell
+    FirstStronger,  // By at least the Elo of the bounds
+    SecondStronger, // By at least the Elo of the bounds
+    Even,           // Within the Elo of the bounds of each other
+    Inconclusive,   // Stopped at the maximum number of games
+};
+
+/// An Elo difference and its 95% confidence interval.
+struct EloEstimate {
+    double elo;
+    double lower;
+    double upper;
+};
+
+/// Returns the Elo difference that explains a record of wins and losses.
+EloEstimate estimate_elo(size_t wins, size_t losses);
+
+/// Returns the log-likelihood ratio of a record of wins and losses under an
+/// Elo difference of `elo1` against one of `elo0`.
+double log_likelihood_ratio(
+    size_t wins,
+    size_t losses,
+    double elo0,
+    double elo1
+);
+
+/// Tests a record of wins and losses of the first entrant of a pairing
+/// against both a positive and a negative difference of the bounds' Elo.
+Verdict judge(size_t wins, size_t losses, const SprtBounds& bounds);
+
+/// The games played between two entrants.
+struct Pairing {
+    size_t first;  // Index of the entrant
+    size_t second; // Index of the entrant
+    size_t first_wins = 0;
+    size_t second_wins = 0;
+    Verdict verdict = Verdict::Running;
+
+    size_t game_count() const noexcept {
+        return first_wins + second_wins;
+    }
+};
+
+struct TournamentConfig {
+    uint8_t seat_count = 2;
+    /// Games after which a pairing stops even if its test has not concluded.
+    size_t max_games = 20'000;
+    SprtBounds sprt;
+    unsigned int thread_count = std::thread::hardware_concurrency();
+    unsigned int first_seed = 0;
+};
+
+/// Plays every pair of entrants against each other until a sequential test
+/// tells which is stronger, or that they are even.
+///
+/// Games come in pairs dealt from the same seed, with the two entrants
+/// swapping seats, which cancels most of the luck of the deal. The entrants
+/// take turns around the table, so at even seat counts each holds half the
+/// seats. Worker threads play game pairs of one pairing at a time and stop
+/// as soon as its test concludes, give or take the pairs already under way.
+class Tournament {
+  public:
+    Tournament(std::vector<Entrant> entrants, TournamentConfig config);
+
+    /// Plays every pairing to its verdict, calling `on_pairing_done` after
+    /// each.
+    void run(const std::function<void(const Pairing&)>& on_pairing_done = {});
+
+    const std::vector<Entrant>& entrants() const noexcept {
+        return entrants_;
+    }
+
+    const std::vector<Pairing>& pairings() const noexcept {
+        return pairings_;
+    }
+
+    /// Returns the Elo rating of every entrant, fitted to the results of all
+    /// pairings and centered on 0.
+    std::vector<double> ratings() const;
+
+  private:
+    void play(Pairing& pairing);
+
+    /// Plays a game with the first entrant at even seats, or at odd seats if
+    /// `is_swapped`, and returns whether the first entrant won.
+    bool play_game(const Pairing& pairing, unsigned int seed, bool is_swapped)
+        const;
+
+    std::vector<Entrant> entrants_;
+    TournamentConfig config_;
+    std::vector<Pairing> pairings_;
+};
@@ -0,0 +1,225 @@
+#include "spectator_feed.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+enum class MessageKind : uint8_t { Keyframe, Delta };
+
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/// Reads the fields of a message in order.
+class Reader {
+  public:
+    explicit Reader(std::span<const std::byte> bytes) : rest_(bytes) {}
+
+    template <typename T>
+    T get() {
+        if (rest_.size() < sizeof(T)) {
+            malformed();
+        }
+        T value;
+        std::memcpy(&value, rest_.data(), sizeof(T));
+        rest_ = rest_.subspan(sizeof(T));
+        return value;
+    }
+
+    /// Reads a seat of a table of the given size.
+    uint8_t get_seat(uint8_t seat_count) {
+        const auto seat = get<uint8_t>();
+        if (seat >= seat_count) {
+            malformed();
+        }
+        return seat;
+    }
+
+    bool empty() const noexcept {
+        return rest_.empty();
+    }
+
+    [[noreturn]] static void malformed() {
+        throw std::runtime_error("malformed spectator message");
+    }
+
+  private:
+    std::span<const std::byte> rest_;
+};
+} // namespace
+
+bool SpectatorView::apply(std::span<const std::byte> message) {
+    Reader reader(message);
+    const auto kind = static_cast<MessageKind>(reader.get<uint8_t>());
+    const auto message_turn = reader.get<uint32_t>();
+    if (kind == MessageKind::Keyframe) {
+        turn = message_turn;
+        seat_count = reader.get<uint8_t>();
+        if (seat_count < MIN_SEATS || seat_count > MAX_SEATS) {
+            Reader::malformed();
+        }
+        current_seat = reader.get_seat(seat_count);
+        const auto direction_value = reader.get<int8_t>();
+        if (direction_value != 1 && direction_value != -1) {
+            Reader::malformed();
+        }
+        direction = static_cast<Direction>(direction_value);
+        pending_draw = reader.get<uint8_t>();
+        discard_pile.resize(reader.get<uint16_t>());
+        for (auto& card : discard_pile) {
+            card = reader.get<uint8_t>();
+        }
+        hand_sizes.fill(0);
+        for (uint8_t seat = 0; seat < seat_count; seat += 1) {
+            hand_sizes[seat] = reader.get<uint16_t>();
+        }
+        if (!reader.empty()) {
+            Reader::malformed();
+        }
+    } else if (kind == MessageKind::Delta) {
+        if (seat_count == 0 || message_turn != turn + 1) {
+            return false;
+        }
+        const auto played_seat = reader.get<uint8_t>();
+        const auto played_card = reader.get<uint8_t>();
+        const auto next_seat = reader.get_seat(seat_count);
+        const auto is_reversed = reader.get<uint8_t>() != 0;
+        const auto next_pending_draw = reader.get<uint8_t>();
+        const auto draw_count = reader.get<uint8_t>();
+        // Validated in full before the view changes.
+        std::array<uint16_t, MAX_SEATS> sizes = hand_sizes;
+        for (uint8_t i = 0; i < draw_count; i += 1) {
+            const auto seat = reader.get_seat(seat_count);
+            sizes[seat] += reader.get<uint8_t>();
+        }
+        // Cards are drawn before the card is played, or by the next player,
+        // and hands are swapped once it is played.
+        bool is_winning_card = false;
+        if (played_seat != SpectatorFeed::NONE) {
+            if (played_seat >= seat_count || sizes[played_seat] == 0) {
+                Reader::malformed();
+            }
+            sizes[played_seat] -= 1;
+            is_winning_card = sizes[played_seat] == 0;
+        }
+        const auto swap_count = reader.get<uint8_t>();
+        for (uint8_t i = 0; i < swap_count; i += 1) {
+            const auto seat = reader.get_seat(seat_count);
+            const auto other_seat = reader.get_seat(seat_count);
+            std::swap(sizes[seat], sizes[other_seat]);
+        }
+        if (!reader.empty()) {
+            Reader::malformed();
+        }
+        // The winning card ends the game before reaching the pile.
+        if (played_seat != SpectatorFeed::NONE && !is_winning_card) {
+            discard_pile.push_back(played_card);
+        }
+        hand_sizes = sizes;
+        current_seat = next_seat;
+        if (is_reversed) {
+            direction = direction == Direction::Clockwise
+                ? Direction::CounterClockwise
+                : Direction::Clockwise;
+        }
+        pending_draw = next_pending_draw;
+        turn = message_turn;
+    } else {
+        Reader::malformed();
+    }
+    return true;
+}
+
+size_t SpectatorFeed::poll(
+    Subscription& subscription,
+    std::vector<Message>& messages
+) const {
+    const std::lock_guard lock(mutex_);
+    if (keyframe_ == nullptr) {
+        return 0;
+    }
+    size_t count = 0;
+    if (!subscription.is_synced || subscription.next_turn <= keyframe_turn_) {
+        messages.push_back(keyframe_);
+        subscription.next_turn = keyframe_turn_ + 1;
+        subscription.is_synced = true;
+        count += 1;
+    }
+    const auto first = subscription.next_turn - keyframe_turn_ - 1;
+    for (size_t i = first; i < deltas_.size(); i += 1) {
+        messages.push_back(deltas_[i]);
+        count += 1;
+    }
+    subscription.next_turn =
+        keyframe_turn_ + 1 + static_cast<uint32_t>(deltas_.size());
+    return count;
+}
+
+void SpectatorFeed::publish_view() {
+    auto message = std::make_shared<std::string>();
+    const bool is_keyframe = turn_ % keyframe_interval_ == 0;
+    if (is_keyframe) {
+        put(*message, MessageKind::Keyframe);
+        put(*message, view_.turn);
+        put(*message, view_.seat_count);
+        put(*message, view_.current_seat);
+        put(*message, view_.direction);
+        put(*message, view_.pending_draw);
+        put(*message, static_cast<uint16_t>(view_.discard_pile.size()));
+        message->append(
+            reinterpret_cast<const char*>(view_.discard_pile.data()),
+            view_.discard_pile.size()
+        );
+        for (uint8_t seat = 0; seat < view_.seat_count; seat += 1) {
+            put(*message, view_.hand_sizes[seat]);
+        }
+    } else {
+        encode_delta(*message);
+    }
+
+    {
+        const std::lock_guard lock(mutex_);
+        if (is_keyframe) {
+            keyframe_ = std::move(message);
+            keyframe_turn_ = turn_;
+            deltas_.clear();
+        } else {
+            deltas_.push_back(std::move(message));
+        }
+    }
+
+    turn_ += 1;
+    previous_direction_ = view_.direction;
+    draws_.fill(0);
+    played_seat_ = NONE;
+    played_card_ = NONE;
+    swaps_.clear();
+}
+
+void SpectatorFeed::encode_delta(std::string& out) const {
+    put(out, MessageKind::Delta);
+    put(out, view_.turn);
+    put(out, played_seat_);
+    put(out, played_card_);
+    put(out, view_.current_seat);
+    put(out, static_cast<uint8_t>(view_.direction != previous_direction_));
+    put(out, view_.pending_draw);
+    uint8_t draw_count = 0;
+    for (uint8_t seat = 0; seat < view_.seat_count; seat += 1) {
+        draw_count += draws_[seat] > 0 ? 1 : 0;
+    }
+    put(out, draw_count);
+    for (uint8_t seat = 0; seat < view_.seat_count; seat += 1) {
+        if (draws_[seat] > 0) {
+            put(out, seat);
+            put(out, draws_[seat]);
+        }
+    }
+    put(out, static_cast<uint8_t>(swaps_.size()));
+    for (const auto& [seat, other_seat] : swaps_) {
+        put(out, seat);
+        put(out, other_seat);
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "game_listener.hpp"
+#include "seating.hpp"
+#include "state.hpp"
+
+/// What spectators see of a table: the discard pile and the size of every
+/// hand, but not the cards in hand.
+struct SpectatorView {
+    uint32_t turn = 0; // Turns played so far
+    std::vector<uint8_t> discard_pile; // Atlas indices, from the bottom
+    std::array<uint16_t, MAX_SEATS> hand_sizes {};
+    uint8_t seat_count = 0;
+    uint8_t current_seat = 0;
+    Direction direction = Direction::Clockwise;
+    uint8_t pending_draw = 0;
+
+    /// Copies the view of the table. Reusing the same view reuses its
+    /// memory.
+    template <typename GameRules>
+    void assign(const BasicState<GameRules>& state, uint32_t turn) {
+        this->turn = turn;
+        discard_pile.clear();
+        for (const auto& card : state.discard_pile().cards()) {
+            discard_pile.push_back(card->atlas_index());
+        }
+        hand_sizes.fill(0);
+        for (uint8_t seat = 0; seat < state.seat_count(); seat += 1) {
+            hand_sizes[seat] =
+                static_cast<uint16_t>(state.player(seat).hand_size());
+        }
+        seat_count = state.seat_count();
+        current_seat = state.current_seat();
+        direction = state.direction();
+        pending_draw = state.discard_pile().pending_draw();
+    }
+
+    /// Applies a message of a `SpectatorFeed`: a keyframe replaces the view,
+    /// and a delta moves it on by a turn. Returns false for a delta that
+    /// does not follow the view, which then waits for a keyframe. Throws
+    /// `std::runtime_error` if the message is malformed.
+    bool apply(std::span<const std::byte> message);
+
+    bool operator==(const SpectatorView&) const = default;
+};
+
+/// Broadcasts a table to any number of spectators, as the listener of its
+/// `State`.
+///
+/// Every turn is encoded once, as a delta of a dozen bytes or so against the
+/// turn before: the card played, the cards drawn, the swapped hands, the
+/// next seat and whether play reversed. Every `keyframe_interval` turns, the
+/// whole view is encoded as a keyframe instead. Subscribers share the
+/// encoded messages, so a turn costs a pointer copy per subscriber, and a
+/// subscriber who joins late, or falls more than a keyframe behind, starts
+/// from the latest keyframe. Safe to poll from other threads than the one
+/// playing the game.
+class SpectatorFeed: public GameListener {
+  public:
+    static constexpr uint32_t DEFAULT_KEYFRAME_INTERVAL = 64;
+
+    using Message = std::shared_ptr<const std::string>;
+
+    /// A spectator's place in the feed.
+    struct Subscription {
+        uint32_t next_turn = 0; // Of the next delta to send
+        bool is_synced = false; // Whether a keyframe was sent
+    };
+
+    explicit SpectatorFeed(
+        uint32_t keyframe_interval = DEFAULT_KEYFRAME_INTERVAL
+    ) :
+        keyframe_interval_(keyframe_interval) {}
+
+    /// Publishes the table as it is once the game is dealt, or a turn has
+    /// been played.
+    template <typename GameRules>
+    void publish(const BasicState<GameRules>& state) {
+        view_.assign(state, turn_);
+        publish_view();
+    }
+
+    /// Appends the messages the subscriber has not received yet, and
+    /// returns how many there are.
+    size_t poll(Subscription& subscription, std::vector<Message>& messages)
+        const;
+
+    void on_card_drawn(uint8_t seat, DrawReason, const Card*) override {
+        draws_[seat] += 1;
+    }
+
+    void on_card_played(uint8_t seat, const Card& card) override {
+        played_seat_ = seat;
+        played_card_ = card.atlas_index();
+    }
+
+    void on_hands_swapped(uint8_t seat, uint8_t other_seat) override {
+        swaps_.push_back({seat, other_seat});
+    }
+
+    /// Stands for the lack of a seat or a card in a delta.
+    static constexpr uint8_t NONE = 0xFF;
+
+  private:
+    void publish_view();
+    /// Encodes the events of the turn, against the previous view.
+    void encode_delta(std::string& out) const;
+
+    uint32_t keyframe_interval_;
+    uint32_t turn_ = 0; // Turns published
+    SpectatorView view_;
+    Direction previous_direction_ = Direction::Clockwise;
+
+    // Events of the turn being played
+    std::array<uint8_t, MAX_SEATS> draws_ {};
+    uint8_t played_seat_ = NONE;
+    uint8_t played_card_ = NONE;
+    std::vector<std::array<uint8_t, 2>> swaps_;
+
+    mutable std::mutex mutex_; // Guards the messages
+    Message keyframe_;
+    uint32_t keyframe_turn_ = 0;
+    std::vector<Message> deltas_; // Since the keyframe, in turn order
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <format>
+#include <memory>
+#include <string>
+
+#include "app_state.hpp"
+#include "atlas.hpp"
+#include "input.hpp"
+#include "label.hpp"
+#include "presenter.hpp"
+#include "sprite_batch.hpp"
+#include "text_button.hpp"
+
+/// The controls over a table of AI players: the speed of play, and a button
+/// to stop watching. Drawn from the shared atlas, like the menus, so making
+/// one loads nothing.
+class SpectatorHud {
+  public:
+    static constexpr unsigned int FONT_SIZE = 32;
+    static_assert(Atlas::has_font_size(FONT_SIZE));
+
+    /// Speeds to cycle through, the last one as fast as the engine plays.
+    static constexpr std::array<float, 6> TIME_SCALES =
+        {1.0f, 2.0f, 4.0f, 8.0f, 16.0f, Presenter::UNLIMITED};
+
+    SpectatorHud() {
+        // Create speed button
+        speed_button_ = std::make_unique<TextButton>(
+            Label("", FONT_SIZE),
+            sf::Color::White,
+            sf::Color(50, 50, 150)
+        );
+        speed_button_->set_text(speed_text());
+
+        // Create stop button
+        stop_button_ = std::make_unique<TextButton>(
+            Label("Stop", FONT_SIZE),
+            sf::Color::White,
+            sf::Color(150, 50, 50)
+        );
+
+        game_text_ = std::make_unique<Label>("", FONT_SIZE);
+        game_text_->set_color(sf::Color::Yellow);
+    }
+
+    /// Returns the state to go to, which is `AppState::Gameplay` to keep
+    /// watching.
+    AppState update(const Input& input) {
+        switch (buttons_.clicked(input).value_or(Option::None)) {
+            case Option::Speed:
+                time_scale_index_ += 1;
+                time_scale_index_ %= TIME_SCALES.size();
+                speed_button_->set_text(speed_text());
+                break;
+            case Option::Stop:
+                return AppState::StartMenu;
+            case Option::None:
+                break;
+        }
+        return AppState::Gameplay;
+    }
+
+    /// Renders the controls in the top left corner, and the number of the
+    /// game being watched.
+    void render(SpriteBatch& batch, const Input& input, size_t game) {
+        constexpr sf::Vector2f MARGIN(170.f, 60.f);
+
+        speed_button_->set_position(MARGIN);
+        stop_button_->set_position(MARGIN + sf::Vector2f(0.f, 100.f));
+        game_text_->set_text(std::format("Game {}", game));
+        game_text_->setPosition(MARGIN + sf::Vector2f(-130.f, 160.f));
+
+        speed_button_->render(batch, input.mouse_position());
+        stop_button_->render(batch, input.mouse_position());
+        game_text_->render(batch);
+
+        buttons_.clear();
+        buttons_.add(speed_button_->bounds(), Option::Speed);
+        buttons_.add(stop_button_->bounds(), Option::Stop);
+    }
+
+    /// Returns how many times faster than normal the game is shown.
+    float time_scale() const noexcept {
+        return TIME_SCALES[time_scale_index_];
+    }
+
+  private:
+    enum class Option { None, Speed, Stop };
+
+    std::string speed_text() const {
+        if (time_scale() == Presenter::UNLIMITED) {
+            return "Speed: Max";
+        }
+        return std::format("Speed: {}x", time_scale());
+    }
+
+    std::unique_ptr<TextButton> speed_button_;
+    std::unique_ptr<TextButton> stop_button_;
+    std::unique_ptr<Label> game_text_;
+    HitRegions<Option> buttons_; // Buttons as last rendered
+    size_t time_scale_index_ = 0;
+};
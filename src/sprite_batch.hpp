@@ -0,0 +1,120 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+
+#include "atlas.hpp"
+
+/// Collects everything a frame shows, and draws it in one draw call.
+///
+/// Cards, the background and the glyphs of text all come from the atlas, and
+/// plain shapes are filled from its white block, so every quad is moved to
+/// the target's coordinates when added and goes into a single vertex array,
+/// drawn in the order it was added.
+class SpriteBatch {
+  public:
+    /// Sets the transform applied to everything added next, e.g. to lay a
+    /// table out in a tile of the window.
+    void set_transform(const sf::Transform& transform) noexcept {
+        transform_ = transform;
+    }
+
+    const sf::Transform& transform() const noexcept {
+        return transform_;
+    }
+
+    /// Adds a sprite from the atlas, moved by the transform.
+    void add(
+        const sf::Sprite& sprite,
+        const sf::Transform& transform = sf::Transform::Identity
+    ) {
+        const auto texture_rect = sprite.getTextureRect();
+        add_quad(
+            transform * sprite.getTransform(),
+            sf::FloatRect({0.0f, 0.0f}, sf::Vector2f(texture_rect.size)),
+            texture_rect,
+            sprite.getColor()
+        );
+    }
+
+    /// Adds the inside of a convex shape.
+    void add(const sf::Shape& shape) {
+        const auto to_target = transform_ * shape.getTransform();
+        const auto texel = Atlas::get().white_texel();
+        const auto color = shape.getFillColor();
+        const auto first = to_target.transformPoint(shape.getPoint(0));
+        for (size_t i = 1; i + 1 < shape.getPointCount(); i += 1) {
+            vertices_.append({first, color, texel});
+            vertices_.append(
+                {to_target.transformPoint(shape.getPoint(i)), color, texel}
+            );
+            vertices_.append(
+                {to_target.transformPoint(shape.getPoint(i + 1)), color, texel}
+            );
+        }
+    }
+
+    /// Adds a plain rectangle.
+    void add(const sf::FloatRect& rect, sf::Color color) {
+        const auto white = Atlas::get().region(AtlasRegion::White);
+        add_quad(
+            sf::Transform::Identity,
+            rect,
+            {white.position + white.size / 2, {0, 0}},
+            color
+        );
+    }
+
+    /// Adds a rectangle of the atlas, stretched over a rectangle moved by the
+    /// transform.
+    void add_quad(
+        const sf::Transform& transform,
+        const sf::FloatRect& rect,
+        const sf::IntRect& texture_rect,
+        sf::Color color
+    ) {
+        const auto to_target = transform_ * transform;
+        const auto texture_position = sf::Vector2f(texture_rect.position);
+        const auto texture_size = sf::Vector2f(texture_rect.size);
+        const sf::Vector2f corners[] = {
+            {0.0f, 0.0f},
+            {1.0f, 0.0f},
+            {0.0f, 1.0f},
+            {1.0f, 1.0f},
+        };
+        sf::Vertex vertices[4];
+        for (size_t i = 0; i < 4; i += 1) {
+            vertices[i] = {
+                to_target.transformPoint(
+                    rect.position + rect.size.componentWiseMul(corners[i])
+                ),
+                color,
+                texture_position + texture_size.componentWiseMul(corners[i]),
+            };
+        }
+        // Two triangles per quad.
+        for (const auto i : {0, 1, 2, 2, 1, 3}) {
+            vertices_.append(vertices[i]);
+        }
+    }
+
+    /// Removes everything, keeping the memory for the next frame.
+    void clear() {
+        vertices_.clear();
+        transform_ = sf::Transform::Identity;
+    }
+
+    /// Draws everything added, in order.
+    void draw(sf::RenderTarget& render_target) const {
+        render_target.draw(vertices_, &Atlas::get().texture());
+    }
+
+    /// Returns the number of triangles added.
+    size_t triangle_count() const noexcept {
+        return vertices_.getVertexCount() / 3;
+    }
+
+  private:
+    sf::VertexArray vertices_ {sf::PrimitiveType::Triangles};
+    sf::Transform transform_;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+
+/// A bounded queue from one producer thread to one consumer thread without
+/// locks.
+///
+/// Each side owns one of the two counters and only reads the other's, so
+/// pushing and popping never wait. Each side also caches the other's counter
+/// and reloads it only when the queue looks full or empty.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(std::has_single_bit(Capacity));
+
+  public:
+    /// Adds a value, or returns false if the queue is full. Producer thread
+    /// only.
+    bool try_push(const T& value) noexcept {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == Capacity) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == Capacity) {
+                return false;
+            }
+        }
+        slots_[tail % Capacity] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Removes the oldest value, if any. Consumer thread only.
+    std::optional<T> try_pop() noexcept {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) {
+                return std::nullopt;
+            }
+        }
+        const T value = slots_[head % Capacity];
+        head_.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+  private:
+    /// Keeps the counters of the two threads on separate cache lines.
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_ = 0; // Next to pop
+    size_t tail_cache_ = 0; // Owned by the consumer
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_ = 0; // Next to push
+    size_t head_cache_ = 0; // Owned by the producer
+
+    alignas(CACHE_LINE_SIZE) std::array<T, Capacity> slots_ {};
+};
@@ -1,75 +1,149 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <format>
 #include <memory>
 
 #include "app_state.hpp"
 #include "button.hpp"
+#include "input.hpp"
+#include "label.hpp"
+#include "seating.hpp"
+#include "sprite_batch.hpp"
 #include "text_button.hpp"
 
-/// A start menu that displays the start and exit buttons
+/// How the local player takes part in the next game.
+enum class GameMode {
+    Play,  // Against AI players
+    Watch, // Watches a table of AI players
+    Wall,  // Watches many tables of AI players at once
+};
+
+constexpr int GAME_MODE_COUNT = 3;
+
+/// A start menu that displays the start, player count, mode and exit buttons
 class StartMenu {
   public:
-    StartMenu(const sf::RenderTarget& render_target) :
-        font_("assets/fonts/arial.ttf") {
+    StartMenu(const sf::RenderTarget& render_target) {
         constexpr unsigned int title_font_size = 72;
         constexpr unsigned int option_font_size = 48;
 
         // Create title text
-        title_text_ = std::make_unique<sf::Text>(font_, "UNO", title_font_size);
-        title_text_->setFillColor(sf::Color::Yellow);
-        title_text_->setOrigin(title_text_->getLocalBounds().getCenter());
+        title_text_ = std::make_unique<Label>("UNO", title_font_size);
+        title_text_->set_color(sf::Color::Yellow);
+        title_text_->setOrigin(title_text_->local_bounds().getCenter());
         title_text_->setPosition(
             sf::Vector2f(render_target.getSize().x / 2.0f, 150.f)
         );
 
         // Create start button
         start_button_ = std::make_unique<TextButton>(
-            sf::Text(font_, "Start", option_font_size),
+            Label("Start", option_font_size),
             sf::Color::White,
             sf::Color(50, 150, 50)
         );
 
+        // Create player count button
+        seats_button_ = std::make_unique<TextButton>(
+            Label("", option_font_size),
+            sf::Color::White,
+            sf::Color(50, 50, 150)
+        );
+        seats_button_->set_text(std::format("Players: {}", seat_count_));
+
+        // Create mode button
+        mode_button_ = std::make_unique<TextButton>(
+            Label("", option_font_size),
+            sf::Color::White,
+            sf::Color(120, 80, 150)
+        );
+        mode_button_->set_text(mode_text());
+
         // Create exit button
         exit_button_ = std::make_unique<TextButton>(
-            sf::Text(font_, "Exit", option_font_size),
+            Label("Exit", option_font_size),
             sf::Color::White,
             sf::Color(150, 50, 50)
         );
     }
 
-    AppState update(sf::RenderWindow& window) {
-        if (start_button_->is_left_clicked(window)) {
-            while (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left))
-                ;
-            return AppState::Gameplay;
-        } else if (exit_button_->is_left_clicked(window)) {
-            while (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left))
-                ;
-            return AppState::Exit;
+    AppState update(const Input& input) {
+        switch (buttons_.clicked(input).value_or(Option::None)) {
+            case Option::Start:
+                return AppState::Gameplay;
+            case Option::Seats:
+                seat_count_ =
+                    seat_count_ == MAX_SEATS ? MIN_SEATS : seat_count_ + 1;
+                seats_button_->set_text(
+                    std::format("Players: {}", seat_count_)
+                );
+                break;
+            case Option::Mode:
+                game_mode_ = static_cast<GameMode>(
+                    (static_cast<int>(game_mode_) + 1) % GAME_MODE_COUNT
+                );
+                mode_button_->set_text(mode_text());
+                break;
+            case Option::Exit:
+                return AppState::Exit;
+            case Option::None:
+                break;
         }
         return AppState::StartMenu;
     }
 
-    void render(sf::RenderWindow& window) {
-        const auto window_size = sf::Vector2f(window.getSize());
+    void render(SpriteBatch& batch, const Input& input, sf::Vector2f size) {
+        title_text_->setPosition(sf::Vector2f(size.x / 2.0f, 150.f));
+        start_button_->set_position(size / 2.0f - sf::Vector2f(0.f, 150.f));
+        seats_button_->set_position(size / 2.0f - sf::Vector2f(0.f, 50.f));
+        mode_button_->set_position(size / 2.0f + sf::Vector2f(0.f, 50.f));
+        exit_button_->set_position(size / 2.0f + sf::Vector2f(0.f, 150.f));
 
-        title_text_->setPosition(sf::Vector2f(window_size.x / 2.0f, 150.f));
-        start_button_->set_position(
-            window_size / 2.0f - sf::Vector2f(0.f, 60.f)
-        );
-        exit_button_->set_position(
-            window_size / 2.0f + sf::Vector2f(0.f, 60.f)
-        );
+        title_text_->render(batch);
+        const auto mouse_position = input.mouse_position();
+        start_button_->render(batch, mouse_position);
+        seats_button_->render(batch, mouse_position);
+        mode_button_->render(batch, mouse_position);
+        exit_button_->render(batch, mouse_position);
+
+        buttons_.clear();
+        buttons_.add(start_button_->bounds(), Option::Start);
+        buttons_.add(seats_button_->bounds(), Option::Seats);
+        buttons_.add(mode_button_->bounds(), Option::Mode);
+        buttons_.add(exit_button_->bounds(), Option::Exit);
+    }
+
+    /// Returns the number of players selected for the next game.
+    uint8_t seat_count() const noexcept {
+        return seat_count_;
+    }
 
-        window.draw(*title_text_);
-        start_button_->render(window);
-        exit_button_->render(window);
+    /// Returns how the local player takes part in the next game.
+    GameMode game_mode() const noexcept {
+        return game_mode_;
     }
 
   private:
-    std::unique_ptr<sf::Text> title_text_;
+    enum class Option { None, Start, Seats, Mode, Exit };
+
+    const char* mode_text() const {
+        switch (game_mode_) {
+            case GameMode::Play:
+                return "Mode: Play";
+            case GameMode::Watch:
+                return "Mode: Watch";
+            case GameMode::Wall:
+                return "Mode: Wall";
+        }
+        return "";
+    }
+
+    std::unique_ptr<Label> title_text_;
     std::unique_ptr<Button> start_button_;
+    std::unique_ptr<TextButton> seats_button_;
+    std::unique_ptr<TextButton> mode_button_;
     std::unique_ptr<Button> exit_button_;
-    sf::Font font_;
+    HitRegions<Option> buttons_; // Buttons as last rendered
+    uint8_t seat_count_ = 4;
+    GameMode game_mode_ = GameMode::Play;
 };
\ No newline at end of file
@@ -1,155 +1,625 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cassert>
-#include <chrono>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <memory>
+#include <optional>
 #include <random>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include "animator.hpp"
 #include "app_state.hpp"
-#include "audio.hpp"
 #include "card/action_card.hpp"
+#include "card/create_card.hpp"
+#include "card/number_card.hpp"
 #include "card/wild_card.hpp"
+#include "checkpoint.hpp"
 #include "deck.hpp"
 #include "discard_pile.hpp"
+#include "game_arena.hpp"
+#include "game_listener.hpp"
+#include "metrics.hpp"
 #include "player/ai_player.hpp"
+#include "player/linear_ai_player.hpp"
 #include "player/local_player.hpp"
+#include "player/plugin_player.hpp"
+#include "rules.hpp"
+#include "seating.hpp"
+#include "table_layout.hpp"
+#include "table_snapshot.hpp"
+#include "triple_buffer.hpp"
 
-constexpr std::chrono::duration DRAW_CARD_DELAY =
-    std::chrono::milliseconds(700);
+/// A game state of an Uno card game, played under the given rule variants.
+template <typename GameRules = OfficialRules>
+class BasicState {
+  public:
+    /// The seat of the local player, who also takes the first turn.
+    static constexpr uint8_t LOCAL_SEAT = 0;
 
-enum class Direction : int8_t { Clockwise = 1, CounterClockwise = -1 };
+    /// Seats the local player and AI opponents, or AI players only for
+    /// spectators.
+    BasicState(
+        uint8_t seat_count,
+        GameListener& listener,
+        bool is_spectated = false
+    ) :
+        BasicState(
+            create_players(seat_count, is_spectated),
+            std::random_device {}(),
+            listener
+        ) {}
 
-/// A game state of an Uno card game.
-class State {
-  public:
-    State(sf::RenderTarget& render_target) :
-        seed_(std::random_device {}()),
+    /// Seats the given players, in seat order, at a table shuffled with the
+    /// seed.
+    BasicState(
+        std::vector<std::unique_ptr<Player>> players,
+        unsigned int seed,
+        GameListener& listener = GameListener::none()
+    ) :
+        seed_(seed),
         rng_(seed_),
-        deck_(rng_) {
-        players_.push_back(std::make_unique<AiPlayer>(Position::North, deck_));
-        players_.push_back(std::make_unique<AiPlayer>(Position::East, deck_));
-        players_.push_back(
-            std::make_unique<LocalPlayer>(Position::South, deck_, render_target)
-        );
-        players_.push_back(std::make_unique<AiPlayer>(Position::West, deck_));
+        deck_(rng_, arena_.resource(Subsystem::Deck)),
+        discard_pile_(arena_.resource(Subsystem::DiscardPile)),
+        players_(std::move(players)),
+        seating_(static_cast<uint8_t>(players_.size()), LOCAL_SEAT),
+        listener_(listener) {
+        seat_players();
+        deal();
+        publish();
+    }
 
-        auto card = deck_.draw().value();
-        while (dynamic_cast<WildCard*>(card.get())) {
+    /// Seats the local player and AI opponents at the table of a checkpoint.
+    BasicState(const Checkpoint& checkpoint, GameListener& listener) :
+        BasicState(
+            create_players(checkpoint.seat_count, false),
+            checkpoint,
+            listener
+        ) {}
+
+    /// Seats the given players, in seat order, at the table of a checkpoint,
+    /// to carry on its game as if it had never stopped.
+    ///
+    /// The players are told of the cards turned up and of the decks used so
+    /// far, but not of earlier turns: what an AI inferred about the hands of
+    /// its opponents is lost.
+    BasicState(
+        std::vector<std::unique_ptr<Player>> players,
+        const Checkpoint& checkpoint,
+        GameListener& listener = GameListener::none()
+    ) :
+        seed_(checkpoint.seed),
+        rng_(seed_),
+        deck_(
+            rng_,
+            checkpoint.shuffle_count,
+            checkpoint.deck,
+            arena_.resource(Subsystem::Deck)
+        ),
+        discard_pile_(arena_.resource(Subsystem::DiscardPile)),
+        players_(std::move(players)),
+        seating_(
+            checkpoint.seat_count,
+            checkpoint.current_seat,
+            checkpoint.direction
+        ),
+        top_seat_(
+            checkpoint.top_seat != Checkpoint::NO_SEAT
+                ? optional<uint8_t>(checkpoint.top_seat)
+                : std::nullopt
+        ),
+        listener_(listener) {
+        assert(players_.size() == checkpoint.seat_count);
+        seat_players();
+        auto* const cards = arena_.resource(Subsystem::Deck);
+        for (uint8_t seat = 0; seat < seating_.count(); seat += 1) {
+            for (const auto atlas_index : checkpoint.hands[seat]) {
+                players_[seat]->take(create_card(atlas_index, cards));
+            }
+        }
+        // Only the players are told, as the listener has seen the game.
+        for (uint32_t i = 1; i < checkpoint.shuffle_count; i += 1) {
+            for (auto& player : players_) {
+                player->on_deck_refilled();
+            }
+        }
+        for (const auto atlas_index : checkpoint.discard_pile) {
+            auto card = create_card(atlas_index, cards);
+            for (auto& player : players_) {
+                player->on_card_turned_up(*card);
+            }
             discard_pile_.push_back(std::move(card));
-            card = deck_.draw().value();
         }
-        discard_pile_.push_back(std::move(card));
+        discard_pile_.add_pending_draw(checkpoint.pending_draw);
+        publish();
     }
 
+    /// Plays a turn and publishes the new table.
     AppState update() {
-        auto& player = current_player();
-        if (player.is_hand_empty()) {
-            return AppState::GameOver;
+        const auto& metrics = GameMetrics::get();
+        metrics.turns.add();
+        const ScopedTimer timer(metrics.turn_time);
+        const auto app_state = play_turn();
+        publish();
+        return app_state;
+    }
+
+    /// Passes the mouse input of a frame to the players. Called from the
+    /// render thread before `render`.
+    void handle_input(const Input& input) const {
+        for (const auto& player : players_) {
+            player->handle_input(input);
+        }
+    }
+
+    /// Adds the latest table published by the gameplay thread to the batch,
+    /// laid out on a table of the given size, without the cards the animator
+    /// is still moving, and the controls of the local player over it. Safe
+    /// to call from another thread while `update` runs.
+    void render(
+        SpriteBatch& batch,
+        const Animator& animator,
+        sf::Vector2f table_size
+    ) const {
+        // Copying into the same snapshot every frame reuses its memory.
+        presented_ = snapshots_.front();
+        animator.hide_moving_cards(presented_);
+        const TableLayout layout(table_size, presented_.seat_count);
+        deck_.render(batch, layout.deck_position());
+        DiscardPile::render(batch, layout.center(), presented_.discard_pile);
+        for (uint8_t seat = 0; seat < presented_.seat_count; seat += 1) {
+            players_[seat]->render(batch, presented_, layout, seat);
         }
+        animator.render(batch, layout);
+        render_player_indicator(batch, layout, presented_.current_seat);
+        render_direction_indicator(batch, layout, presented_);
+        for (const auto& player : players_) {
+            player->render_overlay(batch, layout);
+        }
+    }
+
+    /// Draws a frame of the table on the render target, whether a window or
+    /// an offscreen texture, sized to fill it.
+    void draw(
+        sf::RenderTarget& render_target,
+        SpriteBatch& batch,
+        const Animator& animator
+    ) const {
+        batch.clear();
+        render(batch, animator, sf::Vector2f(render_target.getSize()));
+        batch.draw(render_target);
+    }
 
-        while (!player.has_playable_card(discard_pile_)) {
+    /// Sets the table up as a still scene rather than a game: the player at
+    /// the first seat draws until they hold `hand_size` cards, and cards are
+    /// turned up until the discard pile holds `discard_count`, as far as the
+    /// deck goes. As when dealing, a Wild card is not left on top. For
+    /// render tests and benchmarks.
+    void stage(size_t hand_size, size_t discard_count) {
+        auto& player = *players_[LOCAL_SEAT];
+        while (player.hand_size() < hand_size && deck_.size() > 0) {
             player.draw_from_deck(deck_);
-            Audio::get().play_random_slide_sound();
-            std::this_thread::sleep_for(DRAW_CARD_DELAY);
         }
+        while ((discard_pile_.cards().size() < discard_count
+                || dynamic_cast<const WildCard*>(&discard_pile_.peek_top()))
+               && deck_.size() > 0) {
+            turn_up(deck_.draw().value());
+        }
+        publish();
+    }
+
+    /// Saves the table into the checkpoint, whose table number is left as
+    /// is. Reusing the same checkpoint reuses its memory.
+    void checkpoint(Checkpoint& checkpoint) const {
+        checkpoint.seed = seed_;
+        checkpoint.shuffle_count = deck_.shuffle_count();
+        checkpoint.seat_count = seating_.count();
+        checkpoint.current_seat = seating_.current();
+        checkpoint.direction = seating_.direction();
+        checkpoint.pending_draw = discard_pile_.pending_draw();
+        checkpoint.top_seat = top_seat_.value_or(Checkpoint::NO_SEAT);
+        deck_.save(checkpoint.deck);
+        checkpoint.discard_pile.clear();
+        for (const auto& card : discard_pile_.cards()) {
+            checkpoint.discard_pile.push_back(card->atlas_index());
+        }
+        for (uint8_t seat = 0; seat < seating_.count(); seat += 1) {
+            players_[seat]->save_hand(checkpoint.hands[seat]);
+        }
+    }
+
+    /// Returns the seat of the current player.
+    uint8_t current_seat() const {
+        return seating_.current();
+    }
+
+    uint8_t seat_count() const {
+        return seating_.count();
+    }
+
+    /// Returns the direction of play.
+    Direction direction() const {
+        return seating_.direction();
+    }
+
+    /// Returns what the current player knows.
+    Observation observe() const {
+        const auto& player = *players_[seating_.current()];
+        Observation observation {};
+        observation.hand = player.face_counts();
+        for (uint8_t steps = 0; steps < seating_.count(); steps += 1) {
+            const auto size = players_[seating_.after(steps)]->hand_size();
+            observation.hand_sizes[steps] =
+                static_cast<uint8_t>(std::min<size_t>(size, 255));
+        }
+        observation.legal_faces = player.playable_faces(discard_pile_);
+        const auto& top = discard_pile_.peek_top();
+        observation.top_face = face_of(top);
+        observation.top_color = color_of(top);
+        observation.direction = seating_.direction();
+        observation.seat = seating_.current();
+        observation.seat_count = seating_.count();
+        observation.pending_draw = discard_pile_.pending_draw();
+        return observation;
+    }
+
+    /// Returns the discard pile.
+    const DiscardPile& discard_pile() const {
+        return discard_pile_;
+    }
 
-        auto card = player.play_card(discard_pile_);
-        Audio::get().play_random_place_sound();
+    /// Returns the player at the seat.
+    const Player& player(uint8_t seat) const {
+        return *players_[seat];
+    }
 
+  private:
+    static std::vector<std::unique_ptr<Player>> create_players(
+        uint8_t seat_count,
+        bool is_spectated
+    ) {
+        std::vector<std::unique_ptr<Player>> players;
+        if (!is_spectated) {
+            players.push_back(std::make_unique<LocalPlayer>());
+        }
+        // AI seats play the plugin named by `UNO_AI_PLUGIN`, if any. It is
+        // loaded again for every game, so a rebuilt library takes over at
+        // the next game.
+        std::shared_ptr<const Plugin> plugin;
+        if (const char* path = std::getenv("UNO_AI_PLUGIN")) {
+            plugin = Plugin::load(path);
+        }
+        while (players.size() < seat_count) {
+            if (plugin != nullptr) {
+                players.push_back(std::make_unique<PluginPlayer>(plugin));
+            } else {
+                players.push_back(
+                    std::make_unique<LinearAiPlayer>(LinearEvaluator::get())
+                );
+            }
+        }
+        return players;
+    }
+
+    /// Keeps the hands of the players in the memory of the game.
+    void seat_players() {
+        for (auto& player : players_) {
+            player->use_memory(arena_.resource(Subsystem::Hands));
+        }
+    }
+
+    AppState play_turn() {
+        if constexpr (GameRules::jump_in) {
+            if (auto jumper = find_jump_in()) {
+                auto& [seat, card] = *jumper;
+                seating_.seat(seat);
+                return play(current_player(), std::move(card));
+            }
+        }
+
+        auto& player = current_player();
         if (player.is_hand_empty()) {
             return AppState::GameOver;
         }
 
-        if (auto wild_card = dynamic_cast<WildCard*>(card.get())) {
-            wild_card->set_color(player.select_wild_color());
-            if (wild_card->symbol() == WildSymbol::WildDrawFour) {
-                next_turn();
-                auto& next_player = current_player();
-                for (uint8_t i = 0; i < 4; i += 1) {
-                    std::this_thread::sleep_for(DRAW_CARD_DELAY);
-                    next_player.draw_from_deck(deck_);
-                    Audio::get().play_random_slide_sound();
+        if constexpr (GameRules::stacking) {
+            // A player who cannot stack takes the whole penalty.
+            if (discard_pile_.pending_draw() > 0
+                && !has_playable_card(player)) {
+                draw_penalty(player, discard_pile_.take_pending_draw());
+                seating_.advance();
+                return AppState::Gameplay;
+            }
+        }
+
+        if constexpr (GameRules::draw_until_playable) {
+            while (!has_playable_card(player)) {
+                draw_card(player, DrawReason::NoPlayableCard);
+            }
+        } else {
+            if (!has_playable_card(player)) {
+                draw_card(player, DrawReason::NoPlayableCard);
+                if (!has_playable_card(player)) {
+                    seating_.advance();
+                    return AppState::Gameplay;
                 }
             }
         }
+
+        player.observe(observe());
+        return play(player, choose_card(player));
+    }
+
+    /// Asks the player for a card to play, timing the decisions of AI
+    /// players. The local player's time is spent waiting for input.
+    unique_ptr<Card> choose_card(Player& player) {
+        if (dynamic_cast<LocalPlayer*>(&player) != nullptr) {
+            return player.play_card(discard_pile_);
+        }
+        const ScopedTimer timer(GameMetrics::get().decision_time);
+        return player.play_card(discard_pile_);
+    }
+
+    /// Deals seven cards to every player and turns over the first card.
+    void deal() {
+        for (auto& player : players_) {
+            for (size_t i = 0; i < 7; i += 1) {
+                player->draw_from_deck(deck_);
+            }
+        }
+
+        auto card = deck_.draw().value();
+        while (dynamic_cast<WildCard*>(card.get())) {
+            turn_up(std::move(card));
+            card = deck_.draw().value();
+        }
+        turn_up(std::move(card));
+    }
+
+    void turn_up(unique_ptr<Card> card) {
+        notify([&](GameListener& listener) {
+            listener.on_card_turned_up(*card);
+        });
+        discard_pile_.push_back(std::move(card));
+    }
+
+    /// Reports an event to the listener and to every player.
+    template <typename F>
+    void notify(F&& event) {
+        event(listener_);
+        for (auto& player : players_) {
+            event(*player);
+        }
+    }
+
+    /// Returns where the indicator of the seat goes, between the seat and the
+    /// center of the table.
+    static sf::Vector2f indicator_position(
+        const TableLayout& layout,
+        uint8_t seat
+    ) {
+        return layout.center()
+            + (layout.seat_position(seat) - layout.center()) * 0.45f;
+    }
+
+    void render_player_indicator(
+        SpriteBatch& batch,
+        const TableLayout& layout,
+        uint8_t seat
+    ) const {
+        sf::CircleShape indicator(40.f, 3);
+        indicator.setOrigin(indicator.getLocalBounds().getCenter());
+        indicator.setPosition(indicator_position(layout, seat));
+        indicator.setRotation(layout.seat_angle(seat) + sf::degrees(90.f));
+        batch.add(indicator);
+    }
+
+    /// Draws an arrow beside the indicator of the current seat, pointing to
+    /// the seat that plays next.
+    void render_direction_indicator(
+        SpriteBatch& batch,
+        const TableLayout& layout,
+        const TableSnapshot& snapshot
+    ) const {
+        if (snapshot.seat_count < MIN_SEATS) {
+            return;
+        }
+        const Seating seating(
+            snapshot.seat_count,
+            snapshot.current_seat,
+            snapshot.direction
+        );
+        const auto from = indicator_position(layout, seating.current());
+        const auto toward = indicator_position(layout, seating.after(1)) - from;
+
+        sf::CircleShape arrow(14.f, 3);
+        arrow.setOrigin(arrow.getLocalBounds().getCenter());
+        arrow.setPosition(from + toward * 0.25f);
+        // The triangle points up before it is rotated.
+        arrow.setRotation(
+            sf::radians(std::atan2(toward.y, toward.x)) + sf::degrees(90.f)
+        );
+        batch.add(arrow);
+    }
+
+    Player& current_player() {
+        return *players_[seating_.current()].get();
+    }
+
+    /// Applies the effects of a card played by the current player and puts it
+    /// on the discard pile.
+    AppState play(Player& player, unique_ptr<Card> card) {
+        assert(discard_pile_.accepts<GameRules::stacking>(*card));
+        auto wild_card = dynamic_cast<WildCard*>(card.get());
+        if (wild_card && !player.is_hand_empty()) {
+            wild_card->set_color(player.select_wild_color());
+        }
+        notify([&](GameListener& listener) {
+            listener.on_card_played(seating_.current(), *card);
+        });
+        top_seat_ = seating_.current();
+
+        if (player.is_hand_empty()) {
+            return AppState::GameOver;
+        }
+
+        if (wild_card && wild_card->symbol() == WildSymbol::WildDrawFour) {
+            penalize_next_player(4);
+        }
+        bool is_next_skipped = false;
         if (auto action_card = dynamic_cast<const ActionCard*>(card.get())) {
             switch (action_card->symbol()) {
-                case ActionSymbol::DrawTwo: {
-                    next_turn();
-                    auto& next_player = current_player();
-                    for (uint8_t i = 0; i < 2; i += 1) {
-                        std::this_thread::sleep_for(DRAW_CARD_DELAY);
-                        next_player.draw_from_deck(deck_);
-                        Audio::get().play_random_slide_sound();
-                    }
+                case ActionSymbol::DrawTwo:
+                    penalize_next_player(2);
                     break;
-                }
                 case ActionSymbol::Reverse:
-                    reverse_direction();
+                    seating_.reverse();
+                    // With two players, a Reverse acts like a Skip.
+                    is_next_skipped = seating_.count() == 2;
                     break;
                 case ActionSymbol::Skip:
-                    next_turn();
+                    is_next_skipped = true;
                     break;
             }
         }
-        next_turn();
+        if constexpr (GameRules::seven_zero) {
+            if (auto number_card =
+                    dynamic_cast<const NumberCard*>(card.get())) {
+                if (number_card->number() == 7) {
+                    swap_hands(player);
+                } else if (number_card->number() == 0) {
+                    rotate_hands();
+                }
+            }
+        }
+        if (is_next_skipped) {
+            seating_.skip();
+        } else {
+            seating_.advance();
+        }
 
-        assert(card->can_play_on(discard_pile_.peek_top()));
         discard_pile_.push_back(std::move(card));
 
         return AppState::Gameplay;
     }
 
-    void render(sf::RenderWindow& window) const {
-        deck_.render(window);
-        discard_pile_.render(window);
-        for (size_t i = 0; i < players_.size(); i += 1) {
-            players_[i]->render(
-                window,
-                discard_pile_,
-                i == static_cast<uint8_t>(position_)
+    /// Returns whether the player holds a card the pile accepts, checking
+    /// for a pending draw only if the rules stack them.
+    bool has_playable_card(const Player& player) const {
+        return player.has_playable_card<GameRules::stacking>(discard_pile_);
+    }
+
+    void penalize_next_player(uint8_t count) {
+        if constexpr (GameRules::stacking) {
+            discard_pile_.add_pending_draw(count);
+        } else {
+            seating_.advance();
+            draw_penalty(current_player(), count);
+        }
+    }
+
+    void draw_card(Player& player, DrawReason reason) {
+        GameMetrics::get().draws.add();
+        if (deck_.size() == 0) {
+            notify([](GameListener& listener) { listener.on_deck_refilled(); });
+        }
+        const auto& card = player.draw_from_deck(deck_);
+        const auto seat = seating_.current();
+        listener_.on_card_drawn(seat, reason, &card);
+        for (uint8_t i = 0; i < players_.size(); i += 1) {
+            players_[i]->on_card_drawn(
+                seat,
+                reason,
+                i == seat ? &card : nullptr
             );
         }
-        // TODO: Add direction indicators
-        render_player_indicator(window);
+        publish();
     }
 
-    Position position() const {
-        return position_;
+    /// Copies the table into a snapshot for the render thread.
+    void publish() {
+        auto& snapshot = snapshots_.back();
+        snapshot.discard_pile.clear();
+        for (const auto& card : discard_pile_.cards()) {
+            snapshot.discard_pile.push_back(card->atlas_index());
+        }
+        for (uint8_t seat = 0; seat < players_.size(); seat += 1) {
+            players_[seat]->snapshot_hand<GameRules::stacking>(
+                discard_pile_, snapshot.hands[seat]
+            );
+        }
+        snapshot.seat_count = seating_.count();
+        snapshot.current_seat = seating_.current();
+        snapshot.direction = seating_.direction();
+        snapshot.pending_draw = discard_pile_.pending_draw();
+        snapshots_.publish();
     }
 
-  private:
-    void render_player_indicator(sf::RenderTarget& render_target) const {
-        const auto player_index = static_cast<int8_t>(position_);
-        sf::CircleShape indicator(40.f, 3);
-        indicator.setOrigin(
-            indicator.getLocalBounds().getCenter()
-            + sf::Vector2f(0.f, player_index % 2 == 0 ? 200.f : 300.f)
-        );
-        indicator.setPosition(sf::Vector2f(render_target.getSize()) / 2.0f);
-        indicator.setRotation(
-            sf::degrees(90.f) * static_cast<float>(player_index)
-        );
-        render_target.draw(indicator);
+    void draw_penalty(Player& player, uint8_t count) {
+        for (uint8_t i = 0; i < count; i += 1) {
+            draw_card(player, DrawReason::Penalty);
+        }
     }
 
-    Player& current_player() {
-        return *players_[static_cast<uint8_t>(position_)].get();
+    /// Finds the first player, in turn order after the current one, who jumps
+    /// in with a card identical to the top card. The player who played the
+    /// top card cannot jump in on it.
+    optional<std::pair<uint8_t, unique_ptr<Card>>> find_jump_in() {
+        for (uint8_t step = 1; step < seating_.count(); step += 1) {
+            const auto seat = seating_.after(step);
+            if (seat == top_seat_) {
+                continue;
+            }
+            if (auto card = players_[seat]->jump_in(discard_pile_)) {
+                return std::pair(seat, std::move(card));
+            }
+        }
+        return std::nullopt;
     }
 
-    void next_turn() {
-        position_ = static_cast<Position>(
-            (static_cast<uint8_t>(position_) + static_cast<int8_t>(direction_))
-            % players_.size()
+    /// Swaps the hand of the player who played a 7 with a player of their
+    /// choice.
+    void swap_hands(Player& player) {
+        std::array<size_t, MAX_SEATS> hand_sizes;
+        for (size_t i = 0; i < players_.size(); i += 1) {
+            hand_sizes[i] = players_[i]->hand_size();
+        }
+        const auto seat = seating_.current();
+        const auto target = player.select_swap_target(
+            std::span(hand_sizes).first(players_.size()),
+            seat
         );
+        if (target != seat) {
+            player.swap_hand(*players_[target]);
+            notify([&](GameListener& listener) {
+                listener.on_hands_swapped(
+                    seat,
+                    static_cast<uint8_t>(target)
+                );
+            });
+        }
     }
 
-    void reverse_direction() {
-        direction_ = static_cast<Direction>(-static_cast<int8_t>(direction_));
+    /// Passes every hand on to the next player in the direction of play.
+    void rotate_hands() {
+        const auto origin = seating_.current();
+        for (uint8_t step = 1; step < seating_.count(); step += 1) {
+            const auto seat = seating_.after(step);
+            players_[origin]->swap_hand(*players_[seat]);
+            notify([&](GameListener& listener) {
+                listener.on_hands_swapped(origin, seat);
+            });
+        }
     }
 
+    // Outlives the cards, hands and discard pile of the game.
+    GameArena arena_;
+
     unsigned int seed_;
     std::mt19937 rng_;
 
@@ -158,6 +628,15 @@ class State {
 
     std::vector<std::unique_ptr<Player>> players_;
 
-    Position position_ = Position::South; // Position of the current player
-    Direction direction_ = Direction::Clockwise; // Direction of play
+    Seating seating_; // Current player and direction of play
+    /// Seat of the player who played the top card, if any did since the
+    /// game was dealt.
+    optional<uint8_t> top_seat_;
+
+    GameListener& listener_;
+
+    mutable TripleBuffer<TableSnapshot> snapshots_;
+    mutable TableSnapshot presented_; // Only touched by the render thread
 };
+
+using State = BasicState<OfficialRules>;
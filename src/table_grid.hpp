@@ -0,0 +1,138 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "presenter.hpp"
+#include "sprite_batch.hpp"
+#include "state.hpp"
+
+/// Plays many tables of AI players at once, and renders them as tiles of a
+/// single window.
+///
+/// One gameplay thread takes turns on every table whose last moves have been
+/// presented. A table that finishes is handed back to the render thread,
+/// which starts a new game there once the last card has landed.
+class TableGrid {
+  public:
+    TableGrid(size_t table_count, uint8_t seat_count) :
+        seat_count_(seat_count) {
+        tables_.reserve(table_count);
+        for (size_t i = 0; i < table_count; i += 1) {
+            tables_.push_back(std::make_unique<Table>());
+            start(*tables_.back());
+        }
+        gameplay_thread_ = std::jthread([this](std::stop_token stop_token) {
+            play(stop_token);
+        });
+    }
+
+    ~TableGrid() {
+        // Stop the gameplay thread before the tables it plays on.
+        gameplay_thread_.request_stop();
+        gameplay_thread_.join();
+    }
+
+    /// Advances the animations of every table by the time elapsed since the
+    /// last frame, and starts new games on the finished tables. Render
+    /// thread only.
+    void update(float seconds, float time_scale) {
+        for (auto& table : tables_) {
+            table->presenter.set_time_scale(time_scale);
+            table->presenter.update(seconds);
+            if (!table->is_running.load(std::memory_order_acquire)
+                && table->presenter.animator().is_idle()) {
+                start(*table);
+            }
+        }
+    }
+
+    /// Adds every table to the batch, each scaled down into its tile of the
+    /// render target. Render thread only.
+    void render(SpriteBatch& batch, sf::Vector2f size) const {
+        const auto column_count = static_cast<size_t>(
+            std::ceil(std::sqrt(static_cast<float>(tables_.size())))
+        );
+        const auto row_count =
+            (tables_.size() + column_count - 1) / column_count;
+        const sf::Vector2f tile_size(
+            size.x / column_count,
+            size.y / row_count
+        );
+        // Tables keep the shape of the render target.
+        const auto scale =
+            std::min(tile_size.x / size.x, tile_size.y / size.y);
+        const auto margin = (tile_size - size * scale) / 2.0f;
+
+        for (size_t i = 0; i < tables_.size(); i += 1) {
+            const sf::Vector2f tile(
+                static_cast<float>(i % column_count),
+                static_cast<float>(i / column_count)
+            );
+            sf::Transform transform;
+            transform.translate(tile.componentWiseMul(tile_size) + margin);
+            transform.scale({scale, scale});
+            batch.set_transform(transform);
+
+            const auto& table = *tables_[i];
+            table.state->render(batch, table.presenter.animator(), size);
+        }
+        batch.set_transform(sf::Transform::Identity);
+    }
+
+    /// Returns the number of games started so far.
+    size_t game_count() const noexcept {
+        return game_count_;
+    }
+
+  private:
+    struct Table {
+        Presenter presenter;
+        std::unique_ptr<State> state;
+        /// Whether the gameplay thread plays the table, or the render thread
+        /// may replace its game.
+        std::atomic<bool> is_running = false;
+    };
+
+    /// Starts a new game on a table the gameplay thread does not play.
+    void start(Table& table) {
+        table.presenter.reset(Presenter::NO_LOCAL_SEAT);
+        table.presenter.set_muted(true);
+        table.state =
+            std::make_unique<State>(seat_count_, table.presenter, true);
+        game_count_ += 1;
+        table.is_running.store(true, std::memory_order_release);
+    }
+
+    void play(std::stop_token stop_token) {
+        while (!stop_token.stop_requested()) {
+            bool has_played = false;
+            for (auto& table : tables_) {
+                if (!table->is_running.load(std::memory_order_acquire)
+                    || !table->presenter.is_presented()) {
+                    continue;
+                }
+                has_played = true;
+                if (table->state->update() == AppState::GameOver) {
+                    table->is_running.store(false, std::memory_order_release);
+                }
+            }
+            if (!has_played) {
+                // Every table is busy animating; check back shortly.
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    uint8_t seat_count_;
+    std::vector<std::unique_ptr<Table>> tables_;
+    size_t game_count_ = 0; // Only touched by the render thread
+    std::jthread gameplay_thread_;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+/// Places the seats of a table evenly around an ellipse inscribed in the
+/// render target, clockwise from seat 0 at the bottom.
+class TableLayout {
+  public:
+    TableLayout(sf::Vector2f size, uint8_t seat_count) :
+        center_(size / 2.0f),
+        radius_(size / 2.0f - sf::Vector2f(MARGIN, MARGIN)),
+        seat_count_(seat_count) {}
+
+    /// Returns the direction from the center of the table to the seat.
+    sf::Angle seat_angle(uint8_t seat) const {
+        return sf::degrees(90.0f + 360.0f * seat / seat_count_);
+    }
+
+    /// Returns the position of the seat on the ellipse.
+    sf::Vector2f seat_position(uint8_t seat) const {
+        const auto angle = seat_angle(seat).asRadians();
+        const sf::Vector2f direction(std::cos(angle), std::sin(angle));
+        return center_ + direction.componentWiseMul(radius_);
+    }
+
+    /// Returns the transform that moves a hand laid out along the x-axis
+    /// around the origin to the seat, facing the center of the table.
+    sf::Transform seat_transform(uint8_t seat) const {
+        sf::Transform transform;
+        transform.translate(seat_position(seat));
+        transform.rotate(seat_angle(seat) - sf::degrees(90.0f));
+        transform.scale({hand_scale(), hand_scale()});
+        return transform;
+    }
+
+    /// Returns the width available to a hand before scaling.
+    float hand_width() const {
+        const auto circumference =
+            std::numbers::pi_v<float> * (radius_.x + radius_.y);
+        return circumference / seat_count_ * 0.5f / hand_scale();
+    }
+
+    /// Returns the size of the table.
+    sf::Vector2f size() const {
+        return center_ * 2.0f;
+    }
+
+    /// Returns the position of the discard pile.
+    sf::Vector2f center() const {
+        return center_;
+    }
+
+    /// Returns the position of the deck, left of the discard pile.
+    sf::Vector2f deck_position() const {
+        return center_ - sf::Vector2f(170.0f, 0.0f);
+    }
+
+  private:
+    /// Returns the scale of opponents' hands, which shrink on large tables.
+    float hand_scale() const {
+        return std::min(1.0f, 6.0f / seat_count_);
+    }
+
+    /// Distance between the ellipse and the edge of the render target.
+    static constexpr float MARGIN = 66.0f;
+
+    sf::Vector2f center_;
+    sf::Vector2f radius_;
+    uint8_t seat_count_;
+};
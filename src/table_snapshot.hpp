@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "card/composition.hpp"
+#include "seating.hpp"
+
+/// A card in hand as the renderer sees it.
+struct CardView {
+    uint8_t atlas_index;
+    bool is_playable; // Whether the discard pile accepts the card
+};
+
+/// A copy of everything a frame of the table shows. The engine publishes one
+/// after every change, and the render thread draws from it alone.
+struct TableSnapshot {
+    /// Cards the discard pile and each hand have room for from the start.
+    static constexpr size_t RESERVED_PILE_SIZE = 4 * DECK_SIZE;
+    static constexpr size_t RESERVED_HAND_SIZE = 32;
+
+    /// Makes room for the cards of all but the longest games, so that
+    /// publishing a table does not allocate once the game is under way.
+    TableSnapshot() {
+        discard_pile.reserve(RESERVED_PILE_SIZE);
+        for (auto& hand : hands) {
+            hand.reserve(RESERVED_HAND_SIZE);
+        }
+    }
+
+    std::vector<uint8_t> discard_pile; // Atlas indices, from the bottom
+    std::array<std::vector<CardView>, MAX_SEATS> hands;
+    uint8_t seat_count = 0;
+    uint8_t current_seat = 0;
+    Direction direction = Direction::Clockwise;
+    uint8_t pending_draw = 0;
+};
@@ -3,22 +3,25 @@
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "button.hpp"
+#include "label.hpp"
 
 class TextButton: public Button {
   public:
-    TextButton(sf::Text&& text, sf::Color text_color, sf::Color button_color) :
+    TextButton(Label&& text, sf::Color text_color, sf::Color button_color) :
         Button(create_shape(button_color)),
-        text_(text) {
-        text_.setFillColor(text_color);
-        text_.setOrigin(text_.getLocalBounds().getCenter());
+        text_(std::move(text)) {
+        text_.set_color(text_color);
+        text_.setOrigin(text_.local_bounds().getCenter());
         text_.setPosition(shape().getGlobalBounds().getCenter());
     }
 
-    virtual void render(sf::RenderWindow& window) const override {
-        Button::render(window);
-        window.draw(text_);
+    virtual void render(SpriteBatch& batch, sf::Vector2f mouse_position)
+        const override {
+        Button::render(batch, mouse_position);
+        text_.render(batch);
     }
 
     virtual void set_position(sf::Vector2f position) override {
@@ -27,13 +30,13 @@ class TextButton: public Button {
     }
 
     void set_text(const std::string& text) {
-        text_.setString(text);
-        text_.setOrigin(text_.getLocalBounds().getCenter());
+        text_.set_text(text);
+        text_.setOrigin(text_.local_bounds().getCenter());
         text_.setPosition(shape().getGlobalBounds().getCenter());
     }
 
     void set_text_color(const sf::Color& color) {
-        text_.setFillColor(color);
+        text_.set_color(color);
     }
 
   private:
@@ -45,5 +48,5 @@ class TextButton: public Button {
         return shape;
     }
 
-    sf::Text text_;
+    Label text_;
 };
\ No newline at end of file
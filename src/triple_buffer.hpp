@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/// Hands values from one writer thread to one reader thread without locks.
+///
+/// The writer fills the back buffer and publishes it, while the reader keeps
+/// reading the front buffer until it asks for a newer one. Publishing and
+/// acquiring swap buffers through a single atomic index, so neither side
+/// ever waits for the other, and the reader always sees a whole value.
+template <typename T>
+class TripleBuffer {
+  public:
+    /// Returns the buffer to write the next value into. It holds an older
+    /// value, which must be overwritten. Writer thread only.
+    T& back() noexcept {
+        return buffers_[back_];
+    }
+
+    /// Makes the back buffer the latest value. Writer thread only.
+    void publish() noexcept {
+        const auto previous =
+            middle_.exchange(back_ | FRESH, std::memory_order_acq_rel);
+        back_ = previous & INDEX_MASK;
+    }
+
+    /// Returns the latest published value. Reader thread only.
+    const T& front() noexcept {
+        if (middle_.load(std::memory_order_relaxed) & FRESH) {
+            const auto previous =
+                middle_.exchange(front_, std::memory_order_acq_rel);
+            front_ = previous & INDEX_MASK;
+        }
+        return buffers_[front_];
+    }
+
+  private:
+    static constexpr uint8_t INDEX_MASK = 0b011;
+    /// Marks a middle buffer that the reader has not taken yet.
+    static constexpr uint8_t FRESH = 0b100;
+
+    std::array<T, 3> buffers_ {};
+    uint8_t back_ = 0;                // Owned by the writer
+    std::atomic<uint8_t> middle_ = 1; // Exchanged by both threads
+    uint8_t front_ = 2;               // Owned by the reader
+};
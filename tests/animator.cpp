@@ -0,0 +1,115 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/animator.hpp"
+
+#include <doctest/doctest.h>
+
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr CardMotion DRAW {CardMotion::Kind::Draw, 1, 7, false, 0.0f};
+constexpr CardMotion PLAY {CardMotion::Kind::Play, 1, 7, true, 0.0f};
+
+/// Advances the animator and returns the motions that set off.
+std::vector<CardMotion> update(Animator& animator, float seconds) {
+    std::vector<CardMotion> started;
+    animator.update(seconds, [&](const CardMotion& motion) {
+        started.push_back(motion);
+    });
+    return started;
+}
+} // namespace
+
+TEST_CASE("Animator plays motions one after another") {
+    Animator animator;
+    animator.push(DRAW);
+    animator.push(PLAY);
+    CHECK_FALSE(animator.is_idle());
+
+    auto started = update(animator, Animator::TIME_STEP);
+    REQUIRE(started.size() == 1);
+    CHECK(started[0].kind == CardMotion::Kind::Draw);
+
+    // Advancing in many small frames or one large frame takes as long.
+    for (int i = 0; i < 9; i += 1) {
+        CHECK(update(animator, Animator::DRAW_DURATION / 10).empty());
+    }
+    started = update(animator, Animator::DRAW_DURATION / 5);
+    REQUIRE(started.size() == 1);
+    CHECK(started[0].kind == CardMotion::Kind::Play);
+
+    for (int i = 0; i < 10; i += 1) {
+        update(animator, Animator::PLAY_DURATION / 8);
+    }
+    CHECK(animator.is_idle());
+}
+
+TEST_CASE("Animator hides the cards that have not arrived") {
+    TableSnapshot snapshot;
+    snapshot.hands[1] = {{3, false}, {7, false}};
+    snapshot.discard_pile = {7, 2, 7};
+
+    Animator animator;
+    animator.push(DRAW);
+    animator.push({CardMotion::Kind::Play, 1, 7, true, 1.0f});
+    update(animator, Animator::TIME_STEP);
+
+    auto presented = snapshot;
+    animator.hide_moving_cards(presented);
+    CHECK(presented.hands[1].size() == 2);
+    CHECK(presented.hands[1][0].atlas_index == 3);
+    CHECK(presented.hands[1][1].atlas_index == 7); // About to be played
+    CHECK(presented.discard_pile == std::vector<uint8_t> {7, 2});
+
+    while (!animator.is_idle()) {
+        update(animator, 0.2f);
+    }
+    presented = snapshot;
+    animator.hide_moving_cards(presented);
+    CHECK(presented.hands[1].size() == 2);
+    CHECK(presented.discard_pile == snapshot.discard_pile);
+}
+
+TEST_CASE("Animator releases the gameplay thread") {
+    Animator animator;
+    animator.wait_until_idle();
+
+    animator.push(DRAW);
+    std::jthread gameplay([&] { animator.wait_until_idle(); });
+    while (!animator.is_idle()) {
+        update(animator, Animator::TIME_STEP);
+    }
+    gameplay.join();
+
+    animator.push(DRAW);
+    std::jthread cancelled([&] { animator.wait_until_idle(); });
+    animator.cancel();
+    cancelled.join();
+
+    // A cancelled animator drops new motions until it is reset.
+    animator.push(DRAW);
+    animator.wait_until_idle();
+    animator.reset();
+    CHECK(animator.is_idle());
+}
+
+TEST_CASE("Animator hides the cards of motions that have not set off") {
+    TableSnapshot snapshot;
+    snapshot.hands[1] = {{3, false}, {7, false}};
+    snapshot.discard_pile = {2};
+
+    // The snapshot comes in before the next step takes the motion.
+    Animator animator;
+    animator.push(DRAW);
+    auto presented = snapshot;
+    animator.hide_moving_cards(presented);
+    CHECK(presented.hands[1].size() == 1);
+    CHECK(presented.hands[1][0].atlas_index == 3);
+
+    auto started = update(animator, Animator::TIME_STEP);
+    CHECK(started.size() == 1);
+    presented = snapshot;
+    animator.hide_moving_cards(presented);
+    CHECK(presented.hands[1].size() == 1);
+}
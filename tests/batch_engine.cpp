@@ -0,0 +1,68 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/simulation/batch_engine.hpp"
+
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <vector>
+
+#include "../src/state.hpp"
+#include "players.hpp"
+
+namespace {
+std::unique_ptr<State> create_ai_state(uint8_t seat_count, unsigned int seed) {
+    return std::make_unique<State>(create_ai_players(seat_count), seed);
+}
+} // namespace
+
+TEST_CASE("BatchEngine plays the same games as State") {
+    constexpr size_t GAME_COUNT = 32;
+    constexpr unsigned int FIRST_SEED = 1000;
+
+    for (uint8_t seat_count : {2, 4, 7, 10}) {
+        BatchEngine batch(GAME_COUNT, seat_count, FIRST_SEED);
+        std::vector<std::unique_ptr<State>> states;
+        for (size_t game = 0; game < GAME_COUNT; game += 1) {
+            states.push_back(create_ai_state(seat_count, FIRST_SEED + game));
+            const auto& top = states[game]->discard_pile().peek_top();
+            CHECK(batch.top_face(game) == face_of(top));
+        }
+
+        std::vector<bool> finished(GAME_COUNT, false);
+        size_t running;
+        do {
+            running = batch.step();
+            for (size_t game = 0; game < GAME_COUNT; game += 1) {
+                if (finished[game]) {
+                    continue;
+                }
+                auto& state = *states[game];
+                if (state.update() == AppState::GameOver) {
+                    finished[game] = true;
+                    REQUIRE(batch.is_finished(game));
+                    CHECK(batch.winner(game) == state.current_seat());
+                    continue;
+                }
+                REQUIRE_FALSE(batch.is_finished(game));
+                CHECK(batch.current_seat(game) == state.current_seat());
+
+                const auto& top = state.discard_pile().peek_top();
+                CHECK(batch.top_face(game) == face_of(top));
+                if (auto wild_card = dynamic_cast<const WildCard*>(&top)) {
+                    CHECK(batch.top_color(game) == wild_card->color().value());
+                }
+                for (uint8_t seat = 0; seat < seat_count; seat += 1) {
+                    CHECK(
+                        batch.hand_size(game, seat)
+                        == state.player(seat).hand_size()
+                    );
+                }
+            }
+        } while (running > 0);
+
+        for (size_t game = 0; game < GAME_COUNT; game += 1) {
+            CHECK(finished[game]);
+        }
+    }
+}
@@ -2,7 +2,11 @@
 
 #include <doctest/doctest.h>
 
+#include <stdexcept>
+
 #include "../src/card/action_card.hpp"
+#include "../src/card/create_card.hpp"
+#include "../src/card/face.hpp"
 #include "../src/card/number_card.hpp"
 #include "../src/card/wild_card.hpp"
 
@@ -96,3 +100,25 @@ TEST_CASE("WildCard properties and behavior") {
         CHECK(wild_draw_four.can_play_on(blue_five));
     }
 }
+
+TEST_CASE("Cards are played on a wild card of their color") {
+    WildCard wild(WildSymbol::Wild);
+    wild.set_color(Color::Green);
+    CHECK(NumberCard(Color::Green, 3).can_play_on(wild));
+    CHECK(ActionCard(Color::Green, ActionSymbol::Skip).can_play_on(wild));
+    CHECK_FALSE(NumberCard(Color::Red, 3).can_play_on(wild));
+    CHECK(WildCard(WildSymbol::WildDrawFour).can_play_on(wild));
+}
+
+TEST_CASE("create_card makes the card of every atlas index") {
+    for (uint8_t atlas_index = 0; atlas_index < ATLAS_CARD_COUNT;
+         atlas_index += 1) {
+        if (!is_card_atlas_index(atlas_index)) {
+            CHECK_THROWS_AS(create_card(atlas_index), std::invalid_argument);
+            continue;
+        }
+        const auto card = create_card(atlas_index);
+        CHECK(card->atlas_index() == atlas_index);
+        CHECK(face_of(*card) == atlas_face(atlas_index));
+    }
+}
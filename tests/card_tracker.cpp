@@ -0,0 +1,109 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/card_tracker.hpp"
+
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <vector>
+
+#include "../src/card/number_card.hpp"
+#include "../src/state.hpp"
+#include "players.hpp"
+
+namespace {
+constexpr Face RED_THREE = 3;
+constexpr Face RED_FIVE = 5;
+constexpr Face BLUE_FIVE = RANKS_PER_COLOR + 5;
+
+/// Counts the decks put into play.
+class RefillCounter: public GameListener {
+  public:
+    void on_deck_refilled() override {
+        refill_count += 1;
+    }
+
+    size_t refill_count = 0;
+};
+} // namespace
+
+TEST_CASE("CardTracker counts the unseen copies of each face") {
+    CardTracker tracker;
+    CHECK(tracker.unseen(RED_FIVE, 0) == 2);
+    CHECK(tracker.unseen(WILD_FACE, 1) == 3);
+
+    tracker.on_card_turned_up(NumberCard(Color::Red, 5));
+    CHECK(tracker.unseen(RED_FIVE, 0) == 1);
+    CHECK(tracker.unseen(RED_FIVE, 1) == 0);
+
+    tracker.on_card_played(1, NumberCard(Color::Red, 5));
+    CHECK(tracker.unseen(RED_FIVE, 0) == 0);
+
+    tracker.on_deck_refilled();
+    CHECK(tracker.unseen(RED_FIVE, 0) == 2);
+
+    std::array<uint8_t, FACE_COUNT> hand {};
+    hand[BLUE_FIVE] = 1;
+    const auto unseen = tracker.unseen_faces(hand);
+    CHECK(unseen[RED_FIVE] == 2);
+    CHECK(unseen[BLUE_FIVE] == 3);
+}
+
+TEST_CASE("CardTracker infers the faces a player does not hold") {
+    CardTracker tracker;
+    tracker.on_card_turned_up(NumberCard(Color::Red, 3));
+    tracker.on_card_drawn(2, DrawReason::NoPlayableCard, nullptr);
+
+    const auto playable = playable_faces(Color::Red, 3);
+    CHECK(tracker.voids(2) == playable);
+    CHECK(tracker.voids(1) == 0);
+    CHECK(tracker.is_void(2, Color::Red));
+    CHECK_FALSE(tracker.is_void(2, Color::Blue));
+    CHECK((tracker.voids(2) >> RED_THREE & 1) == 1);
+    CHECK((tracker.voids(2) >> WILD_DRAW_FOUR_FACE & 1) == 1);
+
+    tracker.on_hands_swapped(2, 0);
+    CHECK(tracker.voids(0) == playable);
+    CHECK(tracker.voids(2) == 0);
+
+    tracker.on_card_drawn(0, DrawReason::Penalty, nullptr);
+    CHECK(tracker.voids(0) == 0);
+}
+
+TEST_CASE("CardTracker agrees with the cards in play") {
+    for (unsigned int seed = 0; seed < 20; seed += 1) {
+        RefillCounter refills;
+        State state(create_ai_players(), seed, refills);
+
+        // The winning card never reaches the discard pile.
+        while (state.update() != AppState::GameOver) {
+            std::array<uint16_t, FACE_COUNT> discarded {};
+            for (const auto& card : state.discard_pile().cards()) {
+                discarded[face_of(*card)] += 1;
+            }
+            for (uint8_t seat = 0; seat < 4; seat += 1) {
+                const auto& player = state.player(seat);
+                const auto& tracker =
+                    dynamic_cast<const AiPlayer&>(player).tracker();
+                const auto hand = player.face_counts();
+                for (Face face = 0; face < FACE_COUNT; face += 1) {
+                    const int unseen = FACE_COPIES[face]
+                            * (1 + static_cast<int>(refills.refill_count))
+                        - discarded[face] - hand[face];
+                    REQUIRE(tracker.unseen(face, hand[face])
+                            == std::max(unseen, 0));
+                }
+
+                // No player holds a face they are known not to hold.
+                for (uint8_t other = 0; other < 4; other += 1) {
+                    uint64_t faces = 0;
+                    const auto counts = state.player(other).face_counts();
+                    for (Face face = 0; face < FACE_COUNT; face += 1) {
+                        faces |= uint64_t {counts[face] > 0} << face;
+                    }
+                    REQUIRE((tracker.voids(other) & faces) == 0);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,245 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/checkpoint.hpp"
+
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/state.hpp"
+#include "players.hpp"
+
+namespace {
+/// Records the cards played and drawn, in order.
+class MoveRecorder: public GameListener {
+  public:
+    void on_card_played(uint8_t seat, const Card& card) override {
+        moves.emplace_back(seat, card.atlas_index());
+    }
+
+    void on_card_drawn(uint8_t seat, DrawReason, const Card*) override {
+        moves.emplace_back(seat, 255);
+    }
+
+    std::vector<std::pair<uint8_t, uint8_t>> moves;
+};
+
+/// Plays the game to its end, and returns the winner.
+template <typename GameRules>
+uint8_t play_out(BasicState<GameRules>& state) {
+    while (state.update() != AppState::GameOver) {}
+    return state.current_seat();
+}
+
+/// Checks that games resumed from a checkpoint at every turn carry on as the
+/// game they were saved from.
+template <typename GameRules>
+void check_resumed_games(unsigned int seed, uint8_t seat_count) {
+    MoveRecorder original_moves;
+    BasicState<GameRules> original(
+        create_ai_players(seat_count),
+        seed,
+        original_moves
+    );
+    const auto winner = play_out(original);
+
+    MoveRecorder moves;
+    BasicState<GameRules> state(create_ai_players(seat_count), seed, moves);
+    Checkpoint checkpoint;
+    do {
+        state.checkpoint(checkpoint);
+        std::string payload;
+        checkpoint.encode(payload);
+        MoveRecorder resumed_moves;
+        BasicState<GameRules> resumed(
+            create_ai_players(seat_count),
+            Checkpoint::decode(std::as_bytes(std::span(payload))),
+            resumed_moves
+        );
+        REQUIRE(play_out(resumed) == winner);
+        resumed_moves.moves.insert(
+            resumed_moves.moves.begin(),
+            moves.moves.begin(),
+            moves.moves.end()
+        );
+        REQUIRE(resumed_moves.moves == original_moves.moves);
+    } while (state.update() != AppState::GameOver);
+}
+
+Checkpoint checkpoint_of(uint32_t table, unsigned int seed) {
+    State state(create_ai_players(3), seed);
+    Checkpoint checkpoint;
+    state.checkpoint(checkpoint);
+    checkpoint.table = table;
+    return checkpoint;
+}
+
+std::filesystem::path log_path(const char* name) {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(path);
+    return path;
+}
+} // namespace
+
+TEST_CASE("Games resumed from a checkpoint play out the same") {
+    for (unsigned int seed = 0; seed < 8; seed += 1) {
+        check_resumed_games<OfficialRules>(seed, 4);
+        check_resumed_games<HouseRules>(seed, 3);
+    }
+}
+
+TEST_CASE("AI players resumed from a checkpoint know the cards played") {
+    for (unsigned int seed = 0; seed < 8; seed += 1) {
+        State state(create_ai_players(4), seed);
+        // The winning card never reaches the discard pile, so a finished game
+        // is not resumed.
+        bool is_over = false;
+        for (size_t turn = 0; turn < 60 && !is_over; turn += 1) {
+            is_over = state.update() == AppState::GameOver;
+        }
+        if (is_over) {
+            continue;
+        }
+        Checkpoint checkpoint;
+        state.checkpoint(checkpoint);
+        const State resumed(create_ai_players(4), checkpoint);
+        for (uint8_t seat = 0; seat < 4; seat += 1) {
+            const auto& player = state.player(seat);
+            const auto& tracker =
+                dynamic_cast<const AiPlayer&>(player).tracker();
+            const auto& resumed_tracker =
+                dynamic_cast<const AiPlayer&>(resumed.player(seat)).tracker();
+            CHECK(resumed.player(seat).face_counts() == player.face_counts());
+            const auto hand = player.face_counts();
+            CHECK(
+                resumed_tracker.unseen_faces(hand) == tracker.unseen_faces(hand)
+            );
+        }
+    }
+}
+
+TEST_CASE("Malformed checkpoints are rejected") {
+    auto checkpoint = checkpoint_of(1, 7);
+    std::string payload;
+    checkpoint.encode(payload);
+    const auto bytes = std::as_bytes(std::span(payload));
+    CHECK_THROWS_AS(
+        Checkpoint::decode(bytes.first(bytes.size() - 1)),
+        std::runtime_error
+    );
+
+    checkpoint.hands[0].push_back(54);
+    payload.clear();
+    checkpoint.encode(payload);
+    CHECK_THROWS_AS(
+        Checkpoint::decode(std::as_bytes(std::span(payload))),
+        std::runtime_error
+    );
+}
+
+TEST_CASE("CheckpointLog keeps the latest checkpoint of unfinished tables") {
+    const auto path = log_path("uno_checkpoint_test.checkpoint");
+    CHECK(CheckpointLog::load(path).empty());
+    {
+        CheckpointLog log(path);
+        log.append(checkpoint_of(2, 1));
+        log.append(checkpoint_of(1, 2));
+        log.append(checkpoint_of(3, 3));
+        log.append(checkpoint_of(2, 4));
+        log.finish(3);
+        log.flush();
+    }
+    const auto checkpoints = CheckpointLog::load(path);
+    REQUIRE(checkpoints.size() == 2);
+    CHECK(checkpoints[0].table == 1);
+    CHECK(checkpoints[0].seed == 2);
+    CHECK(checkpoints[1].table == 2);
+    CHECK(checkpoints[1].seed == 4);
+    CHECK(checkpoints[1].deck == checkpoint_of(2, 4).deck);
+
+    // Reopening the log compacts it into the same checkpoints, which the
+    // open log hands out without reading the file again.
+    {
+        CheckpointLog log(path);
+        log.flush();
+        const auto reopened = log.checkpoints();
+        REQUIRE(reopened.size() == 2);
+        CHECK(reopened[0].table == 1);
+        CHECK(reopened[1].seed == 4);
+    }
+    const auto compacted = CheckpointLog::load(path);
+    REQUIRE(compacted.size() == 2);
+    CHECK(compacted[1].hands[2] == checkpoints[1].hands[2]);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("CheckpointLog ignores a record torn by a crash") {
+    const auto path = log_path("uno_checkpoint_torn.checkpoint");
+    {
+        CheckpointLog log(path);
+        log.append(checkpoint_of(1, 1));
+        log.append(checkpoint_of(1, 2));
+        log.flush();
+    }
+    const auto size = std::filesystem::file_size(path);
+
+    // A torn record: its last byte never made it to the file.
+    std::filesystem::resize_file(path, size - 1);
+    auto checkpoints = CheckpointLog::load(path);
+    REQUIRE(checkpoints.size() == 1);
+    CHECK(checkpoints[0].seed == 1);
+
+    // A corrupt record: its bytes do not match its checksum.
+    {
+        CheckpointLog log(path);
+        log.append(checkpoint_of(1, 3));
+        log.flush();
+    }
+    {
+        std::fstream file(
+            path,
+            std::ios::binary | std::ios::in | std::ios::out
+        );
+        file.seekp(-1, std::ios::end);
+        file.put('\xff');
+    }
+    checkpoints = CheckpointLog::load(path);
+    REQUIRE(checkpoints.size() == 1);
+    CHECK(checkpoints[0].seed == 1);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("CheckpointLog compacts itself as it grows") {
+    const auto path = log_path("uno_checkpoint_compact.checkpoint");
+    const auto checkpoint = checkpoint_of(1, 1);
+    std::string payload;
+    checkpoint.encode(payload);
+    {
+        CheckpointLog log(path, 4096);
+        for (size_t i = 0; i < 1000; i += 1) {
+            log.append(checkpoint);
+            log.flush();
+            CHECK(std::filesystem::file_size(path) < 4096 + 2 * payload.size());
+        }
+    }
+    CHECK(CheckpointLog::load(path).size() == 1);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("CheckpointLog rejects other files") {
+    const auto path = log_path("uno_checkpoint_invalid.checkpoint");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not a checkpoint log";
+    }
+    CHECK_THROWS_AS(CheckpointLog::load(path), std::runtime_error);
+    CHECK_THROWS_AS(CheckpointLog {path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
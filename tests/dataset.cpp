@@ -0,0 +1,87 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/simulation/dataset.hpp"
+
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+namespace {
+constexpr size_t GAME_COUNT = 64;
+constexpr uint8_t SEAT_COUNT = 3;
+constexpr uint32_t BLOCK_ROWS = 256;
+} // namespace
+
+TEST_CASE("DatasetReader reads the moves written by DatasetWriter") {
+    const auto path =
+        std::filesystem::temp_directory_path() / "uno_dataset_test.unodata";
+
+    size_t turn_count = 0;
+    std::vector<uint8_t> winners;
+    {
+        DatasetWriter writer(path, BLOCK_ROWS);
+        for (unsigned int first_seed : {0u, 1000u}) {
+            BatchEngine batch(GAME_COUNT, SEAT_COUNT, first_seed);
+            writer.begin_batch(batch.game_count());
+            batch.set_listener(&writer);
+            batch.run();
+            for (size_t game = 0; game < GAME_COUNT; game += 1) {
+                turn_count += batch.turn_count(game);
+                winners.push_back(batch.winner(game));
+            }
+        }
+        writer.finish();
+        CHECK(writer.row_count() == turn_count);
+    }
+
+    {
+        const DatasetReader reader(path);
+        REQUIRE(reader.row_count() == turn_count);
+        CHECK(
+            reader.block_count() == (turn_count + BLOCK_ROWS - 1) / BLOCK_ROWS
+        );
+
+        size_t rows = 0;
+        for (size_t i = 0; i < reader.block_count(); i += 1) {
+            const auto block = reader.block(i);
+            for (size_t row = 0; row < block.row_count(); row += 1) {
+                const auto game = block.games()[row];
+                REQUIRE(game < winners.size());
+                CHECK(block.winners()[row] == winners[game]);
+                CHECK(block.seat_counts()[row] == SEAT_COUNT);
+                CHECK(block.seats()[row] < SEAT_COUNT);
+
+                // The first hand size is the size of the player's own hand.
+                const auto& hand = block.hands()[row];
+                CHECK(
+                    std::accumulate(hand.begin(), hand.end(), 0u)
+                    == block.hand_sizes()[row][0]
+                );
+
+                // Every action is a legal card from the hand.
+                const auto face = block.action_faces()[row];
+                CHECK((block.legal_faces()[row] >> face & 1) == 1);
+                if (!is_wild(face)) {
+                    CHECK(block.action_colors()[row] == face_color(face));
+                }
+            }
+            rows += block.row_count();
+        }
+        CHECK(rows == turn_count);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("DatasetReader rejects files that are not datasets") {
+    const auto path =
+        std::filesystem::temp_directory_path() / "uno_dataset_invalid.unodata";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not a dataset";
+    }
+    CHECK_THROWS_AS(DatasetReader {path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
@@ -4,7 +4,11 @@
 
 #include <doctest/doctest.h>
 
+#include <array>
 #include <random>
+#include <vector>
+
+#include "../src/card/face.hpp"
 
 TEST_CASE("Deck initializes with 108 cards and draws correctly") {
     std::mt19937 rng {42};
@@ -52,3 +56,38 @@ TEST_CASE("Deck shuffles cards on initialization") {
 
     CHECK(card1.value().get() != card2.value().get());
 }
+
+TEST_CASE("Deck holds every face as many times as FACE_COPIES") {
+    std::mt19937 rng {7};
+    Deck deck(rng);
+    for (int round = 0; round < 3; round += 1) {
+        std::array<uint8_t, FACE_COUNT> copies {};
+        for (size_t i = 0; i < DECK_SIZE; i += 1) {
+            copies[face_of(*deck.draw().value())] += 1;
+        }
+        CHECK(copies == FACE_COPIES);
+        CHECK(deck.size() == 0);
+    }
+}
+
+TEST_CASE("Deck deals the same cards for the same seed") {
+    // Seeded games, replays and checkpoints depend on this order.
+    constexpr std::array<uint8_t, 12> FIRST_CARDS =
+        {6, 34, 6, 0, 14, 53, 7, 37, 53, 9, 51, 24};
+    std::mt19937 rng {42};
+    Deck deck(rng);
+    for (const auto atlas_index : FIRST_CARDS) {
+        CHECK(deck.draw().value()->atlas_index() == atlas_index);
+    }
+
+    // A restored deck draws the same cards, and shuffles the same next deck.
+    std::vector<uint8_t> saved;
+    deck.save(saved);
+    Deck restored(std::mt19937 {42}, deck.shuffle_count(), saved);
+    for (size_t i = 0; i < DECK_SIZE + 10; i += 1) {
+        CHECK(
+            restored.draw().value()->atlas_index()
+            == deck.draw().value()->atlas_index()
+        );
+    }
+}
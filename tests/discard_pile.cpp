@@ -33,3 +33,27 @@ TEST_CASE("DiscardPile basic operations") {
     CHECK(dynamic_cast<WildCard*>(pile.cards().back().get()) != nullptr);
     CHECK(pile.peek_top().value() == 50);
 }
+
+TEST_CASE("DiscardPile accepts only draw cards while a penalty is pending") {
+    DiscardPile pile;
+    pile.push_back(
+        std::make_unique<ActionCard>(Color::Red, ActionSymbol::DrawTwo)
+    );
+    CHECK(pile.pending_draw() == 0);
+    CHECK(pile.accepts(NumberCard(Color::Red, 5)));
+
+    pile.add_pending_draw(2);
+    CHECK(pile.pending_draw() == 2);
+    CHECK_FALSE(pile.accepts(NumberCard(Color::Red, 5)));
+    CHECK_FALSE(pile.accepts(WildCard(WildSymbol::Wild)));
+    CHECK(pile.accepts(ActionCard(Color::Blue, ActionSymbol::DrawTwo)));
+    CHECK(pile.accepts(WildCard(WildSymbol::WildDrawFour)));
+
+    pile.push_back(std::make_unique<WildCard>(WildSymbol::WildDrawFour));
+    pile.add_pending_draw(4);
+    CHECK_FALSE(pile.accepts(ActionCard(Color::Blue, ActionSymbol::DrawTwo)));
+    CHECK(pile.accepts(WildCard(WildSymbol::WildDrawFour)));
+
+    CHECK(pile.take_pending_draw() == 6);
+    CHECK(pile.pending_draw() == 0);
+}
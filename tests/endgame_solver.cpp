@@ -0,0 +1,80 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/player/endgame_solver.hpp"
+
+#include <doctest/doctest.h>
+
+namespace {
+constexpr Face RED_FIVE = 5;
+constexpr Face RED_SKIP = SKIP_RANK;
+constexpr Face RED_THREE = 3;
+constexpr Face BLUE_NINE = RANKS_PER_COLOR + 9;
+
+/// Returns a two-player position on a Red 3, with the given hand against an
+/// opponent holding the given number of cards.
+Observation two_player_position(
+    std::initializer_list<Face> hand,
+    uint8_t opponent_hand_size
+) {
+    Observation observation {};
+    for (const auto face : hand) {
+        observation.hand[face] += 1;
+        if (playable_faces(Color::Red, 3) >> face & 1) {
+            observation.legal_faces |= uint64_t {1} << face;
+        }
+    }
+    observation.hand_sizes[0] = static_cast<uint8_t>(hand.size());
+    observation.hand_sizes[1] = opponent_hand_size;
+    observation.top_face = RED_THREE;
+    observation.top_color = Color::Red;
+    observation.direction = Direction::Clockwise;
+    observation.seat_count = 2;
+    return observation;
+}
+} // namespace
+
+TEST_CASE("EndgameSolver plays the last card") {
+    EndgameSolver solver;
+    const auto action =
+        solver.solve(two_player_position({RED_FIVE}, 1), FACE_COPIES);
+    REQUIRE(action.has_value());
+    CHECK(action->face == RED_FIVE);
+    CHECK(solver.value() == 1.0f);
+    CHECK(solver.is_exact());
+}
+
+TEST_CASE("EndgameSolver finds a forced win") {
+    // Skipping the opponent leaves the Red 5 to win, while playing the Red 5
+    // first gives the opponent a turn with their last card.
+    EndgameSolver solver;
+    const auto action = solver.solve(
+        two_player_position({RED_FIVE, RED_SKIP}, 1),
+        FACE_COPIES
+    );
+    REQUIRE(action.has_value());
+    CHECK(action->face == RED_SKIP);
+    CHECK(solver.value() == doctest::Approx(1.0f));
+    CHECK(solver.is_exact());
+}
+
+TEST_CASE("EndgameSolver applies below the card threshold") {
+    EndgameSolver solver({.card_threshold = 4});
+    CHECK(solver.applies(two_player_position({RED_FIVE, BLUE_NINE}, 2)));
+    CHECK_FALSE(
+        solver.applies(two_player_position({RED_FIVE, BLUE_NINE}, 3))
+    );
+    CHECK_FALSE(EndgameSolver({.card_threshold = 0})
+                    .applies(two_player_position({RED_FIVE}, 1)));
+}
+
+TEST_CASE("EndgameSolver stays within the node budget") {
+    EndgameSolver solver({.node_budget = 500});
+    const auto action = solver.solve(
+        two_player_position({RED_FIVE, BLUE_NINE, WILD_FACE}, 4),
+        FACE_COPIES
+    );
+    CHECK(solver.node_count() <= 501);
+    if (action.has_value()) {
+        CHECK((playable_faces(Color::Red, 3) >> action->face & 1) == 1);
+    }
+}
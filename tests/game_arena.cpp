@@ -0,0 +1,72 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/game_arena.hpp"
+
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "../src/card/create_card.hpp"
+#include "../src/state.hpp"
+#include "players.hpp"
+
+namespace {
+/// Counts the blocks allocated through it and not yet freed.
+class CountingResource: public std::pmr::memory_resource {
+  public:
+    size_t allocation_count = 0;
+    size_t live_bytes = 0;
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocation_count += 1;
+        live_bytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* block, size_t bytes, size_t alignment) override {
+        live_bytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(block, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+} // namespace
+
+TEST_CASE("Cards give their memory back to their resource") {
+    CountingResource resource;
+    {
+        std::vector<std::unique_ptr<Card>> cards;
+        for (const auto atlas_index : {0, 12, 52, 61}) {
+            cards.push_back(
+                create_card(static_cast<uint8_t>(atlas_index), &resource)
+            );
+        }
+        CHECK(resource.allocation_count == 4);
+        CHECK(resource.live_bytes > 0);
+        CHECK(cards[3]->atlas_index() == 61);
+    }
+    CHECK(resource.live_bytes == 0);
+
+    // Cards made without a resource come from the global heap.
+    const auto card = std::make_unique<NumberCard>(Color::Red, 5);
+    CHECK(card->atlas_index() == 5);
+}
+
+TEST_CASE("State keeps its cards, hands and pile in its arena") {
+    // The arena takes chunks from the default resource once its buffer is
+    // used up.
+    CountingResource resource;
+    auto* const previous = std::pmr::set_default_resource(&resource);
+    {
+        State state(create_ai_players(), 3);
+        while (state.update() != AppState::GameOver) {
+        }
+    }
+    std::pmr::set_default_resource(previous);
+    CHECK(resource.allocation_count == 0);
+}
@@ -0,0 +1,32 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/input.hpp"
+
+#include <doctest/doctest.h>
+
+TEST_CASE("HitRegions finds the topmost region under a point") {
+    HitRegions<int> regions;
+    CHECK_FALSE(regions.hit({5.0f, 5.0f}).has_value());
+
+    // Overlapping like the cards of a hand.
+    regions.add({{0.0f, 0.0f}, {10.0f, 10.0f}}, 0);
+    regions.add({{5.0f, 0.0f}, {10.0f, 10.0f}}, 1);
+
+    CHECK(regions.hit({2.0f, 5.0f}) == 0);
+    CHECK(regions.hit({7.0f, 5.0f}) == 1);
+    CHECK(regions.hit({12.0f, 5.0f}) == 1);
+    CHECK_FALSE(regions.hit({20.0f, 5.0f}).has_value());
+    CHECK_FALSE(regions.hit({2.0f, 20.0f}).has_value());
+
+    regions.clear();
+    CHECK_FALSE(regions.hit({2.0f, 5.0f}).has_value());
+}
+
+TEST_CASE("HitRegions ignores frames without a click") {
+    HitRegions<int> regions;
+    regions.add({{0.0f, 0.0f}, {10.0f, 10.0f}}, 0);
+
+    Input input;
+    input.begin_frame();
+    CHECK_FALSE(regions.clicked(input).has_value());
+}
@@ -0,0 +1,166 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <vector>
+
+#include "../src/card/composition.hpp"
+#include "../src/checkpoint.hpp"
+#include "../src/state.hpp"
+#include "players.hpp"
+
+using HouseState = BasicState<HouseRules>;
+
+namespace {
+/// Returns a table where the players hold the hands, in seat order, with
+/// the card on top of the pile and a deck of yellow ones, which the tests
+/// never need to play.
+Checkpoint table_of(
+    std::vector<std::vector<uint8_t>> hands,
+    uint8_t top_atlas_index
+) {
+    Checkpoint checkpoint;
+    checkpoint.shuffle_count = 1;
+    checkpoint.seat_count = static_cast<uint8_t>(hands.size());
+    checkpoint.deck.assign(20, colored_face(Color::Yellow, 1));
+    checkpoint.discard_pile.push_back(top_atlas_index);
+    for (size_t seat = 0; seat < hands.size(); seat += 1) {
+        checkpoint.hands[seat] = std::move(hands[seat]);
+    }
+    return checkpoint;
+}
+
+/// Returns the hands of the table, by their atlas indices.
+std::vector<std::vector<uint8_t>> hands_of(const HouseState& state) {
+    Checkpoint checkpoint;
+    state.checkpoint(checkpoint);
+    return {
+        checkpoint.hands.begin(),
+        checkpoint.hands.begin() + state.seat_count(),
+    };
+}
+
+constexpr auto RED_3 = colored_face(Color::Red, 3);
+constexpr auto GREEN_9 = colored_face(Color::Green, 9);
+constexpr auto YELLOW_8 = colored_face(Color::Yellow, 8);
+} // namespace
+
+TEST_CASE("Draw penalties stack until a player cannot answer them") {
+    const auto red_draw_two = colored_face(Color::Red, DRAW_TWO_RANK);
+    const auto blue_draw_two = colored_face(Color::Blue, DRAW_TWO_RANK);
+    HouseState state(
+        create_ai_players(3),
+        table_of(
+            {{red_draw_two, GREEN_9},
+             {blue_draw_two, GREEN_9},
+             {YELLOW_8, colored_face(Color::Yellow, 9)}},
+            RED_3
+        )
+    );
+
+    CHECK(state.update() == AppState::Gameplay);
+    CHECK(state.discard_pile().pending_draw() == 2);
+    CHECK(state.current_seat() == 1);
+
+    CHECK(state.update() == AppState::Gameplay);
+    CHECK(state.discard_pile().pending_draw() == 4);
+    CHECK(state.current_seat() == 2);
+
+    // The third player has no draw card and takes both penalties.
+    CHECK(state.update() == AppState::Gameplay);
+    CHECK(state.discard_pile().pending_draw() == 0);
+    CHECK(state.player(2).hand_size() == 6);
+    CHECK(state.current_seat() == 0);
+}
+
+TEST_CASE("Players jump in with the top card, but not on their own") {
+    const auto blue_3 = colored_face(Color::Blue, 3);
+    const auto blue_8 = colored_face(Color::Blue, 8);
+
+    SUBCASE("The player who played the card holds another") {
+        HouseState state(
+            create_ai_players(3),
+            table_of(
+                {{blue_3, blue_3, GREEN_9},
+                 {blue_8, YELLOW_8},
+                 {colored_face(Color::Green, 5), GREEN_9}},
+                RED_3
+            )
+        );
+        state.update();
+        CHECK(state.current_seat() == 1);
+
+        // Play goes on in turn.
+        state.update();
+        CHECK(state.player(0).hand_size() == 2);
+        CHECK(state.player(1).hand_size() == 1);
+        CHECK(state.discard_pile().peek_top().atlas_index() == blue_8);
+        CHECK(state.current_seat() == 2);
+    }
+
+    SUBCASE("Another player holds one") {
+        HouseState state(
+            create_ai_players(3),
+            table_of(
+                {{blue_3, GREEN_9},
+                 {blue_8, YELLOW_8},
+                 {blue_3, GREEN_9}},
+                RED_3
+            )
+        );
+        state.update();
+        CHECK(state.current_seat() == 1);
+
+        // The third player plays out of turn, skipping the second.
+        state.update();
+        CHECK(state.player(1).hand_size() == 2);
+        CHECK(state.player(2).hand_size() == 1);
+        CHECK(state.discard_pile().peek_top().atlas_index() == blue_3);
+        CHECK(state.current_seat() == 0);
+    }
+}
+
+TEST_CASE("A 7 swaps hands with the smallest hand, a 0 passes them on") {
+    const auto green_5 = colored_face(Color::Green, 5);
+    const auto green_6 = colored_face(Color::Green, 6);
+    const auto blue_1 = colored_face(Color::Blue, 1);
+    const auto blue_2 = colored_face(Color::Blue, 2);
+    const auto blue_4 = colored_face(Color::Blue, 4);
+
+    SUBCASE("Seven") {
+        HouseState state(
+            create_ai_players(3),
+            table_of(
+                {{colored_face(Color::Red, 7), green_5, green_6},
+                 {blue_1, blue_2},
+                 {blue_4, GREEN_9, YELLOW_8}},
+                RED_3
+            )
+        );
+        state.update();
+        const auto hands = hands_of(state);
+        CHECK(hands[0] == std::vector<uint8_t> {blue_1, blue_2});
+        CHECK(hands[1] == std::vector<uint8_t> {green_5, green_6});
+        CHECK(hands[2] == std::vector<uint8_t> {blue_4, GREEN_9, YELLOW_8});
+        CHECK(state.current_seat() == 1);
+    }
+
+    SUBCASE("Zero") {
+        HouseState state(
+            create_ai_players(3),
+            table_of(
+                {{colored_face(Color::Red, 0), green_5, green_6},
+                 {blue_1, blue_2},
+                 {blue_4, GREEN_9, YELLOW_8}},
+                RED_3
+            )
+        );
+        state.update();
+        const auto hands = hands_of(state);
+        CHECK(hands[0] == std::vector<uint8_t> {blue_4, GREEN_9, YELLOW_8});
+        CHECK(hands[1] == std::vector<uint8_t> {green_5, green_6});
+        CHECK(hands[2] == std::vector<uint8_t> {blue_1, blue_2});
+        CHECK(state.current_seat() == 1);
+    }
+}
@@ -0,0 +1,108 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/player/linear_evaluator.hpp"
+
+#include <doctest/doctest.h>
+
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "../src/simulation/batch_engine.hpp"
+#include "../src/state.hpp"
+#include "observations.hpp"
+
+namespace {
+Weights test_weights() {
+    Weights weights {};
+    for (size_t i = 0; i < FEATURE_NAMES.size(); i += 1) {
+        weights[i] = static_cast<float>(i % 5) - 2.0f;
+    }
+    return weights;
+}
+} // namespace
+
+TEST_CASE("dot adds the products of features and weights") {
+    FeatureVector features;
+    Weights weights;
+    float expected = 0.0f;
+    for (size_t i = 0; i < FEATURE_COUNT; i += 1) {
+        features[i] = static_cast<float>(i);
+        weights[i] = i % 2 == 0 ? 0.5f : -1.0f;
+        expected += features[i] * weights[i];
+    }
+    CHECK(dot(features, weights) == doctest::Approx(expected));
+}
+
+TEST_CASE("LinearEvaluator chooses the legal move with the highest score") {
+    ObservationCollector collector;
+    BatchEngine batch(16, 4, 0);
+    batch.set_listener(&collector);
+    batch.run();
+
+    const LinearEvaluator evaluator(test_weights());
+    for (const auto& observation : collector.observations) {
+        const auto action = evaluator.choose(observation);
+        REQUIRE((observation.legal_faces >> action.face & 1) == 1);
+        if (!is_wild(action.face)) {
+            CHECK(action.color == face_color(action.face));
+        }
+
+        const auto best = evaluator.score(observation, action);
+        for (auto faces = observation.legal_faces; faces != 0;
+             faces &= faces - 1) {
+            const auto face = static_cast<Face>(std::countr_zero(faces));
+            for (uint8_t color = 0; color < 4; color += 1) {
+                if (is_wild(face) || color == uint8_t(face_color(face))) {
+                    CHECK(
+                        evaluator.score(observation, {face, Color(color)})
+                        <= best
+                    );
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("LinearEvaluator loads weights by feature name") {
+    const auto path =
+        std::filesystem::temp_directory_path() / "uno_linear_weights.txt";
+    {
+        std::ofstream file(path);
+        file << "# Comment\n\nplays_wild -1.5\nattacks_next 2\n";
+    }
+    const auto evaluator = LinearEvaluator::load(path);
+    CHECK(
+        evaluator.weights()[size_t(Feature::PlaysWild)]
+        == doctest::Approx(-1.5f)
+    );
+    CHECK(
+        evaluator.weights()[size_t(Feature::AttacksNext)]
+        == doctest::Approx(2.0f)
+    );
+    CHECK(evaluator.weights()[size_t(Feature::Bias)] == 0.0f);
+
+    {
+        std::ofstream file(path);
+        file << "unknown_feature 1\n";
+    }
+    CHECK_THROWS_AS(LinearEvaluator::load(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("LinearAiPlayer plays games to the end") {
+    const LinearEvaluator evaluator(test_weights());
+    for (unsigned int seed = 0; seed < 16; seed += 1) {
+        std::vector<std::unique_ptr<Player>> players;
+        players.push_back(std::make_unique<AiPlayer>());
+        for (uint8_t seat = 1; seat < 4; seat += 1) {
+            players.push_back(std::make_unique<LinearAiPlayer>(evaluator));
+        }
+        State state(std::move(players), seed);
+        while (state.update() != AppState::GameOver) {
+        }
+        CHECK(state.player(state.current_seat()).is_hand_empty());
+    }
+}
@@ -0,0 +1,60 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/player/local_player.hpp"
+
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <future>
+
+#include "../src/animator.hpp"
+#include "../src/card/number_card.hpp"
+
+TEST_CASE("LocalPlayer plays the clicked card while a draw is in flight") {
+    DiscardPile pile;
+    pile.push_back(std::make_unique<NumberCard>(Color::Red, 3));
+
+    LocalPlayer player;
+    const auto clicked =
+        player.take(std::make_unique<NumberCard>(Color::Red, 5)).atlas_index();
+    // Sorts before the clicked card, but has not arrived on the screen.
+    const auto drawn =
+        player.take(std::make_unique<NumberCard>(Color::Red, 2)).atlas_index();
+
+    Animator animator;
+    animator.push({CardMotion::Kind::Draw, 0, drawn, true, 0.0f});
+    TableSnapshot snapshot;
+    snapshot.seat_count = 2;
+    player.snapshot_hand(pile, snapshot.hands[0]);
+    animator.hide_moving_cards(snapshot);
+    REQUIRE(snapshot.hands[0].size() == 1);
+
+    const TableLayout layout({1280.0f, 720.0f}, snapshot.seat_count);
+    sf::RenderTexture target({1280, 720});
+    SpriteBatch batch;
+
+    // Click on the one card on the screen, until the player takes the click.
+    auto played = std::async(std::launch::async, [&] {
+        return player.play_card(pile);
+    });
+    while (played.wait_for(std::chrono::milliseconds(1))
+           != std::future_status::ready) {
+        batch.clear();
+        player.render(batch, snapshot, layout, 0);
+
+        Input input;
+        input.begin_frame();
+        input.handle(
+            sf::Event::MouseButtonPressed {
+                sf::Mouse::Button::Left,
+                {1280 / 2 - 5, 720 - 5},
+            }
+        );
+        input.map(target);
+        player.handle_input(input);
+    }
+
+    const auto card = played.get();
+    CHECK(card->atlas_index() == clicked);
+    CHECK(player.hand_size() == 1);
+}
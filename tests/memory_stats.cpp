@@ -0,0 +1,177 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/memory_stats.hpp"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "../src/game_arena.hpp"
+#include "../src/player/linear_ai_player.hpp"
+#include "../src/state.hpp"
+#include "players.hpp"
+
+// The tests are built with memory stats enabled.
+static_assert(ARE_MEMORY_STATS_ENABLED);
+
+TEST_CASE("Allocations are counted for the innermost scope") {
+    const auto& text = MemoryStats::of(Subsystem::Text);
+    const auto& audio = MemoryStats::of(Subsystem::Audio);
+    const auto text_before = text.usage();
+    const auto audio_before = audio.usage();
+    std::unique_ptr<char[]> audio_block;
+    {
+        const MemoryScope text_scope(Subsystem::Text);
+        const auto text_block = std::make_unique<char[]>(100);
+        {
+            const MemoryScope audio_scope(Subsystem::Audio);
+            audio_block = std::make_unique<char[]>(1000);
+        }
+        CHECK(MemoryStats::current() == Subsystem::Text);
+        CHECK(
+            text.usage().allocation_count == text_before.allocation_count + 1
+        );
+        CHECK(text.usage().live_bytes == text_before.live_bytes + 100);
+    }
+    CHECK(MemoryStats::current() == Subsystem::Other);
+    CHECK(text.usage().live_bytes == text_before.live_bytes);
+    CHECK(audio.usage().live_bytes == audio_before.live_bytes + 1000);
+
+    // A block is counted off for its subsystem wherever it is freed.
+    audio_block.reset();
+    CHECK(audio.usage().live_bytes == audio_before.live_bytes);
+    CHECK(audio.usage().allocation_count == audio_before.allocation_count + 1);
+}
+
+TEST_CASE("Frames report the most memory live during them") {
+    MemoryStats::end_frame();
+    const auto live = MemoryStats::heap().usage().live_bytes;
+    std::make_unique<char[]>(10'000).reset();
+    CHECK(MemoryStats::end_frame() >= live + 10'000);
+    CHECK(MemoryStats::end_frame() < live + 10'000);
+}
+
+TEST_CASE("A game arena counts the memory of each subsystem") {
+    {
+        GameArena arena;
+        const auto hands = MemoryStats::of(Subsystem::Hands).usage();
+        std::pmr::vector<int> hand(arena.resource(Subsystem::Hands));
+        hand.resize(100);
+        std::pmr::vector<int> pile(arena.resource(Subsystem::DiscardPile));
+        pile.resize(10);
+        pile.resize(1000);
+
+        const auto memory = arena.memory();
+        CHECK(memory.peak_bytes[size_t(Subsystem::Hands)] == 400);
+        CHECK(memory.peak_bytes[size_t(Subsystem::DiscardPile)] == 4'040);
+        CHECK(memory.peak_bytes[size_t(Subsystem::Deck)] == 0);
+        CHECK(
+            MemoryStats::of(Subsystem::Hands).usage().live_bytes
+            == hands.live_bytes + 400
+        );
+    }
+
+    std::string report;
+    MemoryStats::write(report);
+    CHECK(report.find("\nhands: ") != std::string::npos);
+    CHECK(report.find("\nlargest of ") != std::string::npos);
+}
+
+TEST_CASE("State counts its cards, hands and pile") {
+    const auto cards = MemoryStats::of(Subsystem::Deck).usage();
+    const auto hands = MemoryStats::of(Subsystem::Hands).usage();
+    const auto pile = MemoryStats::of(Subsystem::DiscardPile).usage();
+    {
+        State state(create_ai_players(), 5);
+        while (state.update() != AppState::GameOver) {
+        }
+        CHECK(
+            MemoryStats::of(Subsystem::Deck).usage().allocation_count
+            > cards.allocation_count + 28
+        );
+        CHECK(
+            MemoryStats::of(Subsystem::Hands).usage().allocation_count
+            >= hands.allocation_count + 4
+        );
+        CHECK(
+            MemoryStats::of(Subsystem::DiscardPile).usage().allocation_count
+            > pile.allocation_count
+        );
+    }
+    // The cards and hands are given back with the arena.
+    CHECK(
+        MemoryStats::of(Subsystem::Deck).usage().live_bytes == cards.live_bytes
+    );
+    CHECK(
+        MemoryStats::of(Subsystem::Hands).usage().live_bytes == hands.live_bytes
+    );
+}
+
+TEST_CASE("Turns do not allocate once a game is under way") {
+    // Players that play the first card they can and players that search
+    // endgames, in turn.
+    const auto create_players = [] {
+        auto players = create_ai_players(2);
+        for (uint8_t seat = 0; seat < 2; seat += 1) {
+            players.push_back(
+                std::make_unique<LinearAiPlayer>(LinearEvaluator::get())
+            );
+        }
+        return players;
+    };
+    // A first game sets up what is made once, such as the metrics and the
+    // weights.
+    {
+        State state(create_players(), 0);
+        while (state.update() != AppState::GameOver) {
+        }
+    }
+
+    // Snapshots grow, once per size, for a table larger than they have room
+    // for. Both snapshots the engine writes to catch up within a few turns.
+    constexpr uint32_t GROWTH_TURNS = 3;
+    const auto& heap = MemoryStats::heap();
+    size_t oversized_count = 0;
+    for (unsigned int seed = 1; seed <= 50; seed += 1) {
+        CAPTURE(seed);
+        State state(create_players(), seed);
+        size_t pile_room = TableSnapshot::RESERVED_PILE_SIZE;
+        std::array<size_t, MAX_SEATS> hand_rooms;
+        hand_rooms.fill(TableSnapshot::RESERVED_HAND_SIZE);
+        uint32_t turns_since_growth = GROWTH_TURNS;
+        bool is_over = false;
+        while (!is_over) {
+            const auto allocation_count = heap.usage().allocation_count;
+            is_over = state.update() == AppState::GameOver;
+
+            turns_since_growth += 1;
+            const auto pile_size = state.discard_pile().cards().size();
+            if (pile_size > pile_room) {
+                pile_room = pile_size;
+                turns_since_growth = 0;
+            }
+            for (uint8_t seat = 0; seat < state.seat_count(); seat += 1) {
+                const auto hand_size = state.player(seat).hand_size();
+                if (hand_size > hand_rooms[seat]) {
+                    hand_rooms[seat] = hand_size;
+                    turns_since_growth = 0;
+                }
+            }
+            if (turns_since_growth >= GROWTH_TURNS) {
+                CHECK(heap.usage().allocation_count == allocation_count);
+            }
+        }
+        if (pile_room > TableSnapshot::RESERVED_PILE_SIZE
+            || std::ranges::max(hand_rooms)
+                > TableSnapshot::RESERVED_HAND_SIZE) {
+            oversized_count += 1;
+        }
+    }
+    // Most games fit the snapshots.
+    CHECK(oversized_count < 10);
+}
@@ -0,0 +1,123 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/metrics.hpp"
+
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/state.hpp"
+#include "players.hpp"
+
+TEST_CASE("Histogram buckets stay within an eighth of their values") {
+    using Snapshot = HistogramSnapshot;
+    for (uint64_t value = 0; value < 100'000; value += 1) {
+        const auto bucket = Snapshot::bucket_of(value);
+        REQUIRE(Snapshot::lower_bound(bucket) <= value);
+        REQUIRE(value < Snapshot::lower_bound(bucket + 1));
+    }
+    for (uint64_t value = 1; value < (uint64_t {1} << 62); value *= 3) {
+        const auto bucket = Snapshot::bucket_of(value);
+        const auto width =
+            Snapshot::lower_bound(bucket + 1) - Snapshot::lower_bound(bucket);
+        CHECK(Snapshot::lower_bound(bucket) <= value);
+        CHECK(width <= std::max<uint64_t>(value / 8, 1));
+    }
+    CHECK(Snapshot::bucket_of(UINT64_MAX) == Snapshot::BUCKET_COUNT - 1);
+}
+
+TEST_CASE("Metrics add up the counts of every thread") {
+    Counter counter;
+    Histogram histogram;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i += 1) {
+        threads.emplace_back([&] {
+            for (uint64_t value = 1; value <= 1'000; value += 1) {
+                counter.add();
+                histogram.record(value * 1'000);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(counter.value() == 4'000);
+
+    const auto snapshot = histogram.snapshot();
+    CHECK(snapshot.count == 4'000);
+    CHECK(snapshot.sum == 4 * 500'500 * 1'000);
+    const auto median = static_cast<double>(snapshot.quantile(0.5));
+    CHECK(median == doctest::Approx(500'000).epsilon(0.125));
+    const auto p99 = static_cast<double>(snapshot.quantile(0.99));
+    CHECK(p99 == doctest::Approx(990'000).epsilon(0.125));
+}
+
+TEST_CASE("Metrics are written in the text format of Prometheus") {
+    auto& metrics = Metrics::get();
+    auto& counter = metrics.counter("test_events_total", "Events.");
+    CHECK(&metrics.counter("test_events_total", "Events.") == &counter);
+    CHECK_THROWS_AS(
+        metrics.histogram("test_events_total", ""),
+        std::runtime_error
+    );
+    counter.add(3);
+    auto& histogram = metrics.histogram("test_wait_seconds", "Waits.");
+    histogram.record(std::chrono::microseconds(3));
+    histogram.record(std::chrono::seconds(1));
+
+    std::string text;
+    metrics.write(text);
+    CHECK(text.find("# TYPE test_events_total counter\n") != text.npos);
+    CHECK(text.find("\ntest_events_total 3\n") != text.npos);
+    CHECK(text.find("# TYPE test_wait_seconds histogram\n") != text.npos);
+    CHECK(
+        text.find("test_wait_seconds_bucket{le=\"4.096e-06\"} 1\n")
+        != text.npos
+    );
+    CHECK(text.find("test_wait_seconds_bucket{le=\"+Inf\"} 2\n") != text.npos);
+    CHECK(text.find("test_wait_seconds_count 2\n") != text.npos);
+
+    const auto path =
+        std::filesystem::temp_directory_path() / "uno_metrics_test.prom";
+    metrics.dump(path);
+    std::ifstream file(path);
+    std::stringstream dumped;
+    dumped << file.rdbuf();
+    file.close();
+    CHECK(dumped.str().find("\ntest_events_total 3\n") != std::string::npos);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("State counts turns and times AI decisions") {
+    const auto& metrics = GameMetrics::get();
+    const auto turns = metrics.turns.value();
+    const auto timed_turns = metrics.turn_time.snapshot().count;
+    const auto decisions = metrics.decision_time.snapshot().count;
+
+    State state(create_ai_players(), 7);
+    uint64_t turn_count = 1;
+    while (state.update() != AppState::GameOver) {
+        turn_count += 1;
+    }
+    CHECK(metrics.turns.value() == turns + turn_count);
+    // Timings are sampled, each standing for a few turns.
+    CHECK(metrics.turn_time.snapshot().count > timed_turns);
+    CHECK(metrics.decision_time.snapshot().count > decisions);
+    CHECK(metrics.draws.value() > 0);
+
+    // Nothing is recorded while metrics are disabled.
+    are_metrics_enabled = false;
+    const auto disabled_turns = metrics.turns.value();
+    State disabled_state(create_ai_players(), 8);
+    while (disabled_state.update() != AppState::GameOver) {
+    }
+    CHECK(metrics.turns.value() == disabled_turns);
+    are_metrics_enabled = true;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../src/simulation/batch_engine.hpp"
+
+/// Collects the observations of the games played by a batch engine, and the
+/// action taken on each.
+class ObservationCollector: public BatchListener {
+  public:
+    void on_play(size_t, const Observation& observation, Action action)
+        override {
+        observations.push_back(observation);
+        actions.push_back(action);
+    }
+
+    std::vector<Observation> observations;
+    std::vector<Action> actions;
+};
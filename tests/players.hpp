@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../src/player/ai_player.hpp"
+
+/// Returns AI players for the seats of a table, as the tests and benchmarks
+/// seat them when the players themselves are not under test.
+inline std::vector<std::unique_ptr<Player>> create_ai_players(
+    uint8_t seat_count = 4
+) {
+    std::vector<std::unique_ptr<Player>> players;
+    for (uint8_t seat = 0; seat < seat_count; seat += 1) {
+        players.push_back(std::make_unique<AiPlayer>());
+    }
+    return players;
+}
@@ -0,0 +1,179 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/player/plugin.hpp"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/player/plugin_player.hpp"
+#include "../src/state.hpp"
+
+namespace {
+int live_contexts = 0;
+size_t choose_count = 0;
+UnoObservation last_view {};
+
+void* create_context() {
+    live_contexts += 1;
+    return &live_contexts;
+}
+
+void destroy_context(void* context) {
+    CHECK(context == &live_contexts);
+    live_contexts -= 1;
+}
+
+/// Plays the legal face with the lowest index.
+UnoAction choose_lowest(void*, const UnoObservation* observation) {
+    choose_count += 1;
+    last_view = *observation;
+    return {
+        static_cast<uint8_t>(std::countr_zero(observation->legal_faces)),
+        0
+    };
+}
+
+UnoAction choose_illegal(void*, const UnoObservation*) {
+    return {UNO_FACE_COUNT, UNO_COLOR_COUNT};
+}
+
+constexpr UnoStrategy LOWEST = {
+    UNO_PLUGIN_ABI_VERSION,
+    "lowest",
+    create_context,
+    destroy_context,
+    choose_lowest,
+};
+
+constexpr UnoStrategy ILLEGAL = {
+    UNO_PLUGIN_ABI_VERSION,
+    "illegal",
+    nullptr,
+    nullptr,
+    choose_illegal,
+};
+
+size_t checked_count = 0;
+
+/// A plugin player that checks every card it plays is playable, and, if its
+/// plugin only chooses illegal actions, that it falls back to the first
+/// playable card in its hand.
+class CheckedPluginPlayer: public PluginPlayer {
+  public:
+    CheckedPluginPlayer(
+        std::shared_ptr<const Plugin> plugin,
+        bool is_plugin_illegal
+    ) :
+        PluginPlayer(std::move(plugin)),
+        is_plugin_illegal_(is_plugin_illegal) {}
+
+    unique_ptr<Card> play_card(const DiscardPile& discard_pile) override {
+        const auto first_playable =
+            std::ranges::find_if(cards_, [&](const auto& card) {
+                return discard_pile.accepts(*card);
+            });
+        REQUIRE(first_playable != cards_.end());
+        const auto first_atlas_index = (*first_playable)->atlas_index();
+
+        auto card = PluginPlayer::play_card(discard_pile);
+        REQUIRE(card != nullptr);
+        CHECK(discard_pile.accepts(*card));
+        if (is_plugin_illegal_) {
+            CHECK(card->atlas_index() == first_atlas_index);
+        }
+        checked_count += 1;
+        return card;
+    }
+
+  private:
+    bool is_plugin_illegal_;
+};
+
+/// Plays a game of plugin players against an `AiPlayer`, to its end.
+void play(
+    const std::shared_ptr<const Plugin>& plugin,
+    unsigned int seed,
+    bool is_plugin_illegal = false
+) {
+    std::vector<std::unique_ptr<Player>> players;
+    players.push_back(
+        std::make_unique<CheckedPluginPlayer>(plugin, is_plugin_illegal)
+    );
+    players.push_back(std::make_unique<AiPlayer>());
+    players.push_back(
+        std::make_unique<CheckedPluginPlayer>(plugin, is_plugin_illegal)
+    );
+    State state(std::move(players), seed);
+    while (state.update() != AppState::GameOver) {
+    }
+    CHECK(state.player(state.current_seat()).is_hand_empty());
+}
+} // namespace
+
+TEST_CASE("Plugin hands the observation over as it is") {
+    const Plugin plugin(LOWEST);
+    CHECK(plugin.name() == "lowest");
+
+    Observation observation {};
+    observation.hand[5] = 2;
+    observation.hand_sizes = {3, 7, 1};
+    observation.legal_faces = uint64_t {1} << 17 | uint64_t {1} << WILD_FACE;
+    observation.top_face = 4;
+    observation.top_color = Color::Blue;
+    observation.direction = Direction::CounterClockwise;
+    observation.seat = 2;
+    observation.seat_count = 3;
+    observation.pending_draw = 4;
+
+    const auto action = plugin.choose(nullptr, observation);
+    CHECK(action.face == 17);
+    CHECK(action.color == Color::Red);
+    CHECK(last_view.hand[5] == 2);
+    CHECK(last_view.hand_sizes[1] == 7);
+    CHECK(last_view.legal_faces == observation.legal_faces);
+    CHECK(last_view.top_face == 4);
+    CHECK(last_view.top_color == static_cast<uint8_t>(Color::Blue));
+    CHECK(last_view.direction == -1);
+    CHECK(last_view.seat == 2);
+    CHECK(last_view.seat_count == 3);
+    CHECK(last_view.pending_draw == 4);
+}
+
+TEST_CASE("PluginPlayer plays the cards the plugin chooses") {
+    const auto plugin = std::make_shared<const Plugin>(LOWEST);
+    choose_count = 0;
+    for (unsigned int seed = 0; seed < 20; seed += 1) {
+        play(plugin, seed);
+        CHECK(live_contexts == 0);
+    }
+    CHECK(choose_count > 0);
+}
+
+TEST_CASE("PluginPlayer replaces illegal actions") {
+    const auto plugin = std::make_shared<const Plugin>(ILLEGAL);
+    checked_count = 0;
+    for (unsigned int seed = 0; seed < 20; seed += 1) {
+        play(plugin, seed, true);
+    }
+    CHECK(checked_count > 0);
+}
+
+TEST_CASE("Plugin::load plays the plugin shipped in plugins/") {
+    // The path of the built plugins/save_wilds.c, set by the build.
+    const auto plugin = Plugin::load(UNO_SAVE_WILDS_PLUGIN);
+    CHECK(plugin->name() == "save_wilds");
+    checked_count = 0;
+    for (unsigned int seed = 0; seed < 20; seed += 1) {
+        play(plugin, seed);
+    }
+    CHECK(checked_count > 0);
+}
+
+TEST_CASE("Plugin::load reports a missing library") {
+    CHECK_THROWS_AS(Plugin::load("plugins/missing.so"), std::runtime_error);
+}
@@ -0,0 +1,199 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/simulation/protocol.hpp"
+
+#include <doctest/doctest.h>
+
+#include <bit>
+#include <csignal>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/simulation/batch_engine.hpp"
+#include "../src/simulation/bot_process.hpp"
+#include "observations.hpp"
+
+namespace {
+/// Plays the legal face with the highest index, on yellow.
+class HighestPolicy: public BatchPolicy {
+  public:
+    void choose(
+        std::span<const Observation> observations,
+        std::span<Action> actions
+    ) override {
+        call_count += 1;
+        for (size_t i = 0; i < observations.size(); i += 1) {
+            const auto legal_faces = observations[i].legal_faces;
+            REQUIRE(legal_faces != 0);
+            actions[i] = {
+                static_cast<Face>(63 - std::countl_zero(legal_faces)),
+                Color::Yellow
+            };
+        }
+    }
+
+    size_t call_count = 0;
+};
+
+/// Plays nothing that could be played.
+class IllegalPolicy: public BatchPolicy {
+  public:
+    void choose(std::span<const Observation>, std::span<Action> actions)
+        override {
+        for (auto& action : actions) {
+            action = {FACE_COUNT, static_cast<Color>(COLOR_COUNT)};
+        }
+    }
+};
+
+std::string write(const Observation& observation) {
+    std::string line;
+    write_position(line, observation);
+    CHECK(line.back() == '\n');
+    line.pop_back();
+    return line;
+}
+} // namespace
+
+TEST_CASE("Positions survive the protocol") {
+    ObservationCollector collector;
+    BatchEngine batch(64, 5, 0);
+    batch.set_listener(&collector);
+    batch.run();
+
+    for (const auto& observation : collector.observations) {
+        const auto parsed = parse_position(write(observation));
+        CHECK(parsed.seat == observation.seat);
+        CHECK(parsed.seat_count == observation.seat_count);
+        CHECK(parsed.direction == observation.direction);
+        CHECK(parsed.top_face == observation.top_face);
+        CHECK(parsed.top_color == observation.top_color);
+        CHECK(parsed.pending_draw == observation.pending_draw);
+        CHECK(parsed.legal_faces == observation.legal_faces);
+        CHECK(parsed.hand == observation.hand);
+        CHECK(parsed.hand_sizes == observation.hand_sizes);
+    }
+}
+
+TEST_CASE("Moves survive the protocol") {
+    const std::vector<Action> actions = {
+        {0, Color::Red},
+        {WILD_DRAW_FOUR_FACE, Color::Green},
+        {25, Color::Blue},
+    };
+    std::string line;
+    write_moves(line, actions);
+    CHECK(line == "moves 0:0 53:2 25:1\n");
+
+    std::vector<Action> parsed(actions.size());
+    parse_moves(line.substr(0, line.size() - 1), parsed);
+    for (size_t i = 0; i < actions.size(); i += 1) {
+        CHECK(parsed[i].face == actions[i].face);
+        CHECK(parsed[i].color == actions[i].color);
+    }
+
+    std::vector<Action> too_many(actions.size() + 1);
+    CHECK_THROWS_AS(
+        parse_moves("moves 0:0 53:2 25:1", too_many),
+        std::runtime_error
+    );
+    CHECK_THROWS_AS(
+        parse_moves("moves 0:0 53:2", parsed),
+        std::runtime_error
+    );
+    CHECK_THROWS_AS(
+        parse_moves("moves 0 53:2 25:1", parsed),
+        std::runtime_error
+    );
+}
+
+TEST_CASE("Malformed positions are rejected") {
+    const std::string hand(FACE_COUNT, '0');
+    CHECK_NOTHROW(parse_position("0 2 1 5 0 0 1f " + hand + " 7 7"));
+    // Direction
+    CHECK_THROWS_AS(
+        parse_position("0 2 0 5 0 0 1f " + hand + " 7 7"),
+        std::runtime_error
+    );
+    // Seat beyond the seat count
+    CHECK_THROWS_AS(
+        parse_position("2 2 1 5 0 0 1f " + hand + " 7 7"),
+        std::runtime_error
+    );
+    // Short hand
+    CHECK_THROWS_AS(
+        parse_position("0 2 1 5 0 0 1f " + hand.substr(1) + " 7 7"),
+        std::runtime_error
+    );
+    // Missing and extra hand sizes
+    CHECK_THROWS_AS(
+        parse_position("0 2 1 5 0 0 1f " + hand + " 7"),
+        std::runtime_error
+    );
+    CHECK_THROWS_AS(
+        parse_position("0 2 1 5 0 0 1f " + hand + " 7 7 7"),
+        std::runtime_error
+    );
+}
+
+TEST_CASE("BatchEngine plays the moves of a policy") {
+    HighestPolicy policy;
+    ObservationCollector collector;
+    BatchEngine batch(64, 4, 0);
+    batch.set_policy(&policy);
+    batch.set_listener(&collector);
+    batch.run();
+
+    CHECK(policy.call_count > 0);
+    for (size_t game = 0; game < batch.game_count(); game += 1) {
+        CHECK(batch.is_finished(game));
+    }
+    for (size_t i = 0; i < collector.actions.size(); i += 1) {
+        const auto [face, color] = collector.actions[i];
+        const auto legal_faces = collector.observations[i].legal_faces;
+        CHECK(face == 63 - std::countl_zero(legal_faces));
+        CHECK(color == (is_wild(face) ? Color::Yellow : face_color(face)));
+    }
+}
+
+TEST_CASE("BatchEngine replaces illegal moves of a policy") {
+    IllegalPolicy policy;
+    ObservationCollector collector;
+    BatchEngine batch(64, 3, 0);
+    batch.set_policy(&policy);
+    batch.set_listener(&collector);
+    batch.run();
+
+    for (size_t game = 0; game < batch.game_count(); game += 1) {
+        CHECK(batch.is_finished(game));
+    }
+    for (size_t i = 0; i < collector.actions.size(); i += 1) {
+        const auto [face, color] = collector.actions[i];
+        CHECK((collector.observations[i].legal_faces >> face & 1) == 1);
+        CHECK(static_cast<uint8_t>(color) < COLOR_COUNT);
+    }
+}
+
+TEST_CASE("BotProcess reports a bot that does not start") {
+    CHECK_THROWS_AS(BotProcess({"./no-such-bot"}), std::runtime_error);
+}
+
+#ifndef _WIN32
+TEST_CASE("BotProcess reports a bot that exits, without SIGPIPE") {
+    ObservationCollector collector;
+    BatchEngine batch(64, 4, 0);
+    batch.set_listener(&collector);
+    batch.run();
+    std::vector<Action> actions(collector.observations.size());
+
+    // Answers the greeting and exits, while the positions, more than a pipe
+    // holds, are still being written.
+    BotProcess bot({"sh", "-c", "read line; echo ok"});
+    CHECK_THROWS_AS(
+        bot.choose(collector.observations, actions),
+        std::runtime_error
+    );
+    CHECK(std::signal(SIGPIPE, SIG_DFL) == SIG_DFL);
+}
+#endif
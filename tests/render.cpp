@@ -0,0 +1,134 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/scene.hpp"
+#include "../src/start_menu.hpp"
+
+#include <doctest/doctest.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+namespace {
+const sf::Vector2u FRAME_SIZE(1280, 720);
+
+/// Largest difference of a colour channel still counted as the same pixel,
+/// so that the goldens survive small differences between GL drivers.
+constexpr int CHANNEL_TOLERANCE = 8;
+
+/// Returns the number of pixels that differ between two images of the same
+/// size.
+size_t count_different_pixels(const sf::Image& a, const sf::Image& b) {
+    const auto* lhs = a.getPixelsPtr();
+    const auto* rhs = b.getPixelsPtr();
+    const auto pixel_count = size_t {a.getSize().x} * a.getSize().y;
+    size_t count = 0;
+    for (size_t i = 0; i < pixel_count; i += 1) {
+        for (size_t channel = 0; channel < 4; channel += 1) {
+            const auto offset = i * 4 + channel;
+            if (std::abs(lhs[offset] - rhs[offset]) > CHANNEL_TOLERANCE) {
+                count += 1;
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+/// Compares an image with its golden in tests/golden. Records the golden
+/// instead if `UNO_UPDATE_GOLDEN` is set; otherwise a missing golden skips the
+/// comparison, as goldens are recorded on a machine with a display rather than
+/// on every CI runner.
+void check_golden(const std::string& name, const sf::Image& image) {
+    const auto path =
+        std::filesystem::path("tests/golden") / (name + ".png");
+    std::filesystem::create_directories(path.parent_path());
+    if (std::getenv("UNO_UPDATE_GOLDEN")) {
+        REQUIRE(image.saveToFile(path));
+        MESSAGE("Recorded ", path.string());
+        return;
+    }
+
+    if (!std::filesystem::exists(path)) {
+        image.saveToFile(path.string() + ".actual.png");
+        MESSAGE(
+            "Skipped missing ", path.string(),
+            ", record it with UNO_UPDATE_GOLDEN=1"
+        );
+        return;
+    }
+    const sf::Image golden(path);
+    REQUIRE_EQ(golden.getSize(), image.getSize());
+    const auto different = count_different_pixels(golden, image);
+    if (different > 0) {
+        image.saveToFile(path.string() + ".actual.png");
+    }
+    // Allow a few edge pixels to be rasterized differently.
+    CHECK_LE(different, size_t {FRAME_SIZE.x} * FRAME_SIZE.y / 1000);
+}
+} // namespace
+
+TEST_CASE("Scenes deal the same cards for the same seed") {
+    const SceneSpec spec {.seed = 7, .hand_size = 20, .discard_count = 30};
+    const auto a = build_scene(spec);
+    const auto b = build_scene(spec);
+
+    CHECK_EQ(a->player(State::LOCAL_SEAT).hand_size(), 20);
+    CHECK_EQ(a->discard_pile().cards().size(), 30);
+    CHECK_EQ(
+        a->player(State::LOCAL_SEAT).face_counts(),
+        b->player(State::LOCAL_SEAT).face_counts()
+    );
+    for (size_t i = 0; i < 30; i += 1) {
+        CHECK_EQ(
+            a->discard_pile().cards()[i]->atlas_index(),
+            b->discard_pile().cards()[i]->atlas_index()
+        );
+    }
+}
+
+TEST_CASE("Scenes stop staging when the deck runs out") {
+    const auto state =
+        build_scene({.seed = 1, .hand_size = 200, .discard_count = 200});
+    // Every card of the deck is either in a hand or on the pile.
+    size_t card_count = state->discard_pile().cards().size();
+    for (uint8_t seat = 0; seat < 4; seat += 1) {
+        card_count += state->player(seat).hand_size();
+    }
+    CHECK_EQ(card_count, 108);
+}
+
+TEST_CASE("Tables render as their golden images") {
+    const auto render_scene = [](const SceneSpec& spec) {
+        return render_offscreen(*build_scene(spec), FRAME_SIZE);
+    };
+    check_golden("opening", render_scene({.seed = 1}));
+    check_golden(
+        "crowded",
+        render_scene({.seed = 2, .hand_size = 25, .discard_count = 40})
+    );
+    check_golden(
+        "two_players",
+        render_scene(
+            {.seed = 3, .seat_count = 2, .hand_size = 12, .discard_count = 10}
+        )
+    );
+}
+
+TEST_CASE("Text renders from the atlas as its golden image") {
+    sf::RenderTexture texture(FRAME_SIZE);
+    StartMenu menu(texture);
+    SpriteBatch batch;
+    menu.render(batch, Input(), sf::Vector2f(FRAME_SIZE));
+    texture.clear(SCENE_BACKGROUND);
+    batch.draw(texture);
+    texture.display();
+    const auto image = texture.getTexture().copyToImage();
+
+    // Without its golden, at least make sure the menu drew something.
+    CHECK_GT(
+        count_different_pixels(sf::Image(FRAME_SIZE, SCENE_BACKGROUND), image),
+        size_t {0}
+    );
+    check_golden("start_menu", image);
+}
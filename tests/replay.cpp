@@ -0,0 +1,148 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/replay.hpp"
+
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "players.hpp"
+
+namespace {
+std::string encode(const State& state) {
+    Checkpoint checkpoint;
+    state.checkpoint(checkpoint);
+    std::string payload;
+    checkpoint.encode(payload);
+    return payload;
+}
+
+/// Records a game of AI players, and returns the table before every turn
+/// and after the last.
+std::vector<std::string> record(
+    const std::filesystem::path& path,
+    unsigned int seed,
+    uint32_t keyframe_interval
+) {
+    ReplayWriter writer(path, keyframe_interval);
+    State state(create_ai_players(), seed, writer);
+    std::vector<std::string> tables;
+    do {
+        tables.push_back(encode(state));
+        writer.begin_turn(state);
+    } while (state.update() != AppState::GameOver);
+    writer.finish();
+    tables.push_back(encode(state));
+    return tables;
+}
+/// Offset of the table of the first keyframe, after the header and the size
+/// of the table.
+constexpr size_t FIRST_KEYFRAME = sizeof(ReplayHeader) + sizeof(uint32_t);
+
+/// Returns the offset of the first turn of a replay file.
+size_t first_turn_offset(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t size;
+    file.seekg(sizeof(ReplayHeader));
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    return FIRST_KEYFRAME + size;
+}
+
+void overwrite(
+    const std::filesystem::path& path,
+    size_t offset,
+    const std::vector<uint8_t>& bytes
+) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(
+        reinterpret_cast<const char*>(bytes.data()),
+        static_cast<std::streamsize>(bytes.size())
+    );
+}
+} // namespace
+
+TEST_CASE("ReplayCursor reaches the table of any turn") {
+    const auto path =
+        std::filesystem::temp_directory_path() / "uno_replay_test.unoreplay";
+    for (unsigned int seed = 0; seed < 4; seed += 1) {
+        const auto tables = record(path, seed, 8);
+        const Replay replay(path);
+        REQUIRE(replay.turn_count() == tables.size() - 1);
+
+        ReplayCursor cursor(replay);
+        for (uint32_t turn = 0; turn <= replay.turn_count(); turn += 1) {
+            cursor.seek(turn);
+            REQUIRE(encode(cursor.state()) == tables[turn]);
+        }
+
+        // Backward and far seeks start from a keyframe.
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<uint32_t> turns(0, replay.turn_count());
+        for (size_t i = 0; i < 50; i += 1) {
+            const auto turn = turns(rng);
+            cursor.seek(turn);
+            CHECK(cursor.turn() == turn);
+            REQUIRE(encode(cursor.state()) == tables[turn]);
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Replay rejects truncated and other files") {
+    const auto path =
+        std::filesystem::temp_directory_path() / "uno_replay_cut.unoreplay";
+    record(path, 1, 8);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    CHECK_THROWS_AS(Replay {path}, std::runtime_error);
+
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "not a replay";
+    }
+    CHECK_THROWS_AS(Replay {path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Replay rejects malformed keyframes and turns") {
+    const auto path =
+        std::filesystem::temp_directory_path() / "uno_replay_bad.unoreplay";
+    // A seat count of 11, after the table, seed and shuffle count.
+    record(path, 2, 8);
+    overwrite(path, FIRST_KEYFRAME + 12, {11});
+    CHECK_THROWS_AS(Replay {path}, std::runtime_error);
+
+    // The first turn plays an empty cell of the atlas.
+    record(path, 2, 8);
+    overwrite(path, first_turn_offset(path), {FACE_COUNT});
+    CHECK_THROWS_AS(Replay {path}, std::runtime_error);
+
+    // The first turn plays past the atlas.
+    record(path, 2, 8);
+    overwrite(path, first_turn_offset(path), {ATLAS_CARD_COUNT});
+    CHECK_THROWS_AS(Replay {path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ReplayCursor reports a turn that does not fit the game") {
+    const auto path =
+        std::filesystem::temp_directory_path() / "uno_replay_other.unoreplay";
+    record(path, 3, 8);
+    // Every turn of the first keyframe plays a yellow 9, which the players
+    // cannot all have.
+    overwrite(
+        path,
+        first_turn_offset(path),
+        std::vector<uint8_t>(8, colored_face(Color::Yellow, 9))
+    );
+    const Replay replay(path);
+    ReplayCursor cursor(replay);
+    CHECK_THROWS_AS(cursor.seek(7), std::runtime_error);
+    std::filesystem::remove(path);
+}
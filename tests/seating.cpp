@@ -0,0 +1,47 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/seating.hpp"
+
+#include <doctest/doctest.h>
+
+TEST_CASE("Seating advances clockwise and wraps around") {
+    Seating seating(4);
+    CHECK(seating.count() == 4);
+    CHECK(seating.current() == 0);
+    CHECK(seating.direction() == Direction::Clockwise);
+
+    seating.advance();
+    CHECK(seating.current() == 1);
+    seating.skip();
+    CHECK(seating.current() == 3);
+    seating.advance();
+    CHECK(seating.current() == 0);
+}
+
+TEST_CASE("Seating reverses direction") {
+    Seating seating(10, 1);
+    seating.reverse();
+    CHECK(seating.direction() == Direction::CounterClockwise);
+
+    seating.advance();
+    CHECK(seating.current() == 0);
+    seating.advance();
+    CHECK(seating.current() == 9);
+    CHECK(seating.after(10) == 9);
+
+    seating.reverse();
+    seating.skip();
+    CHECK(seating.current() == 1);
+}
+
+TEST_CASE("Seating with two players") {
+    Seating seating(2);
+    seating.skip();
+    CHECK(seating.current() == 0);
+    seating.reverse();
+    seating.advance();
+    CHECK(seating.current() == 1);
+
+    seating.seat(0);
+    CHECK(seating.current() == 0);
+}
@@ -0,0 +1,131 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/spectator_feed.hpp"
+
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "players.hpp"
+
+namespace {
+/// A spectator who joins at some turn and then catches up every few turns.
+struct Spectator {
+    uint32_t join_turn;
+    uint32_t poll_period;
+    SpectatorFeed::Subscription subscription;
+    SpectatorView view;
+    std::vector<SpectatorFeed::Message> messages;
+
+    /// Receives the messages of the feed, and returns whether the view is
+    /// up to date.
+    bool catch_up(const SpectatorFeed& feed) {
+        messages.clear();
+        feed.poll(subscription, messages);
+        bool is_synced = true;
+        for (const auto& message : messages) {
+            is_synced = view.apply(std::as_bytes(std::span(*message)));
+        }
+        return is_synced;
+    }
+};
+
+/// Broadcasts a game to spectators joining and polling at various turns,
+/// and checks that each of them sees the table as it is.
+template <typename GameRules>
+void check_spectators(unsigned int seed, uint8_t seat_count) {
+    SpectatorFeed feed(16);
+    BasicState<GameRules> state(create_ai_players(seat_count), seed, feed);
+    std::vector<Spectator> spectators;
+    for (uint32_t i = 0; i < 40; i += 1) {
+        spectators.push_back({i * 3, i % 7 + 1});
+    }
+
+    SpectatorView truth;
+    uint32_t turn = 0;
+    feed.publish(state);
+    while (true) {
+        truth.assign(state, turn);
+        for (auto& spectator : spectators) {
+            if (turn >= spectator.join_turn
+                && (turn - spectator.join_turn) % spectator.poll_period == 0) {
+                REQUIRE(spectator.catch_up(feed));
+                REQUIRE(spectator.view == truth);
+            }
+        }
+        if (state.update() == AppState::GameOver) {
+            break;
+        }
+        feed.publish(state);
+        turn += 1;
+    }
+}
+} // namespace
+
+TEST_CASE("Spectators see the table from any turn they join") {
+    for (unsigned int seed = 0; seed < 6; seed += 1) {
+        check_spectators<OfficialRules>(seed, 4);
+        check_spectators<HouseRules>(seed, 5);
+    }
+}
+
+TEST_CASE("SpectatorFeed encodes each turn once for every spectator") {
+    SpectatorFeed feed(64);
+    State state(create_ai_players(4), 3, feed);
+    feed.publish(state);
+    for (size_t turn = 0; turn < 10; turn += 1) {
+        REQUIRE(state.update() == AppState::Gameplay);
+        feed.publish(state);
+    }
+    Spectator first {};
+    Spectator second {};
+    REQUIRE(first.catch_up(feed));
+    REQUIRE(second.catch_up(feed));
+    REQUIRE(first.messages.size() == 11);
+    for (size_t i = 0; i < first.messages.size(); i += 1) {
+        CHECK(first.messages[i] == second.messages[i]);
+    }
+    for (size_t i = 1; i < first.messages.size(); i += 1) {
+        CHECK(first.messages[i]->size() < 24);
+    }
+
+    // Nothing new until the next turn.
+    CHECK(first.catch_up(feed));
+    CHECK(first.messages.empty());
+}
+
+TEST_CASE("SpectatorView waits for a keyframe after a gap") {
+    SpectatorFeed feed(64);
+    State state(create_ai_players(4), 5, feed);
+    feed.publish(state);
+    Spectator spectator {};
+    REQUIRE(spectator.catch_up(feed));
+    for (size_t turn = 0; turn < 2; turn += 1) {
+        REQUIRE(state.update() == AppState::Gameplay);
+        feed.publish(state);
+    }
+    std::vector<SpectatorFeed::Message> messages;
+    feed.poll(spectator.subscription, messages);
+    REQUIRE(messages.size() == 2);
+    // The delta of the second turn does not follow the first keyframe.
+    CHECK_FALSE(spectator.view.apply(std::as_bytes(std::span(*messages[1]))));
+    CHECK(spectator.view.turn == 0);
+}
+
+TEST_CASE("SpectatorView rejects malformed messages") {
+    SpectatorView view;
+    const std::string truncated("\x00\x01", 2);
+    CHECK_THROWS_AS(
+        view.apply(std::as_bytes(std::span(truncated))),
+        std::runtime_error
+    );
+    const std::string unknown("\x07\x00\x00\x00\x00", 5);
+    CHECK_THROWS_AS(
+        view.apply(std::as_bytes(std::span(unknown))),
+        std::runtime_error
+    );
+}
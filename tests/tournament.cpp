@@ -0,0 +1,133 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/simulation/tournament.hpp"
+
+#include <doctest/doctest.h>
+
+#include <random>
+#include <vector>
+
+#include "../src/player/ai_player.hpp"
+#include "../src/player/linear_ai_player.hpp"
+
+namespace {
+/// Plays a playable card and picks a wild color at random.
+class RandomPlayer: public AiPlayer {
+  public:
+    unique_ptr<Card> play_card(const DiscardPile& discard_pile) override {
+        std::vector<size_t> playable;
+        for (size_t i = 0; i < cards_.size(); i += 1) {
+            if (discard_pile.accepts(*cards_[i])) {
+                playable.push_back(i);
+            }
+        }
+        std::uniform_int_distribution<size_t> pick(0, playable.size() - 1);
+        const auto it = cards_.begin() + playable[pick(rng_)];
+        auto card = std::move(*it);
+        cards_.erase(it);
+        return card;
+    }
+
+    Color select_wild_color() const override {
+        std::uniform_int_distribution<int> pick(0, COLOR_COUNT - 1);
+        return static_cast<Color>(pick(rng_));
+    }
+
+  private:
+    mutable std::mt19937 rng_;
+};
+
+/// Feeds wins with chance `p` to `judge` until it concludes, and returns the
+/// verdict with the number of games it took.
+std::pair<Verdict, size_t> run_sprt(double p, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution wins(p);
+    const SprtBounds bounds;
+    size_t win_count = 0;
+    size_t loss_count = 0;
+    while (true) {
+        wins(rng) ? win_count += 1 : loss_count += 1;
+        const auto verdict = judge(win_count, loss_count, bounds);
+        if (verdict != Verdict::Running) {
+            return {verdict, win_count + loss_count};
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("estimate_elo turns scores into Elo differences") {
+    CHECK(estimate_elo(50, 50).elo == doctest::Approx(0.0));
+    CHECK(estimate_elo(75, 25).elo == doctest::Approx(190.85).epsilon(0.001));
+    CHECK(estimate_elo(25, 75).elo == doctest::Approx(-190.85).epsilon(0.001));
+
+    const auto estimate = estimate_elo(60, 40);
+    CHECK(estimate.lower < estimate.elo);
+    CHECK(estimate.elo < estimate.upper);
+    const auto tighter = estimate_elo(600, 400);
+    CHECK(tighter.upper - tighter.lower < estimate.upper - estimate.lower);
+}
+
+TEST_CASE("judge detects a difference and an even match") {
+    const auto [stronger, stronger_games] = run_sprt(0.65, 1);
+    CHECK(stronger == Verdict::FirstStronger);
+    CHECK(stronger_games < 1'000);
+
+    const auto [weaker, weaker_games] = run_sprt(0.35, 2);
+    CHECK(weaker == Verdict::SecondStronger);
+    CHECK(weaker_games < 1'000);
+
+    CHECK(run_sprt(0.5, 3).first == Verdict::Even);
+}
+
+TEST_CASE("Tournament plays every pairing") {
+    std::vector<Entrant> entrants;
+    for (const auto* name : {"a", "b", "c"}) {
+        entrants.push_back({name, [] { return std::make_unique<AiPlayer>(); }});
+    }
+    TournamentConfig config;
+    config.seat_count = 4;
+    config.max_games = 40;
+    config.thread_count = 4;
+    Tournament tournament(std::move(entrants), config);
+
+    size_t done = 0;
+    tournament.run([&](const Pairing&) { done += 1; });
+    CHECK(done == 3);
+    for (const auto& pairing : tournament.pairings()) {
+        CHECK(pairing.verdict != Verdict::Running);
+        CHECK(pairing.game_count() >= 2);
+        CHECK(pairing.game_count() <= config.max_games);
+        CHECK(pairing.game_count() % 2 == 0);
+    }
+
+    double sum = 0.0;
+    for (const auto rating : tournament.ratings()) {
+        sum += rating;
+    }
+    CHECK(sum == doctest::Approx(0.0).epsilon(1e-6));
+}
+
+TEST_CASE("Tournament stops once an entrant is clearly stronger") {
+    std::vector<Entrant> entrants;
+    entrants.push_back({"linear", [] {
+                            return std::make_unique<LinearAiPlayer>(
+                                LinearEvaluator::get(),
+                                EndgameLimits {.card_threshold = 0}
+                            );
+                        }});
+    entrants.push_back({"random", [] {
+                            return std::make_unique<RandomPlayer>();
+                        }});
+    TournamentConfig config;
+    config.max_games = 4'000;
+    config.thread_count = 4;
+    Tournament tournament(std::move(entrants), config);
+    tournament.run();
+
+    const auto& pairing = tournament.pairings().front();
+    CHECK(pairing.verdict == Verdict::FirstStronger);
+    CHECK(pairing.first_wins > pairing.second_wins);
+    CHECK(pairing.game_count() < config.max_games);
+    const auto ratings = tournament.ratings();
+    CHECK(ratings[0] > ratings[1]);
+}
@@ -0,0 +1,58 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include "../src/triple_buffer.hpp"
+
+#include <doctest/doctest.h>
+
+#include <array>
+#include <thread>
+
+namespace {
+/// A value that is torn if its words differ.
+struct Value {
+    std::array<uint64_t, 8> words {};
+};
+} // namespace
+
+TEST_CASE("TripleBuffer returns the latest published value") {
+    TripleBuffer<int> buffer;
+    CHECK(buffer.front() == 0);
+
+    buffer.back() = 1;
+    CHECK(buffer.front() == 0);
+    buffer.publish();
+    CHECK(buffer.front() == 1);
+
+    buffer.back() = 2;
+    buffer.publish();
+    buffer.back() = 3;
+    buffer.publish();
+    CHECK(buffer.front() == 3);
+    CHECK(buffer.front() == 3);
+}
+
+TEST_CASE("TripleBuffer hands whole values between threads") {
+    constexpr uint64_t VALUE_COUNT = 200'000;
+    TripleBuffer<Value> buffer;
+
+    std::jthread writer([&] {
+        for (uint64_t i = 1; i <= VALUE_COUNT; i += 1) {
+            buffer.back().words.fill(i);
+            buffer.publish();
+        }
+    });
+
+    uint64_t last = 0;
+    bool is_torn = false;
+    bool is_out_of_order = false;
+    while (last < VALUE_COUNT) {
+        const auto& value = buffer.front();
+        for (const auto word : value.words) {
+            is_torn = is_torn || word != value.words[0];
+        }
+        is_out_of_order = is_out_of_order || value.words[0] < last;
+        last = value.words[0];
+    }
+    CHECK_FALSE(is_torn);
+    CHECK_FALSE(is_out_of_order);
+}
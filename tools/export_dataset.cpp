@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+#include "../src/simulation/batch_engine.hpp"
+#include "../src/simulation/dataset.hpp"
+
+constexpr size_t BATCH_SIZE = 4'096;
+
+/// Plays all-AI games and exports every move to a dataset file.
+///
+/// Usage: export_dataset <output> [game count] [seat count] [first seed]
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(
+            stderr,
+            "usage: %s <output> [game count] [seat count] [first seed]\n",
+            argv[0]
+        );
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const size_t game_count = argc > 2 ? std::stoull(argv[2]) : 100'000;
+        const auto seat_count =
+            static_cast<uint8_t>(argc > 3 ? std::stoul(argv[3]) : 4);
+        const auto first_seed =
+            static_cast<unsigned int>(argc > 4 ? std::stoul(argv[4]) : 0);
+        if (seat_count < MIN_SEATS || seat_count > MAX_SEATS) {
+            std::fprintf(stderr, "seat count must be 2 to 10\n");
+            return EXIT_FAILURE;
+        }
+
+        DatasetWriter writer(argv[1]);
+        for (size_t first = 0; first < game_count; first += BATCH_SIZE) {
+            // Game `i` is seeded with `first_seed + i` and can be replayed
+            // with `State`.
+            BatchEngine batch(
+                std::min(BATCH_SIZE, game_count - first),
+                seat_count,
+                first_seed + static_cast<unsigned int>(first)
+            );
+            writer.begin_batch(batch.game_count());
+            batch.set_listener(&writer);
+            batch.run();
+        }
+        writer.finish();
+        std::printf(
+            "%zu games, %llu rows\n",
+            game_count,
+            static_cast<unsigned long long>(writer.row_count())
+        );
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
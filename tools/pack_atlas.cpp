@@ -0,0 +1,20 @@
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+
+#include "../src/atlas.hpp"
+
+/// Packs the cards, the background, the white block and the glyphs of the UI
+/// font into the atlas the game loads at startup.
+///
+/// Usage: pack_atlas
+int main() {
+    try {
+        Atlas::pack().save(Atlas::IMAGE_PATH, Atlas::INDEX_PATH);
+        std::printf("wrote %s and %s\n", Atlas::IMAGE_PATH, Atlas::INDEX_PATH);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/animator.hpp"
+#include "../src/atlas.hpp"
+#include "../src/input.hpp"
+#include "../src/replay.hpp"
+#include "../src/replay_scrubber.hpp"
+#include "../src/sprite_batch.hpp"
+
+namespace {
+/// Plays a game of AI players, as in the game, into a replay file.
+int record(
+    const char* path,
+    unsigned int seed,
+    uint8_t seat_count,
+    uint32_t keyframe_interval
+) {
+    std::vector<std::unique_ptr<Player>> players;
+    for (uint8_t seat = 0; seat < seat_count; seat += 1) {
+        players.push_back(
+            std::make_unique<LinearAiPlayer>(LinearEvaluator::get())
+        );
+    }
+    ReplayWriter writer(path, keyframe_interval);
+    State state(std::move(players), seed, writer);
+    size_t turn_count = 0;
+    do {
+        writer.begin_turn(state);
+        turn_count += 1;
+    } while (state.update() != AppState::GameOver);
+    writer.finish();
+    std::printf(
+        "seat %d won in %zu turns\n",
+        state.current_seat(),
+        turn_count
+    );
+    return EXIT_SUCCESS;
+}
+
+/// Shows the table at any turn of a replay, moved with the scrubber or the
+/// keys: Left and Right step a turn, Up and Down a keyframe, Home and End go
+/// to either end.
+int view(const char* path) {
+    const Replay replay(path);
+    ReplayCursor cursor(replay);
+    const auto turn_count = replay.turn_count();
+    const auto interval = replay.keyframe_interval();
+
+    auto window = sf::RenderWindow(sf::VideoMode({1536u, 864u}), "UNO replay");
+    window.setFramerateLimit(60);
+    const auto& atlas = Atlas::get();
+    sf::Sprite background_sprite(
+        atlas.texture(),
+        atlas.region(AtlasRegion::Background)
+    );
+
+    const Animator animator;
+    SpriteBatch batch;
+    ReplayScrubber scrubber;
+    Input input;
+    while (window.isOpen()) {
+        auto turn = cursor.turn();
+        input.begin_frame();
+        while (const auto event = window.pollEvent()) {
+            input.handle(*event);
+            if (event->is<sf::Event::Closed>()) {
+                window.close();
+            } else if (auto resized = event->getIf<sf::Event::Resized>()) {
+                window.setView(
+                    sf::View(
+                        sf::FloatRect({0.0f, 0.0f}, sf::Vector2f(resized->size))
+                    )
+                );
+            } else if (auto key = event->getIf<sf::Event::KeyPressed>()) {
+                switch (key->code) {
+                    case sf::Keyboard::Key::Left:
+                        turn = turn > 0 ? turn - 1 : 0;
+                        break;
+                    case sf::Keyboard::Key::Right:
+                        turn = std::min(turn + 1, turn_count);
+                        break;
+                    case sf::Keyboard::Key::Down:
+                        turn = turn > interval ? turn - interval : 0;
+                        break;
+                    case sf::Keyboard::Key::Up:
+                        turn = std::min(turn + interval, turn_count);
+                        break;
+                    case sf::Keyboard::Key::Home:
+                        turn = 0;
+                        break;
+                    case sf::Keyboard::Key::End:
+                        turn = turn_count;
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+        input.map(window);
+        turn = scrubber.update(input, turn_count).value_or(turn);
+        cursor.seek(turn);
+
+        const auto window_size = sf::Vector2f(window.getSize());
+        background_sprite.setScale(
+            {window_size.x / background_sprite.getLocalBounds().size.x,
+             window_size.y / background_sprite.getLocalBounds().size.y}
+        );
+        batch.clear();
+        batch.add(background_sprite);
+        cursor.state().render(batch, animator, window_size);
+        scrubber.render(batch, window_size, turn, turn_count, interval);
+        window.clear();
+        batch.draw(window);
+        window.display();
+    }
+    return EXIT_SUCCESS;
+}
+} // namespace
+
+/// Records games into replay files, and plays them back.
+///
+/// Usage:
+///   replay record <output> [seed] [seat count] [keyframe interval]
+///   replay view <replay>
+int main(int argc, char* argv[]) {
+    const std::string_view mode = argc > 1 ? argv[1] : "";
+    try {
+        if (mode == "record" && argc > 2) {
+            const auto seed =
+                static_cast<unsigned int>(argc > 3 ? std::stoul(argv[3]) : 0);
+            const auto seat_count =
+                static_cast<uint8_t>(argc > 4 ? std::stoul(argv[4]) : 4);
+            const auto keyframe_interval = static_cast<uint32_t>(
+                argc > 5 ? std::stoul(argv[5])
+                         : ReplayWriter::DEFAULT_KEYFRAME_INTERVAL
+            );
+            if (seat_count < MIN_SEATS || seat_count > MAX_SEATS) {
+                std::fprintf(stderr, "seat count must be 2 to 10\n");
+                return EXIT_FAILURE;
+            }
+            if (keyframe_interval == 0) {
+                std::fprintf(stderr, "keyframe interval must be positive\n");
+                return EXIT_FAILURE;
+            }
+            return record(argv[2], seed, seat_count, keyframe_interval);
+        } else if (mode == "view" && argc > 2) {
+            return view(argv[2]);
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    std::fprintf(
+        stderr,
+        "usage: %s record <output> [seed] [seat count] [keyframe interval]\n"
+        "       %s view <replay>\n",
+        argv[0],
+        argv[0]
+    );
+    return EXIT_FAILURE;
+}
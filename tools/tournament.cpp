@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "../src/metrics.hpp"
+#include "../src/player/linear_ai_player.hpp"
+#include "../src/player/plugin_player.hpp"
+#include "../src/seating.hpp"
+#include "../src/simulation/tournament.hpp"
+
+namespace {
+/// Returns the built-in entrant called `name`, or else the strategy of the
+/// plugin library at that path.
+Entrant make_entrant(const std::string& name) {
+    if (name == "first") {
+        return {name, [] { return std::make_unique<AiPlayer>(); }};
+    } else if (name == "linear") {
+        return {name, [] {
+                    return std::make_unique<LinearAiPlayer>(
+                        LinearEvaluator::get(),
+                        EndgameLimits {.card_threshold = 0}
+                    );
+                }};
+    } else if (name == "endgame") {
+        return {name, [] {
+                    return std::make_unique<LinearAiPlayer>(
+                        LinearEvaluator::get()
+                    );
+                }};
+    }
+    const auto plugin = Plugin::load(name);
+    return {std::string(plugin->name()), [plugin] {
+                return std::make_unique<PluginPlayer>(plugin);
+            }};
+}
+
+const char* to_string(Verdict verdict) {
+    switch (verdict) {
+        case Verdict::Running:
+            return "running";
+        case Verdict::FirstStronger:
+            return "first stronger";
+        case Verdict::SecondStronger:
+            return "second stronger";
+        case Verdict::Even:
+            return "even";
+        case Verdict::Inconclusive:
+            return "inconclusive";
+    }
+    return "";
+}
+} // namespace
+
+/// Plays the built-in AI strategies against each other and prints how they
+/// rank.
+///
+/// Usage: tournament [--seats N] [--games N] [--elo N] [--metrics PATH]
+///                   [entrant...]
+///
+/// Entrants are `first`, which plays the first playable card, `linear`,
+/// which plays the move its evaluator scores highest, and `endgame`, which
+/// also solves small endgames, or paths to plugin libraries. The three
+/// built-in strategies take part by default. With `--metrics`, the metrics
+/// of the games are written to the path, in the text format of Prometheus,
+/// once the tournament is over.
+int main(int argc, char* argv[]) {
+    try {
+        TournamentConfig config;
+        std::vector<Entrant> entrants;
+        std::string metrics_path;
+        for (int i = 1; i < argc; i += 1) {
+            const auto has_value = i + 1 < argc;
+            if (std::strcmp(argv[i], "--seats") == 0 && has_value) {
+                i += 1;
+                config.seat_count = static_cast<uint8_t>(std::stoul(argv[i]));
+            } else if (std::strcmp(argv[i], "--games") == 0 && has_value) {
+                i += 1;
+                config.max_games = std::stoull(argv[i]);
+            } else if (std::strcmp(argv[i], "--elo") == 0 && has_value) {
+                i += 1;
+                config.sprt.elo = std::stod(argv[i]);
+            } else if (std::strcmp(argv[i], "--metrics") == 0 && has_value) {
+                i += 1;
+                metrics_path = argv[i];
+            } else {
+                entrants.push_back(make_entrant(argv[i]));
+            }
+        }
+        if (config.seat_count < MIN_SEATS || config.seat_count > MAX_SEATS) {
+            std::fprintf(stderr, "seat count must be 2 to 10\n");
+            return EXIT_FAILURE;
+        }
+        if (entrants.empty()) {
+            for (const auto* name : {"first", "linear", "endgame"}) {
+                entrants.push_back(make_entrant(name));
+            }
+        }
+        if (entrants.size() < 2) {
+            std::fprintf(stderr, "a tournament needs two entrants\n");
+            return EXIT_FAILURE;
+        }
+
+        Tournament tournament(std::move(entrants), config);
+        tournament.run([&](const Pairing& pairing) {
+            const auto elo =
+                estimate_elo(pairing.first_wins, pairing.second_wins);
+            std::printf(
+                "%s vs %s: %s after %zu games, %+.1f Elo [%+.1f, %+.1f]\n",
+                tournament.entrants()[pairing.first].name.c_str(),
+                tournament.entrants()[pairing.second].name.c_str(),
+                to_string(pairing.verdict),
+                pairing.game_count(),
+                elo.elo,
+                elo.lower,
+                elo.upper
+            );
+        });
+
+        const auto ratings = tournament.ratings();
+        for (size_t i = 0; i < ratings.size(); i += 1) {
+            std::printf(
+                "%-10s %+7.1f\n",
+                tournament.entrants()[i].name.c_str(),
+                ratings[i]
+            );
+        }
+        if (!metrics_path.empty()) {
+            Metrics::get().dump(metrics_path);
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
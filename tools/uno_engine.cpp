@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/player/linear_evaluator.hpp"
+#include "../src/seating.hpp"
+#include "../src/simulation/batch_engine.hpp"
+#include "../src/simulation/bot_process.hpp"
+#include "../src/simulation/protocol.hpp"
+
+constexpr size_t BATCH_SIZE = 4'096;
+
+namespace {
+/// Seats an external bot at the even seats and the linear evaluator at the
+/// odd seats, asking the bot about all of its games at once.
+class MatchPolicy: public BatchPolicy {
+  public:
+    MatchPolicy(BotProcess& bot, const LinearEvaluator& evaluator) :
+        bot_(bot),
+        evaluator_(evaluator) {}
+
+    void choose(
+        std::span<const Observation> observations,
+        std::span<Action> actions
+    ) override {
+        bot_observations_.clear();
+        bot_indices_.clear();
+        for (size_t i = 0; i < observations.size(); i += 1) {
+            if (observations[i].seat % 2 == 0) {
+                bot_observations_.push_back(observations[i]);
+                bot_indices_.push_back(i);
+            } else {
+                actions[i] = evaluator_.choose(observations[i]);
+            }
+        }
+        bot_actions_.resize(bot_observations_.size());
+        bot_.choose(bot_observations_, bot_actions_);
+        for (size_t i = 0; i < bot_indices_.size(); i += 1) {
+            actions[bot_indices_[i]] = bot_actions_[i];
+        }
+    }
+
+  private:
+    BotProcess& bot_;
+    const LinearEvaluator& evaluator_;
+    std::vector<Observation> bot_observations_;
+    std::vector<size_t> bot_indices_;
+    std::vector<Action> bot_actions_;
+};
+
+int match(size_t game_count, uint8_t seat_count, BotProcess& bot) {
+    MatchPolicy policy(bot, LinearEvaluator::get());
+    size_t bot_wins = 0;
+    for (size_t first = 0; first < game_count; first += BATCH_SIZE) {
+        BatchEngine batch(
+            std::min(BATCH_SIZE, game_count - first),
+            seat_count,
+            static_cast<unsigned int>(first)
+        );
+        batch.set_policy(&policy);
+        batch.run();
+        for (size_t game = 0; game < batch.game_count(); game += 1) {
+            bot_wins += batch.winner(game) % 2 == 0 ? 1 : 0;
+        }
+    }
+    const auto bot_seats = (seat_count + 1) / 2;
+    std::printf(
+        "%.*s won %zu of %zu games (%.1f%%) holding %.1f%% of the seats\n",
+        static_cast<int>(bot.name().size()),
+        bot.name().data(),
+        bot_wins,
+        game_count,
+        100.0 * bot_wins / game_count,
+        100.0 * bot_seats / seat_count
+    );
+    return EXIT_SUCCESS;
+}
+} // namespace
+
+/// Speaks the bot protocol of `protocol.hpp`, on either end.
+///
+/// Usage:
+///   uno_engine serve
+///   uno_engine match <game count> <seat count> <bot command...>
+///
+/// `serve` answers positions on the standard input with the moves of the
+/// linear evaluator. `match` starts the bot command and plays it at the even
+/// seats against the linear evaluator, so `uno_engine match 1000 4
+/// uno_engine serve` plays the engine against itself through a pipe.
+int main(int argc, char* argv[]) {
+    const std::string_view mode = argc > 1 ? argv[1] : "";
+    try {
+        if (mode == "serve") {
+            const auto& evaluator = LinearEvaluator::get();
+            serve_protocol("linear", [&](const Observation& observation) {
+                return evaluator.choose(observation);
+            });
+            return EXIT_SUCCESS;
+        } else if (mode == "match" && argc > 4) {
+            const size_t game_count = std::stoull(argv[2]);
+            const auto seat_count = static_cast<uint8_t>(std::stoul(argv[3]));
+            if (seat_count < MIN_SEATS || seat_count > MAX_SEATS) {
+                std::fprintf(stderr, "seat count must be 2 to 10\n");
+                return EXIT_FAILURE;
+            }
+            BotProcess bot(std::vector<std::string>(argv + 4, argv + argc));
+            return match(game_count, seat_count, bot);
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    std::fprintf(
+        stderr,
+        "usage: %s serve\n"
+        "       %s match <game count> <seat count> <bot command...>\n",
+        argv[0],
+        argv[0]
+    );
+    return EXIT_FAILURE;
+}
@@ -1,7 +1,19 @@
-set_languages("c++20")
+set_languages("c11", "c++20")
+
+option("memory_stats")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Count allocations and live bytes by subsystem")
+    add_defines("UNO_MEMORY_STATS")
+option_end()
 
 add_requires("sfml 3.0.0", "doctest 2.4.11")
 add_packages("sfml", "doctest")
+add_options("memory_stats")
+
+if is_plat("linux") then
+    add_syslinks("dl")
+end
 
 target("uno")
     set_kind("binary")
@@ -12,8 +24,45 @@ target("test")
     set_kind("binary")
     set_warnings("all", "error")
     add_files("src/**.cpp")
+    -- Tests check what allocates, whether or not the game counts it.
+    add_defines("UNO_MEMORY_STATS")
+    -- tests/plugin.cpp loads the plugin of plugins/save_wilds.c.
+    add_deps("save_wilds")
+    on_config(function (target)
+        local plugin = path.absolute(target:dep("save_wilds"):targetfile())
+        target:add("defines",
+            "UNO_SAVE_WILDS_PLUGIN=\"" .. path.unix(plugin) .. "\"")
+    end)
     for _, testfile in ipairs(os.files("tests/*.cpp")) do
         add_tests(path.basename(testfile), {
             files = testfile,
             remove_files = "src/main.cpp"})
     end
+
+for _, benchfile in ipairs(os.files("benches/*.cpp")) do
+    target("bench_" .. path.basename(benchfile))
+        set_kind("binary")
+        set_default(false)
+        set_warnings("all", "error")
+        set_optimize("fastest")
+        add_files("src/**.cpp", benchfile)
+        remove_files("src/main.cpp")
+end
+
+for _, toolfile in ipairs(os.files("tools/*.cpp")) do
+    target(path.basename(toolfile))
+        set_kind("binary")
+        set_warnings("all", "error")
+        set_optimize("fastest")
+        add_files("src/**.cpp", toolfile)
+        remove_files("src/main.cpp")
+end
+
+for _, pluginfile in ipairs(os.files("plugins/*.c")) do
+    target(path.basename(pluginfile))
+        set_kind("shared")
+        set_warnings("all", "error")
+        set_optimize("fastest")
+        set_symbols("hidden")
+        add_files(pluginfile)
+end